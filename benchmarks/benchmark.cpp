@@ -0,0 +1,230 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file benchmark.cpp
+//  \brief the benchmark harness, its driver, and the package the benchmarks run on
+
+// C++ headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+// Parthenon headers
+#include "athena.hpp"
+#include "globals.hpp"
+#include "interface/StateDescriptor.hpp"
+#include "parthenon_manager.hpp"
+
+// Application headers
+#include "benchmark.hpp"
+
+#ifndef PARTHENON_GIT_COMMIT
+#define PARTHENON_GIT_COMMIT "unknown"
+#endif
+#ifndef PARTHENON_BUILD_TYPE
+#define PARTHENON_BUILD_TYPE "unknown"
+#endif
+
+namespace parthenon {
+
+Packages_t ParthenonManager::ProcessPackages(std::unique_ptr<ParameterInput> &pin) {
+  Packages_t packages;
+  auto package = std::make_shared<StateDescriptor>("Benchmark");
+  // one multi-component variable with ghost exchange, refinement and fluxes
+  std::vector<int> array_size({pin->GetOrAddInteger("benchmark", "nvar", 5)});
+  Metadata m({Metadata::Cell, Metadata::Independent, Metadata::FillGhost}, array_size);
+  package->AddField("bench_q", m);
+  packages["Benchmark"] = package;
+  return packages;
+}
+
+void MeshBlock::ProblemGenerator(ParameterInput *pin) {
+  // smooth data, so that the refinement limiters take their usual branches
+  auto &q = real_container.Get("bench_q");
+  for (int n = 0; n < q.GetDim4(); ++n) {
+    for (int k = ks; k <= ke; ++k) {
+      for (int j = js; j <= je; ++j) {
+        for (int i = is; i <= ie; ++i) {
+          q(n, k, j, i) = 1.0 + 0.5*std::sin(pcoord->x1v(i) + n)
+                          * std::cos(pcoord->x2v(j)) * std::cos(pcoord->x3v(k));
+        }
+      }
+    }
+  }
+}
+
+} // namespace parthenon
+
+namespace Benchmark {
+
+Suite::Suite(ParameterInput *pin)
+    : nvar(pin->GetOrAddInteger("benchmark", "nvar", 5)),
+      ntasks(pin->GetOrAddInteger("benchmark", "ntasks", 1000)),
+      warmup_(pin->GetOrAddInteger("benchmark", "warmup", 2)),
+      repetitions_(pin->GetOrAddInteger("benchmark", "repetitions", 20)),
+      output_(pin->GetOrAddString("benchmark", "output", "benchmarks.json")),
+      label_(pin->GetOrAddString("benchmark", "label", "")) {
+  if (repetitions_ < 1 || warmup_ < 0 || ntasks < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in Benchmark::Suite" << std::endl
+        << "repetitions and ntasks must be >= 1 and warmup >= 0, but repetitions="
+        << repetitions_ << " ntasks=" << ntasks << " warmup=" << warmup_ << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  std::stringstream filter(pin->GetOrAddString("benchmark", "filter", ""));
+  std::string pattern;
+  while (std::getline(filter, pattern, ',')) {
+    if (!pattern.empty()) filter_.push_back(pattern);
+  }
+}
+
+bool Suite::Selected(const std::string &name) const {
+  if (filter_.empty()) return true;
+  for (const auto &pattern : filter_) {
+    if (name.find(pattern) != std::string::npos) return true;
+  }
+  return false;
+}
+
+void Suite::Barrier() {
+#ifdef MPI_PARALLEL
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+double Suite::Now() {
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double Suite::MaxOverRanks(const double seconds) {
+#ifdef MPI_PARALLEL
+  double max_seconds;
+  MPI_Allreduce(&seconds, &max_seconds, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  return max_seconds;
+#else
+  return seconds;
+#endif
+}
+
+namespace {
+struct Summary {
+  double min, median, mean, max, stddev;
+};
+
+Summary Summarize(std::vector<double> s) {
+  std::sort(s.begin(), s.end());
+  const std::size_t n = s.size();
+  Summary sum;
+  sum.min = s.front();
+  sum.max = s.back();
+  sum.median = (n % 2 == 1) ? s[n/2] : 0.5*(s[n/2 - 1] + s[n/2]);
+  sum.mean = std::accumulate(s.begin(), s.end(), 0.0)/n;
+  double var = 0.0;
+  for (const double x : s) var += (x - sum.mean)*(x - sum.mean);
+  sum.stddev = (n > 1) ? std::sqrt(var/(n - 1)) : 0.0;
+  return sum;
+}
+} // namespace
+
+void Suite::Print(const Result &result) const {
+  if (parthenon::Globals::my_rank != 0) return;
+  const Summary s = Summarize(result.seconds);
+  std::cout << std::left << std::setw(40) << result.name << std::right
+            << std::scientific << std::setprecision(3)
+            << "  median " << s.median << " s  min " << s.min << " s  "
+            << result.items/s.median << " " << result.unit << "/s" << std::endl;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Suite::Write(const Mesh *pmesh) const
+//  \brief rank 0 writes <benchmark>/output; times are in seconds and are the maximum
+//  over ranks of each repetition, items_per_second uses the median
+
+void Suite::Write(const Mesh *pmesh) const {
+  if (parthenon::Globals::my_rank != 0) return;
+  std::ofstream os(output_);
+  if (!os) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in Benchmark::Suite::Write" << std::endl
+        << "Could not open file '" << output_ << "' for the benchmark results."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  char date[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  const parthenon::RegionSize &bs = pmesh->pblock->block_size;
+
+  os << std::setprecision(9);
+  os << "{" << std::endl << "  \"context\": {" << std::endl
+     << "    \"date\": \"" << date << "\"," << std::endl
+     << "    \"label\": \"" << label_ << "\"," << std::endl
+     << "    \"git_commit\": \"" << PARTHENON_GIT_COMMIT << "\"," << std::endl
+     << "    \"build_type\": \"" << PARTHENON_BUILD_TYPE << "\"," << std::endl
+     << "    \"compiler\": \"" << __VERSION__ << "\"," << std::endl
+     << "    \"nranks\": " << parthenon::Globals::nranks << "," << std::endl
+     << "    \"num_threads\": " << pmesh->GetNumMeshThreads() << "," << std::endl
+     << "    \"nghost\": " << NGHOST << "," << std::endl
+     << "    \"real_bytes\": " << sizeof(parthenon::Real) << "," << std::endl
+     << "    \"meshblock\": [" << bs.nx1 << ", " << bs.nx2 << ", " << bs.nx3 << "],"
+     << std::endl
+     << "    \"nblocks\": " << pmesh->nbtotal << "," << std::endl
+     << "    \"nvar\": " << nvar << "," << std::endl
+     << "    \"warmup\": " << warmup_ << "," << std::endl
+     << "    \"repetitions\": " << repetitions_ << std::endl
+     << "  }," << std::endl << "  \"benchmarks\": [";
+  for (std::size_t b = 0; b < results_.size(); ++b) {
+    const Result &r = results_[b];
+    const Summary s = Summarize(r.seconds);
+    os << (b == 0 ? "" : ",") << std::endl << "    {"
+       << "\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit << "\", "
+       << "\"items\": " << r.items << ", "
+       << "\"min\": " << s.min << ", \"median\": " << s.median << ", "
+       << "\"mean\": " << s.mean << ", \"max\": " << s.max << ", "
+       << "\"stddev\": " << s.stddev << ", "
+       << "\"items_per_second\": " << r.items/s.median << ", \"seconds\": [";
+    for (std::size_t n = 0; n < r.seconds.size(); ++n) {
+      os << (n == 0 ? "" : ", ") << r.seconds[n];
+    }
+    os << "]}";
+  }
+  os << std::endl << "  ]" << std::endl << "}" << std::endl;
+  std::cout << std::endl << "Benchmark results written to " << output_ << std::endl;
+}
+
+DriverStatus BenchmarkDriver::Execute() {
+  Suite suite(pinput);
+  ParForPatterns(&suite, pmesh);
+  BufferPacking(&suite, pmesh);
+  Refinement(&suite, pmesh);
+  FluxDivergence(&suite, pmesh);
+  TaskListOverhead(&suite, pmesh);
+  GhostExchange(&suite, pmesh);
+  suite.Write(pmesh);
+  pmesh->mbcnt = 0;  // no zone-cycles were taken
+  return DriverStatus::complete;
+}
+} // namespace Benchmark
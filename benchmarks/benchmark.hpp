@@ -0,0 +1,120 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef BENCHMARKS_BENCHMARK_HPP_
+#define BENCHMARKS_BENCHMARK_HPP_
+//! \file benchmark.hpp
+//  \brief a minimal harness for reproducible benchmarks with JSON output
+//
+//  Every benchmark is run <benchmark>/warmup times untimed and then timed for
+//  <benchmark>/repetitions calls.  Ranks are synchronized before each timed call and
+//  the slowest rank's time is kept, so collective benchmarks report what the job sees.
+
+// C++ headers
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Kokkos headers
+#include <Kokkos_Core.hpp>
+
+// Parthenon headers
+#include "driver/driver.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs/outputs.hpp"
+#include "parameter_input.hpp"
+
+namespace Benchmark {
+using parthenon::Driver;
+using parthenon::DriverStatus;
+using parthenon::Mesh;
+using parthenon::Outputs;
+using parthenon::ParameterInput;
+
+//! \struct Result
+//  \brief the timings of one benchmark; "items" of "unit" are processed per call
+
+struct Result {
+  std::string name;
+  std::string unit;
+  std::int64_t items;
+  std::vector<double> seconds;
+};
+
+//----------------------------------------------------------------------------------------
+//! \class Suite
+//  \brief runs the selected benchmarks and collects their results
+
+class Suite {
+ public:
+  explicit Suite(ParameterInput *pin);
+
+  // true if "name" contains one of the comma-separated <benchmark>/filter patterns
+  bool Selected(const std::string &name) const;
+
+  // collective: times "body" and records the result under "name"
+  template <typename F>
+  void Run(const std::string &name, const std::string &unit, const std::int64_t items,
+           F &&body) {
+    if (!Selected(name)) return;
+    for (int n = 0; n < warmup_; ++n) body();
+    Kokkos::fence();
+    Result result{name, unit, items, {}};
+    for (int n = 0; n < repetitions_; ++n) {
+      Barrier();
+      const double start = Now();
+      body();
+      Kokkos::fence();
+      result.seconds.push_back(MaxOverRanks(Now() - start));
+    }
+    Print(result);
+    results_.push_back(std::move(result));
+  }
+
+  // rank 0 writes all results and the build/run context as JSON
+  void Write(const Mesh *pmesh) const;
+
+  const int nvar, ntasks;
+
+ private:
+  static void Barrier();
+  static double Now();
+  static double MaxOverRanks(const double seconds);
+  void Print(const Result &result) const;
+
+  std::vector<std::string> filter_;
+  int warmup_, repetitions_;
+  std::string output_, label_;
+  std::vector<Result> results_;
+};
+
+// the individual benchmarks, see kernels.cpp
+void ParForPatterns(Suite *suite, Mesh *pmesh);
+void BufferPacking(Suite *suite, Mesh *pmesh);
+void Refinement(Suite *suite, Mesh *pmesh);
+void FluxDivergence(Suite *suite, Mesh *pmesh);
+void TaskListOverhead(Suite *suite, Mesh *pmesh);
+void GhostExchange(Suite *suite, Mesh *pmesh);
+
+//----------------------------------------------------------------------------------------
+//! \class BenchmarkDriver
+//  \brief runs every selected benchmark once, in place of time evolution
+
+class BenchmarkDriver : public Driver {
+ public:
+  BenchmarkDriver(ParameterInput *pin, Mesh *pm, Outputs *pout) : Driver(pin, pm, pout) {}
+  DriverStatus Execute();
+};
+} // namespace Benchmark
+
+#endif // BENCHMARKS_BENCHMARK_HPP_
@@ -0,0 +1,238 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file kernels.cpp
+//  \brief the benchmarks: micro-benchmarks on the first block of the rank and a ghost
+//  exchange over all blocks of the mesh
+
+// C++ headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include "athena.hpp"
+#include "athena_arrays.hpp"
+#include "interface/Container.hpp"
+#include "interface/Update.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+#include "mesh/mesh_refinement.hpp"
+#include "task_list/tasks.hpp"
+#include "utils/buffer_utils.hpp"
+
+// Application headers
+#include "benchmark.hpp"
+
+namespace Benchmark {
+using parthenon::AthenaArray;
+using parthenon::BoundaryCommSubset;
+using parthenon::Container;
+using parthenon::DevSpace;
+using parthenon::MeshBlock;
+using parthenon::ParArray3D;
+using parthenon::ParArray4D;
+using parthenon::Real;
+using parthenon::SimpleTask;
+using parthenon::TaskID;
+using parthenon::TaskList;
+using parthenon::TaskListStatus;
+using parthenon::TaskStatus;
+using parthenon::Variable;
+
+namespace {
+std::int64_t InteriorCells(const MeshBlock *pmb) {
+  return static_cast<std::int64_t>(pmb->block_size.nx1)*pmb->block_size.nx2
+         *pmb->block_size.nx3;
+}
+
+//! \fn void ParFor(...)
+//  \brief a three point stencil over the interior of a block, in 3D and with a
+//  leading variable index in 4D, using the loop pattern selected by "tag"
+
+template <typename Tag>
+void ParFor(Suite *suite, MeshBlock *pmb, Tag tag, const std::string &pattern) {
+  const int is = pmb->is, ie = pmb->ie, js = pmb->js, je = pmb->je;
+  const int ks = pmb->ks, ke = pmb->ke, nv = suite->nvar;
+  ParArray3D<Real> a3("a3", pmb->ncells3, pmb->ncells2, pmb->ncells1);
+  ParArray3D<Real> b3("b3", pmb->ncells3, pmb->ncells2, pmb->ncells1);
+  ParArray4D<Real> a4("a4", nv, pmb->ncells3, pmb->ncells2, pmb->ncells1);
+  ParArray4D<Real> b4("b4", nv, pmb->ncells3, pmb->ncells2, pmb->ncells1);
+  Kokkos::deep_copy(a3, 1.0);
+  Kokkos::deep_copy(a4, 1.0);
+
+  suite->Run("par_for/3D/" + pattern, "cells", InteriorCells(pmb), [&]() {
+    parthenon::par_for(tag, "Benchmark3D", DevSpace(), ks, ke, js, je, is, ie,
+        KOKKOS_LAMBDA(const int k, const int j, const int i) {
+          b3(k, j, i) = 0.5*a3(k, j, i) + 0.25*(a3(k, j, i - 1) + a3(k, j, i + 1));
+        });
+  });
+  suite->Run("par_for/4D/" + pattern, "cells", nv*InteriorCells(pmb), [&]() {
+    parthenon::par_for(tag, "Benchmark4D", DevSpace(), 0, nv - 1, ks, ke, js, je, is, ie,
+        KOKKOS_LAMBDA(const int n, const int k, const int j, const int i) {
+          b4(n, k, j, i) =
+              0.5*a4(n, k, j, i) + 0.25*(a4(n, k, j, i - 1) + a4(n, k, j, i + 1));
+        });
+  });
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void ParForPatterns(Suite *suite, Mesh *pmesh)
+//  \brief every loop pattern of kokkos_abstraction.hpp on the same stencil
+
+void ParForPatterns(Suite *suite, Mesh *pmesh) {
+  MeshBlock *pmb = pmesh->pblock;
+  ParFor(suite, pmb, parthenon::loop_pattern_flatrange_tag, "flatrange");
+  ParFor(suite, pmb, parthenon::loop_pattern_simdfor_tag, "simdfor");
+  ParFor(suite, pmb, parthenon::loop_pattern_mdrange_tag, "mdrange");
+  ParFor(suite, pmb, parthenon::loop_pattern_tpttr_tag, "tpttr");
+  ParFor(suite, pmb, parthenon::loop_pattern_tptvr_tag, "tptvr");
+  ParFor(suite, pmb, parthenon::loop_pattern_tpttrtvr_tag, "tpttrtvr");
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BufferPacking(Suite *suite, Mesh *pmesh)
+//  \brief PackData/UnpackData of the ghost layers at an x1 face (strided) and at an x3
+//  face (contiguous) for all components of the benchmark variable
+
+void BufferPacking(Suite *suite, Mesh *pmesh) {
+  MeshBlock *pmb = pmesh->pblock;
+  Variable<Real> &q = pmb->real_container.Get("bench_q");
+  const int nu = q.GetDim4() - 1;
+  struct Face {
+    std::string name;
+    int si, ei, sj, ej, sk, ek;
+  };
+  std::vector<Face> faces = {
+      {"x1", pmb->is, pmb->is + NGHOST - 1, pmb->js, pmb->je, pmb->ks, pmb->ke}};
+  if (pmesh->ndim >= 3) {
+    faces.push_back({"x3", pmb->is, pmb->ie, pmb->js, pmb->je, pmb->ks,
+                     pmb->ks + NGHOST - 1});
+  }
+  for (const auto &f : faces) {
+    const std::int64_t size = static_cast<std::int64_t>(nu + 1)*(f.ei - f.si + 1)
+                              *(f.ej - f.sj + 1)*(f.ek - f.sk + 1);
+    std::vector<Real> buf(size);
+    const std::int64_t bytes = size*sizeof(Real);
+    suite->Run("PackData/" + f.name + "_face", "bytes", bytes, [&]() {
+      int offset = 0;
+      parthenon::BufferUtility::PackData(q, buf.data(), 0, nu, f.si, f.ei, f.sj, f.ej,
+                                         f.sk, f.ek, offset);
+    });
+    suite->Run("UnpackData/" + f.name + "_face", "bytes", bytes, [&]() {
+      int offset = 0;
+      parthenon::BufferUtility::UnpackData(buf.data(), q, 0, nu, f.si, f.ei, f.sj, f.ej,
+                                           f.sk, f.ek, offset);
+    });
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Refinement(Suite *suite, Mesh *pmesh)
+//  \brief restriction of a whole block and prolongation back onto it; needs a
+//  multilevel mesh, e.g. <mesh>/refinement = static
+
+void Refinement(Suite *suite, Mesh *pmesh) {
+  MeshBlock *pmb = pmesh->pblock;
+  if (pmb->pmr == nullptr) return;
+  Variable<Real> &q = pmb->real_container.Get("bench_q");
+  const int nu = q.GetDim4() - 1;
+  AthenaArray<Real> coarse(nu + 1, pmb->ncc3, pmb->ncc2, pmb->ncc1);
+  const std::int64_t fine_cells = (nu + 1)*InteriorCells(pmb);
+
+  suite->Run("RestrictCellCenteredValues", "cells", fine_cells, [&]() {
+    pmb->pmr->RestrictCellCenteredValues(q, coarse, 0, nu, pmb->cis, pmb->cie,
+                                         pmb->cjs, pmb->cje, pmb->cks, pmb->cke);
+  });
+  // prolongation reads one layer of coarse neighbors, so fill the coarse ghosts too
+  for (int n = 0; n <= nu; ++n) {
+    for (int k = 0; k < pmb->ncc3; ++k) {
+      for (int j = 0; j < pmb->ncc2; ++j) {
+        for (int i = 0; i < pmb->ncc1; ++i) coarse(n, k, j, i) = 1.0 + 0.01*(i + j + k);
+      }
+    }
+  }
+  suite->Run("ProlongateCellCenteredValues", "cells", fine_cells, [&]() {
+    pmb->pmr->ProlongateCellCenteredValues(coarse, q, 0, nu, pmb->cis, pmb->cie,
+                                           pmb->cjs, pmb->cje, pmb->cks, pmb->cke);
+  });
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FluxDivergence(Suite *suite, Mesh *pmesh)
+//  \brief Update::FluxDivergence of the benchmark variable on one block
+
+void FluxDivergence(Suite *suite, Mesh *pmesh) {
+  MeshBlock *pmb = pmesh->pblock;
+  Container<Real> &base = pmb->real_container;
+  Variable<Real> &q = base.Get("bench_q");
+  for (int d = 0; d < pmesh->ndim; ++d) {
+    AthenaArray<Real> &flux = q.flux[d];
+    for (int n = 0; n < flux.GetSize(); ++n) flux.data()[n] = 1.0e-3*(n % 97);
+  }
+  base.StageAdd("dudt", "base");
+  Container<Real> dudt("dudt", base);
+  suite->Run("FluxDivergence", "cells", q.GetDim4()*InteriorCells(pmb), [&]() {
+    parthenon::Update::FluxDivergence(base, dudt);
+  });
+  base.StageDelete("dudt");
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TaskListOverhead(Suite *suite, Mesh *pmesh)
+//  \brief building and executing <benchmark>/ntasks empty tasks, either as one chain of
+//  dependencies or all independent, so the items per second are tasks per second
+
+void TaskListOverhead(Suite *suite, Mesh *pmesh) {
+  auto empty = []() { return TaskStatus::success; };
+  const int ntasks = suite->ntasks;
+  suite->Run("TaskList/independent", "tasks", ntasks, [&]() {
+    TaskList tl;
+    TaskID none(0);
+    for (int n = 0; n < ntasks; ++n) tl.AddTask<SimpleTask>(empty, none);
+    while (tl.DoAvailable() != TaskListStatus::complete) {}
+  });
+  suite->Run("TaskList/chain", "tasks", ntasks, [&]() {
+    TaskList tl;
+    TaskID dep(0);
+    for (int n = 0; n < ntasks; ++n) dep = tl.AddTask<SimpleTask>(empty, dep);
+    while (tl.DoAvailable() != TaskListStatus::complete) {}
+  });
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GhostExchange(Suite *suite, Mesh *pmesh)
+//  \brief a full ghost exchange of the benchmark variable between all blocks, following
+//  the sequence used at initialization; collective over ranks
+
+void GhostExchange(Suite *suite, Mesh *pmesh) {
+  std::int64_t ghost_cells = 0;
+  for (MeshBlock *pmb = pmesh->pblock; pmb != nullptr; pmb = pmb->next) {
+    const std::int64_t all = static_cast<std::int64_t>(pmb->ncells1)*pmb->ncells2
+                             *pmb->ncells3;
+    ghost_cells += suite->nvar*(all - InteriorCells(pmb));
+  }
+  suite->Run("GhostExchange", "cells", ghost_cells, [&]() {
+    for (MeshBlock *pmb = pmesh->pblock; pmb != nullptr; pmb = pmb->next) {
+      pmb->real_container.StartReceiving(BoundaryCommSubset::mesh_init);
+    }
+    for (MeshBlock *pmb = pmesh->pblock; pmb != nullptr; pmb = pmb->next) {
+      pmb->real_container.SendBoundaryBuffers();
+    }
+    for (MeshBlock *pmb = pmesh->pblock; pmb != nullptr; pmb = pmb->next) {
+      pmb->real_container.ReceiveAndSetBoundariesWithWait();
+      pmb->real_container.ClearBoundary(BoundaryCommSubset::mesh_init);
+    }
+  });
+}
+} // namespace Benchmark
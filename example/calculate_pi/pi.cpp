@@ -92,12 +92,13 @@ TaskList CalculatePi::MakeTaskList(MeshBlock *pmb) {
   TaskList tl;
 
   // make some lambdas that over overkill here but clean things up for more realistic code
-  auto AddBlockTask = [pmb,&tl](BlockTaskFunc func, TaskID dependencies) {
-    return tl.AddTask<BlockTask>(func, dependencies, pmb);
+  auto AddBlockTask = [pmb,&tl](const std::string &name, BlockTaskFunc func,
+                                TaskID dependencies) {
+    return tl.AddNamedTask<BlockTask>(name, func, dependencies, pmb);
   };
 
   TaskID none(0);
-  auto get_area = AddBlockTask(ComputeArea, none);
+  auto get_area = AddBlockTask("ComputeArea", ComputeArea, none);
 
   // could add more tasks like:
   // auto next_task = tl.AddTask(FuncPtr, get_area, pmb);
@@ -197,6 +198,8 @@ namespace PiCalculator {
     std::string field_name("in_or_out");
     Metadata m({Metadata::Cell, Metadata::Derived, Metadata::Graphics});
     package->AddField(field_name, m, DerivedOwnership::unique);
+    // the volume integral of the indicator function is the area of the circle
+    package->AddHistory("area", field_name);
 
     // All the package FillDerived and CheckRefinement functions are called by parthenon
     package->FillDerived = SetInOrOut;
@@ -0,0 +1,55 @@
+#=========================================================================================
+# (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+#
+# This program was produced under U.S. Government contract 89233218CNA000001 for Los
+# Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+# for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+# in the program are reserved by Triad National Security, LLC, and the U.S. Department
+# of Energy/National Nuclear Security Administration. The Government is granted for
+# itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+# license in this material to reproduce, prepare derivative works, distribute copies to
+# the public, perform publicly and display publicly, and to permit others to do so.
+#=========================================================================================
+
+# Merges the per-rank task traces written with <profiling>/trace = true into a single
+# Chrome trace that chrome://tracing or https://ui.perfetto.dev can open.
+#
+#   python merge_traces.py -o merged.json problem.trace.*.json
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge per-rank Parthenon task traces")
+    parser.add_argument("files", nargs="+", help="per-rank <trace_file>.<rank>.json")
+    parser.add_argument("-o", "--output", default="merged_trace.json",
+                        help="merged trace (default: merged_trace.json)")
+    args = parser.parse_args()
+
+    events = []
+    ranks = []
+    for fname in args.files:
+        with open(fname) as f:
+            trace = json.load(f)
+        events.extend(trace["traceEvents"])
+        info = trace.get("otherData", {})
+        ranks.append(info.get("rank"))
+        lost = info.get("overwritten", 0) + info.get("dropped", 0)
+        if lost > 0:
+            print("warning: %s lost %d events" % (fname, lost), file=sys.stderr)
+
+    missing = set(range(max(ranks) + 1)) - set(ranks) if None not in ranks else set()
+    if missing:
+        print("warning: no trace for ranks %s" % sorted(missing), file=sys.stderr)
+
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+    print("wrote %d events from %d ranks to %s" % (len(events), len(ranks), args.output))
+
+
+if __name__ == "__main__":
+    main()
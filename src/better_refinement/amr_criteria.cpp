@@ -22,19 +22,21 @@ namespace parthenon {
 
 std::shared_ptr<AMRCriteria> AMRCriteria::MakeAMRCriteria(std::string& criteria, ParameterInput *pin, std::string& block_name) {
   if (criteria == "derivative_order_1") return std::make_shared<AMRFirstDerivative>(pin, block_name);
+  if (criteria == "derivative_order_2") return std::make_shared<AMRSecondDerivative>(pin, block_name);
   throw std::invalid_argument(
         "\n  Invalid selection for refinment method in " + block_name + ": " + criteria
   );
 }
 
-AMRFirstDerivative::AMRFirstDerivative(ParameterInput *pin, std::string& block_name) {
+void AMRCriteria::ReadCommonParameters(ParameterInput *pin, std::string& block_name,
+                                       const Real refine_tol, const Real derefine_tol) {
     field = pin->GetOrAddString(block_name, "field", "NO FIELD WAS SET");
     if (field == "NO FIELD WAS SET") {
       std::cerr << "Error in " << block_name << ": no field set" << std::endl;
       exit(1);
     }
-    refine_criteria = pin->GetOrAddReal(block_name, "refine_tol", 0.5);
-    derefine_criteria = pin->GetOrAddReal(block_name, "derefine_tol", 0.05);
+    refine_criteria = pin->GetOrAddReal(block_name, "refine_tol", refine_tol);
+    derefine_criteria = pin->GetOrAddReal(block_name, "derefine_tol", derefine_tol);
     int global_max_level = pin->GetOrAddInteger("mesh", "numlevel", 1);
     max_level = pin->GetOrAddInteger(block_name, "max_level", global_max_level);
     if (max_level > global_max_level) {
@@ -47,9 +49,31 @@ AMRFirstDerivative::AMRFirstDerivative(ParameterInput *pin, std::string& block_n
     }
 }
 
+int AMRCriteria::Tag(const Real indicator) const {
+  if (indicator > refine_criteria) return 1;
+  if (indicator < derefine_criteria) return -1;
+  return 0;
+}
+
+AMRFirstDerivative::AMRFirstDerivative(ParameterInput *pin, std::string& block_name) {
+  ReadCommonParameters(pin, block_name, 0.5, 0.05);
+}
+
 int AMRFirstDerivative::operator()(Container<Real>& rc) {
   Variable<Real>& q = rc.Get(field);
   return BetterRefinement::FirstDerivative(q, refine_criteria, derefine_criteria);
 }
 
+AMRSecondDerivative::AMRSecondDerivative(ParameterInput *pin, std::string& block_name) {
+  // the Lohner estimator is normalized to [0,1], hence the different default tolerances
+  ReadCommonParameters(pin, block_name, 0.8, 0.2);
+  filter = pin->GetOrAddReal(block_name, "filter", 0.01);
+}
+
+int AMRSecondDerivative::operator()(Container<Real>& rc) {
+  Variable<Real>& q = rc.Get(field);
+  return BetterRefinement::SecondDerivative(q, refine_criteria, derefine_criteria,
+                                            filter);
+}
+
 } // namespace parthenon
@@ -23,19 +23,44 @@ namespace parthenon {
 
 class ParameterInput;
 
+// Indicators that BetterRefinement::CheckAllRefinement evaluates in a single fused
+// reduction for all criteria that read the same field.
+enum class RefinementIndicator {none, first_derivative, second_derivative};
+
 struct AMRCriteria {
   AMRCriteria() = default;
   virtual ~AMRCriteria() {}
   virtual int operator () (Container<Real>& rc) = 0;
+  // criteria that just threshold one of the indicators above return it here
+  virtual RefinementIndicator Indicator() const { return RefinementIndicator::none; }
+  // map an indicator value onto the recommended change in refinement level
+  int Tag(const Real indicator) const;
   std::string field;
   Real refine_criteria, derefine_criteria;
   int max_level;
+  // noise filter of the second derivative indicator (unused by the others)
+  Real filter = 0.0;
   static std::shared_ptr<AMRCriteria> MakeAMRCriteria(std::string& criteria, ParameterInput *pin, std::string& block_name);
+
+ protected:
+  void ReadCommonParameters(ParameterInput *pin, std::string& block_name,
+                            const Real refine_tol, const Real derefine_tol);
 };
 
 struct AMRFirstDerivative : public AMRCriteria {
   AMRFirstDerivative(ParameterInput *pin, std::string& block_name);
   int operator () (Container<Real>& rc);
+  RefinementIndicator Indicator() const {
+    return RefinementIndicator::first_derivative;
+  }
+};
+
+struct AMRSecondDerivative : public AMRCriteria {
+  AMRSecondDerivative(ParameterInput *pin, std::string& block_name);
+  int operator () (Container<Real>& rc);
+  RefinementIndicator Indicator() const {
+    return RefinementIndicator::second_derivative;
+  }
 };
 
 } // namespace parthenon
@@ -11,14 +11,18 @@
 // the public, perform publicly and display publicly, and to permit others to do so.
 //========================================================================================
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "amr_criteria.hpp"
 #include "better_refinement.hpp"
 #include "defs.hpp"
 #include "interface/StateDescriptor.hpp"
+#include "kokkos_abstraction.hpp"
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
 
@@ -60,6 +64,15 @@ int CheckAllRefinement(Container<Real>& rc) {
   MeshBlock *pmb = rc.pmy_block;
   // delta_level holds the max over all criteria.  default to derefining.
   int delta_level = -1;
+  auto limit_level = [pmb](const AMRCriteria &amr, int temp_delta) {
+    if ( (temp_delta == 1) && pmb->loc.level >= amr.max_level) {
+      // don't refine if we're at the max level
+      temp_delta = 0;
+    }
+    return temp_delta;
+  };
+  // criteria that are evaluated below, in one reduction per field
+  std::vector<AMRCriteria *> fused;
   for (auto &pkg : pmb->packages) {
     auto& desc = pkg.second;
     // call package specific function, if set
@@ -73,12 +86,12 @@ int CheckAllRefinement(Container<Real>& rc) {
     }
     // call parthenon criteria that were registered
     for (auto & amr : desc->amr_criteria) {
-      // get the recommended change in refinement level from this criteria
-      int temp_delta = (*amr)(rc);
-      if ( (temp_delta == 1) && rc.pmy_block->loc.level >= amr->max_level) {
-        // don't refine if we're at the max level
-        temp_delta = 0;
+      if (amr->Indicator() != RefinementIndicator::none) {
+        fused.push_back(amr.get());
+        continue;
       }
+      // get the recommended change in refinement level from this criteria
+      int temp_delta = limit_level(*amr, (*amr)(rc));
       // maintain the max across all criteria
       delta_level = std::max(delta_level, temp_delta);
       if (delta_level == 1) {
@@ -87,12 +100,119 @@ int CheckAllRefinement(Container<Real>& rc) {
       } 
     }
   }
+
+  // all indicator based criteria reading the same field (with the same filter, if the
+  // second derivative is needed) share one pass over the block
+  for (std::size_t n=0; n<fused.size(); n++) {
+    if (fused[n] == nullptr) continue;
+    const std::string &field = fused[n]->field;
+    const Real filter = fused[n]->filter;
+    auto in_group = [&](const AMRCriteria *amr) {
+      return (amr != nullptr && amr->field == field &&
+              (amr->Indicator() == RefinementIndicator::first_derivative ||
+               amr->filter == filter));
+    };
+    bool first = false, second = false;
+    for (std::size_t m=n; m<fused.size(); m++) {
+      if (!in_group(fused[m])) continue;
+      if (fused[m]->Indicator() == RefinementIndicator::first_derivative) {
+        first = true;
+      } else {
+        second = true;
+      }
+    }
+    IndicatorMaxima maxima = ComputeIndicators(rc.Get(field), first, second, filter);
+    for (std::size_t m=n; m<fused.size(); m++) {
+      if (!in_group(fused[m])) continue;
+      Real indicator = (fused[m]->Indicator() == RefinementIndicator::first_derivative ?
+                        maxima.first_derivative : maxima.second_derivative);
+      int temp_delta = limit_level(*fused[m], fused[m]->Tag(indicator));
+      delta_level = std::max(delta_level, temp_delta);
+      fused[m] = nullptr;
+    }
+    if (delta_level == 1) return 1;
+  }
   return delta_level;
 }
 
-int FirstDerivative(Variable<Real>& q,
-                    const Real refine_criteria, const Real derefine_criteria) {
-  Real maxd = 0.0;
+namespace {
+//----------------------------------------------------------------------------------------
+//! \class IndicatorReduction
+//  \brief Kokkos reduction functor that computes the maxima of the requested
+//  indicators of one field, reading the field only once per cell.  The field lives in
+//  host memory, so the reduction runs in Kokkos::DefaultHostExecutionSpace.
+
+class IndicatorReduction {
+ public:
+  using value_type = IndicatorMaxima;
+
+  IndicatorReduction(Variable<Real>& q, const bool first_derivative,
+                     const bool second_derivative, const Real filter) :
+      q_(q.data()), first_(first_derivative), second_(second_derivative),
+      filter_(filter), ndim_(0) {
+    const int nx1 = q.GetDim1(), nx2 = q.GetDim2(), nx3 = q.GetDim3();
+    if (nx1 > 1) stride_[ndim_++] = 1;
+    if (nx2 > 1) stride_[ndim_++] = nx1;
+    if (nx3 > 1) stride_[ndim_++] = nx1*nx2;
+    nx1_ = nx1;
+    nx2_ = nx2;
+  }
+
+  void operator()(const int k, const int j, const int i, value_type &lmax) const {
+    const int c = i + nx1_*(j + nx2_*k);
+    const Real qc = q_[c];
+    const Real scale = std::abs(qc) + TINY_NUMBER;
+    Real num = 0.0, den = 0.0;
+    for (int d=0; d<ndim_; d++) {
+      const Real qm = q_[c - stride_[d]];
+      const Real qp = q_[c + stride_[d]];
+      if (first_) {
+        const Real d1 = 0.5*std::abs(qp - qm)/scale;
+        lmax.first_derivative = (d1 > lmax.first_derivative ? d1 : lmax.first_derivative);
+      }
+      if (second_) {
+        // Lohner (1987) estimator: second difference normalized by the first
+        // differences plus a filter that suppresses refinement on small ripples
+        const Real d2 = qp - 2.0*qc + qm;
+        const Real dd = std::abs(qp - qc) + std::abs(qc - qm)
+                      + filter_*(std::abs(qp) + 2.0*std::abs(qc) + std::abs(qm));
+        num += d2*d2;
+        den += dd*dd;
+      }
+    }
+    if (second_) {
+      const Real e = std::sqrt(num/(den + TINY_NUMBER));
+      lmax.second_derivative = (e > lmax.second_derivative ? e : lmax.second_derivative);
+    }
+  }
+
+  void init(value_type &val) const {
+    val.first_derivative = 0.0;
+    val.second_derivative = 0.0;
+  }
+
+  void join(volatile value_type &dst, const volatile value_type &src) const {
+    if (src.first_derivative > dst.first_derivative)
+      dst.first_derivative = src.first_derivative;
+    if (src.second_derivative > dst.second_derivative)
+      dst.second_derivative = src.second_derivative;
+  }
+
+ private:
+  const Real *q_;
+  bool first_, second_;
+  Real filter_;
+  int ndim_, nx1_, nx2_;
+  int stride_[3];
+};
+} // namespace
+
+IndicatorMaxima ComputeIndicators(Variable<Real>& q, const bool first_derivative,
+                                  const bool second_derivative, const Real filter) {
+  IndicatorMaxima maxima;
+  maxima.first_derivative = 0.0;
+  maxima.second_derivative = 0.0;
+  // all cells except the outermost layer of the (ghost-padded) array
   const int dim1 = q.GetDim1();
   const int dim2 = q.GetDim2();
   const int dim3 = q.GetDim3();
@@ -109,26 +229,28 @@ int FirstDerivative(Variable<Real>& q,
     il = 1;
     iu = dim1-2;
   }
-  for (int k=kl; k<=ku; k++) {
-    for (int j=jl; j<=ju; j++) {
-      for (int i=il; i<=iu; i++) {
-        Real scale = std::abs(q(k,j,i));
-        Real d = 0.5*std::abs((q(k,j,i+1)-q(k,j,i-1)))/(scale+TINY_NUMBER);
-        maxd = (d > maxd ? d : maxd);
-        if (dim2 > 1) {
-          d = 0.5*std::abs((q(k,j+1,i)-q(k,j-1,i)))/(scale+TINY_NUMBER);
-          maxd = (d > maxd ? d : maxd);
-        }
-        if (dim3 > 1) {
-          d = 0.5*std::abs((q(k+1,j,i) - q(k-1,j,i)))/(scale+TINY_NUMBER);
-          maxd = (d > maxd ? d : maxd);
-        }
-      }
-    }
-  }
+  if (!first_derivative && !second_derivative) return maxima;
+  par_reduce("BetterRefinement::ComputeIndicators",
+             Kokkos::DefaultHostExecutionSpace(), kl, ku, jl, ju, il, iu,
+             IndicatorReduction(q, first_derivative, second_derivative, filter),
+             maxima);
+  return maxima;
+}
+
+int FirstDerivative(Variable<Real>& q,
+                    const Real refine_criteria, const Real derefine_criteria) {
+  Real maxd = ComputeIndicators(q, true, false, 0.0).first_derivative;
   if (maxd > refine_criteria) return 1;
   if (maxd < derefine_criteria) return -1;
-  return 0;;
+  return 0;
+}
+
+int SecondDerivative(Variable<Real>& q, const Real refine_criteria,
+                     const Real derefine_criteria, const Real filter) {
+  Real maxe = ComputeIndicators(q, false, true, filter).second_derivative;
+  if (maxe > refine_criteria) return 1;
+  if (maxe < derefine_criteria) return -1;
+  return 0;
 }
 
 } // namespace BetterRefinement
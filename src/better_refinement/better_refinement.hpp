@@ -26,10 +26,20 @@ namespace parthenon {
 class ParameterInput;
 
 namespace BetterRefinement {
+  // maxima over a block of the indicators that can be computed in one fused reduction
+  struct IndicatorMaxima {
+    Real first_derivative;
+    Real second_derivative;
+  };
+
   std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin);
   int CheckAllRefinement(Container<Real>& rc);
+  IndicatorMaxima ComputeIndicators(Variable<Real>& q, const bool first_derivative,
+                                    const bool second_derivative, const Real filter);
   int FirstDerivative(Variable<Real>& q,
                       const Real refine_criteria, const Real derefine_criteria);
+  int SecondDerivative(Variable<Real>& q, const Real refine_criteria,
+                       const Real derefine_criteria, const Real filter);
 } // namespace BetterRefinement
 
 } // namespace parthenon
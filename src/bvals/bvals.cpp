@@ -92,6 +92,8 @@ BoundaryValues::BoundaryValues(MeshBlock *pmb, BoundaryFlag *input_bcs,
   // Matches initial value of Mesh::next_phys_id_
   // reserve phys=0 for former TAG_AMR=8; now hard-coded in Mesh::CreateAMRMPITag()
   bvars_next_phys_id_ = 1;
+
+  batched_prolongation_ = pin->GetOrAddBoolean("mesh", "batched_prolongation", false);
 }
 
 // destructor
@@ -78,7 +78,7 @@ class BoundaryBase {
   static int BufferID(int dim, bool multilevel);
   static int FindBufferID(int ox1, int ox2, int ox3, int fi1, int fi2);
 
-  void SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist, int *nslist);
+  void SearchAndSetNeighbors(MeshBlockTree &tree, int *nslist);
 
  protected:
   // 1D refined or unrefined=2
@@ -143,6 +143,25 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
   // communication (subset of Mesh::next_phys_id_)
   int bvars_next_phys_id_;
 
+  // index ranges (in the coarse buffer) of one same-level ghost-ghost zone that must be
+  // restricted, or of one coarse-fine ghost zone that must be prolongated
+  struct RestrictionRegion {
+    const NeighborBlock *pnb;
+    int nk, nj, ni;
+    int si, ei, sj, ej, sk, ek;
+  };
+  struct ProlongationRegion {
+    const NeighborBlock *pnb;
+    int si, ei, sj, ej, sk, ek;
+  };
+
+  // if true, ProlongateBoundaries() collects all coarse-fine regions of the MeshBlock
+  // and processes them for every refined variable in a single pass
+  bool batched_prolongation_;
+  // work lists reused between calls to ProlongateBoundariesBatched()
+  std::vector<RestrictionRegion> restrict_regions_;
+  std::vector<ProlongationRegion> prolong_regions_;
+
   // ProlongateBoundaries() wraps the following S/AMR-operations (within nneighbor loop):
   // (the next function is also called within 3x nested loops over nk,nj,ni)
   void RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int nk, int nj, int ni);
@@ -152,6 +171,20 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
   void ProlongateGhostCells(const NeighborBlock& nb,
                             int si, int ei, int sj, int ej, int sk, int ek);
 
+  // helpers shared by the per-neighbor and the batched prolongation
+  void ProlongateBoundariesBatched();
+  void CalculateRestrictionIndices(const NeighborBlock& nb, int nk, int nj, int ni,
+                                   int &ris, int &rie, int &rjs, int &rje,
+                                   int &rks, int &rke);
+  void CalculateProlongationIndices(const NeighborBlock& nb,
+                                    int &si, int &ei, int &sj, int &ej,
+                                    int &sk, int &ek);
+  void RestrictFaceFieldsOnSameLevel(int nk, int nj, int ni,
+                                     int ris, int rie, int rjs, int rje,
+                                     int rks, int rke);
+  void ProlongateFaceFields(const NeighborBlock& nb,
+                            int si, int ei, int sj, int ej, int sk, int ek);
+
   // temporary--- Added by @tomidakn on 2015-11-27 in f0f989f85f
   // TODO(KGF): consider removing this friendship designation
   friend class Mesh;
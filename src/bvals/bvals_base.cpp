@@ -262,14 +262,14 @@ int BoundaryBase::CreateBvalsMPITag(int lid, int bufid, int phys) {
 
 
 //----------------------------------------------------------------------------------------
-// \!fn void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree,
-//                                               int *ranklist, int *nslist)
-// \brief Search and set all the neighbor blocks
+// \!fn void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *nslist)
+// \brief Search and set all the neighbor blocks; the owner rank of each neighbor is
+//  recovered from the starting gids in nslist
 
 // TODO(felker): break-up this long function
 
-void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
-                                         int *nslist) {
+void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *nslist) {
+  auto rank_of = [nslist](int gid) { return Mesh::FindRankOfBlock(gid, nslist); };
   MeshBlockTree* neibt;
   int myox1, myox2 = 0, myox3 = 0, myfx1, myfx2, myfx3;
   myfx1 = ((loc.lx1 & 1LL) == 1LL);
@@ -307,8 +307,8 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int fid = nf->gid_;
           int nlevel = nf->loc_.level;
           int tbid = FindBufferID(-n, 0, 0, 0, 0);
-          neighbor[nneighbor].SetNeighbor(ranklist[fid], nlevel, fid,
-                                          fid-nslist[ranklist[fid]], n, 0, 0,
+          neighbor[nneighbor].SetNeighbor(rank_of(fid), nlevel, fid,
+                                          fid-nslist[rank_of(fid)], n, 0, 0,
                                           NeighborConnect::face, bufid, tbid, f1, f2);
           bufid++; nneighbor++;
         }
@@ -324,7 +324,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
         tbid = FindBufferID(-n, 0, 0,myfx2,myfx3);
       }
       neighbor[nneighbor].SetNeighbor(
-          ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], n, 0, 0,
+          rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], n, 0, 0,
           NeighborConnect::face, bufid, tbid);
       bufid += nf1*nf2; nneighbor++;
     }
@@ -345,7 +345,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int nlevel = nf->loc_.level;
           int tbid = FindBufferID(0, -n, 0, 0, 0);
           neighbor[nneighbor].SetNeighbor(
-              ranklist[fid], nlevel, fid, fid-nslist[ranklist[fid]], 0, n, 0,
+              rank_of(fid), nlevel, fid, fid-nslist[rank_of(fid)], 0, n, 0,
               NeighborConnect::face, bufid, tbid, f1, f2);
           bufid++; nneighbor++;
         }
@@ -361,7 +361,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
         tbid = FindBufferID(0, -n, 0, myfx1, myfx3);
       }
       neighbor[nneighbor].SetNeighbor(
-          ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], 0, n, 0,
+          rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], 0, n, 0,
           NeighborConnect::face, bufid, tbid);
       bufid += nf1*nf2; nneighbor++;
     }
@@ -382,7 +382,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
             int nlevel = nf->loc_.level;
             int tbid = FindBufferID(0, 0,  -n, 0, 0);
             neighbor[nneighbor].SetNeighbor(
-                ranklist[fid], nlevel, fid, fid-nslist[ranklist[fid]], 0, 0, n,
+                rank_of(fid), nlevel, fid, fid-nslist[rank_of(fid)], 0, 0, n,
                 NeighborConnect::face, bufid, tbid, f1, f2);
             bufid++; nneighbor++;
           }
@@ -398,7 +398,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           tbid = FindBufferID(0, 0, -n, myfx1, myfx2);
         }
         neighbor[nneighbor].SetNeighbor(
-            ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], 0, 0, n,
+            rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], 0, 0, n,
             NeighborConnect::face, bufid, tbid);
         bufid += nf1*nf2; nneighbor++;
       }
@@ -420,8 +420,8 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int fid = nf->gid_;
           int nlevel = nf->loc_.level;
           int tbid = FindBufferID(-n, -m, 0, 0, 0);
-          neighbor[nneighbor].SetNeighbor(ranklist[fid], nlevel, fid,
-                                          fid-nslist[ranklist[fid]], n, m, 0,
+          neighbor[nneighbor].SetNeighbor(rank_of(fid), nlevel, fid,
+                                          fid-nslist[rank_of(fid)], n, m, 0,
                                           NeighborConnect::edge, bufid, tbid, f1, 0);
           bufid++; nneighbor++;
         }
@@ -437,7 +437,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
         }
         if (nlevel >= loc.level || (myox1 == n && myox2 == m)) {
           neighbor[nneighbor].SetNeighbor(
-              ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], n, m, 0,
+              rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], n, m, 0,
               NeighborConnect::edge, bufid, tbid);
           nneighbor++;
         }
@@ -462,8 +462,8 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int fid = nf->gid_;
           int nlevel = nf->loc_.level;
           int tbid = FindBufferID(-n, 0, -m, 0, 0);
-          neighbor[nneighbor].SetNeighbor(ranklist[fid], nlevel, fid,
-                                          fid-nslist[ranklist[fid]], n, 0, m,
+          neighbor[nneighbor].SetNeighbor(rank_of(fid), nlevel, fid,
+                                          fid-nslist[rank_of(fid)], n, 0, m,
                                           NeighborConnect::edge, bufid, tbid, f1, 0);
           bufid++; nneighbor++;
         }
@@ -479,7 +479,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
         }
         if (nlevel >= loc.level || (myox1 == n && myox3 == m)) {
           neighbor[nneighbor].SetNeighbor(
-              ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], n, 0, m,
+              rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], n, 0, m,
               NeighborConnect::edge, bufid, tbid);
           nneighbor++;
         }
@@ -502,8 +502,8 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int fid = nf->gid_;
           int nlevel = nf->loc_.level;
           int tbid = FindBufferID(0, -n, -m, 0, 0);
-          neighbor[nneighbor].SetNeighbor(ranklist[fid], nlevel, fid,
-                                          fid-nslist[ranklist[fid]], 0, n, m,
+          neighbor[nneighbor].SetNeighbor(rank_of(fid), nlevel, fid,
+                                          fid-nslist[rank_of(fid)], 0, n, m,
                                           NeighborConnect::edge, bufid, tbid, f1, 0);
           bufid++; nneighbor++;
         }
@@ -519,7 +519,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
         }
         if (nlevel >= loc.level || (myox2 == n && myox3 == m)) {
           neighbor[nneighbor].SetNeighbor(
-              ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], 0, n, m,
+              rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], 0, n, m,
               NeighborConnect::edge, bufid, tbid);
           nneighbor++;
         }
@@ -546,7 +546,7 @@ void BoundaryBase::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
           int nid = neibt->gid_;
           int tbid = FindBufferID(-n, -m, -l, 0, 0);
           neighbor[nneighbor].SetNeighbor(
-              ranklist[nid], nlevel, nid, nid-nslist[ranklist[nid]], n, m, l,
+              rank_of(nid), nlevel, nid, nid-nslist[rank_of(nid)], n, m, l,
               NeighborConnect::corner, bufid, tbid);
           nneighbor++;
         }
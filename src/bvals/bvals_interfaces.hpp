@@ -23,12 +23,15 @@
 // TODO(felker): consider moving enums and structs in a new file? bvals_structs.hpp?
 
 // C++ headers
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t
 #include <string>   // string
 #include <vector>   // vector
 
 // Athena++ classes headers
 #include "athena.hpp"
 #include "athena_arrays.hpp"
+#include "utils/comm_stats.hpp"
 
 // MPI headers
 #ifdef MPI_PARALLEL
@@ -154,6 +157,8 @@ struct BoundaryData { // aggregate and POD (even when MPI_PARALLEL is defined)
   // red-black comm. pattern; need to check if they are available)
   BoundaryStatus flag[kMaxNeighbor], sflag[kMaxNeighbor];
   Real *send[kMaxNeighbor], *recv[kMaxNeighbor];
+  // when a receive was first found outstanding, 0 if not waited for (CommStats only)
+  std::int64_t wait_start[kMaxNeighbor];
 #ifdef MPI_PARALLEL
   MPI_Request req_send[kMaxNeighbor], req_recv[kMaxNeighbor];
 #endif
@@ -245,9 +250,13 @@ class BoundaryVariable : public BoundaryCommunication, public BoundaryBuffer {
   void ReceiveAndSetBoundariesWithWait() override;
   void SetBoundaries() override;
 
+  // bytes of send and receive buffers allocated by InitBoundaryData()
+  std::size_t GetBufferSizeInBytes() const { return buffer_bytes_; }
+
  protected:
   // deferred initialization of BoundaryData objects in derived class constructors
   BoundaryData<> bd_var_, bd_var_flcor_;
+  std::size_t buffer_bytes_ = 0;
   // derived class dtors are also responsible for calling DestroyBoundaryData(bd_var_)
 
   MeshBlock *pmy_block_;   // ptr to MeshBlock containing this BoundaryVariable
@@ -259,6 +268,12 @@ class BoundaryVariable : public BoundaryCommunication, public BoundaryBuffer {
   void InitBoundaryData(BoundaryData<> &bd, BoundaryQuantity type);
   void DestroyBoundaryData(BoundaryData<> &bd);
 
+  // CommStats bookkeeping of a receive from nb that is still outstanding, or that has
+  // just been found to have arrived
+  void RecordReceivePending(BoundaryData<> &bd, const NeighborBlock &nb);
+  void RecordReceiveArrived(BoundaryData<> &bd, const NeighborBlock &nb,
+                            const CommStats::Channel c);
+
   // private:
 };
 }
@@ -77,6 +77,10 @@ namespace parthenon {
 // (automatically switches back to conserved variables at the end of fn)
 
 void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt) {
+  if (batched_prolongation_) {
+    ProlongateBoundariesBatched();
+    return;
+  }
   MeshBlock *pmb = pmy_block_;
   int &mylevel = pmb->loc.level;
 
@@ -129,33 +133,8 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt) {
     }
 
     // calculate the loop limits for the ghost zones
-    int cn = pmb->cnghost - 1;
     int si, ei, sj, ej, sk, ek;
-    if (nb.ni.ox1 == 0) {
-      std::int64_t &lx1 = pmb->loc.lx1;
-      si = pmb->cis, ei = pmb->cie;
-      if ((lx1 & 1LL) == 0LL) ei += cn;
-      else             si -= cn;
-    } else if (nb.ni.ox1 > 0) { si = pmb->cie + 1,  ei = pmb->cie + cn;}
-    else              si = pmb->cis-cn, ei = pmb->cis-1;
-    if (nb.ni.ox2 == 0) {
-      sj = pmb->cjs, ej = pmb->cje;
-      if (pmb->block_size.nx2 > 1) {
-        std::int64_t &lx2 = pmb->loc.lx2;
-        if ((lx2 & 1LL) == 0LL) ej += cn;
-        else             sj -= cn;
-      }
-    } else if (nb.ni.ox2 > 0) { sj = pmb->cje + 1,  ej = pmb->cje + cn;}
-    else              sj = pmb->cjs-cn, ej = pmb->cjs-1;
-    if (nb.ni.ox3 == 0) {
-      sk = pmb->cks, ek = pmb->cke;
-      if (pmb->block_size.nx3 > 1) {
-        std::int64_t &lx3 = pmb->loc.lx3;
-        if ((lx3 & 1LL) == 0LL) ek += cn;
-        else             sk -= cn;
-      }
-    } else if (nb.ni.ox3 > 0) { sk = pmb->cke + 1,  ek = pmb->cke + cn;}
-    else              sk = pmb->cks-cn, ek = pmb->cks-1;
+    CalculateProlongationIndices(nb, si, ei, sj, ej, sk, ek);
 
     // (temp workaround) to automatically call all BoundaryFunction_[] on coarse_prim/b
     // instead of previous targets var_cc=cons, var_fc=b
@@ -172,13 +151,158 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::ProlongateBoundariesBatched()
+//  \brief same result as the per-neighbor loop in ProlongateBoundaries(), but all
+//  coarse-fine regions of the MeshBlock are first collected into work lists that are
+//  then processed for every refined variable in one pass.
+//
+//  Restrictions only read fine cells of same-level neighbors and prolongations only
+//  write fine cells of coarser neighbors, so all restrictions can be done before all
+//  prolongations.  Ghost-ghost zones shared by several coarse neighbors are restricted
+//  only once, and the (variable, region) prolongation pairs are independent of each other.
 
-void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int nk,
-                                                   int nj, int ni) {
+void BoundaryValues::ProlongateBoundariesBatched() {
   MeshBlock *pmb = pmy_block_;
   MeshRefinement *pmr = pmb->pmr.get();
+  int &mylevel = pmb->loc.level;
 
-  int ris, rie, rjs, rje, rks, rke;
+  // Step 0. Build the work lists
+  restrict_regions_.clear();
+  prolong_regions_.clear();
+  for (int n=0; n<nneighbor; n++) {
+    const NeighborBlock& nb = neighbor[n];
+    if (nb.snb.level >= mylevel) continue;
+    int nis = std::max(nb.ni.ox1-1, -1), nie = std::min(nb.ni.ox1+1, 1);
+    int njs = 0, nje = 0, nks = 0, nke = 0;
+    if (pmb->block_size.nx2 > 1) {
+      njs = std::max(nb.ni.ox2-1, -1);
+      nje = std::min(nb.ni.ox2+1, 1);
+    }
+    if (pmb->block_size.nx3 > 1) {
+      nks = std::max(nb.ni.ox3-1, -1);
+      nke = std::min(nb.ni.ox3+1, 1);
+    }
+    for (int nk=nks; nk<=nke; nk++) {
+      for (int nj=njs; nj<=nje; nj++) {
+        for (int ni=nis; ni<=nie; ni++) {
+          int ntype = std::abs(ni) + std::abs(nj) + std::abs(nk);
+          if (ntype == 0 || nblevel[nk+1][nj+1][ni+1] != mylevel) continue;
+          RestrictionRegion r;
+          r.pnb = &nb;
+          r.nk = nk, r.nj = nj, r.ni = ni;
+          CalculateRestrictionIndices(nb, nk, nj, ni, r.si, r.ei, r.sj, r.ej,
+                                      r.sk, r.ek);
+          // skip ghost-ghost zones that were already requested by another neighbor
+          bool duplicate = false;
+          for (const auto &q : restrict_regions_) {
+            if (q.nk == nk && q.nj == nj && q.ni == ni && q.si == r.si && q.ei == r.ei
+                && q.sj == r.sj && q.ej == r.ej && q.sk == r.sk && q.ek == r.ek) {
+              duplicate = true;
+              break;
+            }
+          }
+          if (!duplicate) restrict_regions_.push_back(r);
+        }
+      }
+    }
+    ProlongationRegion p;
+    p.pnb = &nb;
+    CalculateProlongationIndices(nb, p.si, p.ei, p.sj, p.ej, p.sk, p.ek);
+    prolong_regions_.push_back(p);
+  }
+  if (prolong_regions_.empty()) return;
+
+  const int nthreads = pmy_mesh_->GetNumMeshThreads();
+  const int nvar_cc = static_cast<int>(pmr->pvars_cc_.size());
+  const int nreg = static_cast<int>(prolong_regions_.size());
+
+  // Step 1. Restrict all same-level ghost-ghost zones.  This stays serial, since
+  // RestrictCellCenteredValues() computes the fine cell volumes in MeshRefinement::fvol_,
+  // which is shared by all variables of the MeshBlock.
+  for (int v=0; v<nvar_cc; v++) {
+    AthenaArray<Real> *var_cc = std::get<0>(pmr->pvars_cc_[v]);
+    AthenaArray<Real> *coarse_cc = std::get<1>(pmr->pvars_cc_[v]);
+    int nu = var_cc->GetDim4() - 1;
+    for (const auto &r : restrict_regions_) {
+      pmr->RestrictCellCenteredValues(*var_cc, *coarse_cc, 0, nu,
+                                      r.si, r.ei, r.sj, r.ej, r.sk, r.ek);
+    }
+  }
+  for (const auto &r : restrict_regions_) {
+    RestrictFaceFieldsOnSameLevel(r.nk, r.nj, r.ni, r.si, r.ei, r.sj, r.ej, r.sk, r.ek);
+  }
+
+  // Step 2. Re-apply physical boundaries on the coarse boundary (see above; disabled)
+
+  // Step 3. Prolongate every (variable, region) pair; the fine cells written by two
+  // coarser neighbors never overlap
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+  for (int m=0; m<nvar_cc*nreg; m++) {
+    AthenaArray<Real> *var_cc = std::get<0>(pmr->pvars_cc_[m/nreg]);
+    AthenaArray<Real> *coarse_cc = std::get<1>(pmr->pvars_cc_[m/nreg]);
+    const ProlongationRegion &p = prolong_regions_[m%nreg];
+    int nu = var_cc->GetDim4() - 1;
+    pmr->ProlongateCellCenteredValues(*coarse_cc, *var_cc, 0, nu,
+                                      p.si, p.ei, p.sj, p.ej, p.sk, p.ek);
+  }
+  for (const auto &p : prolong_regions_) {
+    ProlongateFaceFields(*p.pnb, p.si, p.ei, p.sj, p.ej, p.sk, p.ek);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::CalculateProlongationIndices(const NeighborBlock& nb,
+//           int &si, int &ei, int &sj, int &ej, int &sk, int &ek)
+//  \brief calculate the loop limits (in the coarse buffer) of the ghost zones to be
+//  prolongated from the coarser neighbor nb
+
+void BoundaryValues::CalculateProlongationIndices(const NeighborBlock& nb,
+                                                  int &si, int &ei, int &sj, int &ej,
+                                                  int &sk, int &ek) {
+  MeshBlock *pmb = pmy_block_;
+  int cn = pmb->cnghost - 1;
+  if (nb.ni.ox1 == 0) {
+    std::int64_t &lx1 = pmb->loc.lx1;
+    si = pmb->cis, ei = pmb->cie;
+    if ((lx1 & 1LL) == 0LL) ei += cn;
+    else             si -= cn;
+  } else if (nb.ni.ox1 > 0) { si = pmb->cie + 1,  ei = pmb->cie + cn;}
+  else              si = pmb->cis-cn, ei = pmb->cis-1;
+  if (nb.ni.ox2 == 0) {
+    sj = pmb->cjs, ej = pmb->cje;
+    if (pmb->block_size.nx2 > 1) {
+      std::int64_t &lx2 = pmb->loc.lx2;
+      if ((lx2 & 1LL) == 0LL) ej += cn;
+      else             sj -= cn;
+    }
+  } else if (nb.ni.ox2 > 0) { sj = pmb->cje + 1,  ej = pmb->cje + cn;}
+  else              sj = pmb->cjs-cn, ej = pmb->cjs-1;
+  if (nb.ni.ox3 == 0) {
+    sk = pmb->cks, ek = pmb->cke;
+    if (pmb->block_size.nx3 > 1) {
+      std::int64_t &lx3 = pmb->loc.lx3;
+      if ((lx3 & 1LL) == 0LL) ek += cn;
+      else             sk -= cn;
+    }
+  } else if (nb.ni.ox3 > 0) { sk = pmb->cke + 1,  ek = pmb->cke + cn;}
+  else              sk = pmb->cks-cn, ek = pmb->cks-1;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::CalculateRestrictionIndices(const NeighborBlock& nb,
+//           int nk, int nj, int ni, int &ris, int &rie, int &rjs, int &rje,
+//           int &rks, int &rke)
+//  \brief calculate the loop limits (in the coarse buffer) of the same-level
+//  ghost-ghost zone (nk,nj,ni) needed to prolongate the coarser neighbor nb
+
+void BoundaryValues::CalculateRestrictionIndices(const NeighborBlock& nb,
+                                                 int nk, int nj, int ni,
+                                                 int &ris, int &rie, int &rjs, int &rje,
+                                                 int &rks, int &rke) {
+  MeshBlock *pmb = pmy_block_;
   if (ni == 0) {
     ris = pmb->cis;
     rie = pmb->cie;
@@ -210,6 +334,16 @@ void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int
   } else { //(nk == -1)
     rks = pmb->cks - 1, rke = pmb->cks - 1;
   }
+  return;
+}
+
+void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int nk,
+                                                   int nj, int ni) {
+  MeshBlock *pmb = pmy_block_;
+  MeshRefinement *pmr = pmb->pmr.get();
+
+  int ris, rie, rjs, rje, rks, rke;
+  CalculateRestrictionIndices(nb, nk, nj, ni, ris, rie, rjs, rje, rks, rke);
 
   for (auto cc_pair : pmr->pvars_cc_) {
     AthenaArray<Real> *var_cc = std::get<0>(cc_pair);
@@ -219,6 +353,16 @@ void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int
                                          ris, rie, rjs, rje, rks, rke);
   }
 
+  RestrictFaceFieldsOnSameLevel(nk, nj, ni, ris, rie, rjs, rje, rks, rke);
+  return;
+}
+
+void BoundaryValues::RestrictFaceFieldsOnSameLevel(int nk, int nj, int ni,
+                                                   int ris, int rie, int rjs, int rje,
+                                                   int rks, int rke) {
+  MeshBlock *pmb = pmy_block_;
+  MeshRefinement *pmr = pmb->pmr.get();
+
   for (auto fc_pair : pmr->pvars_fc_) {
     FaceField *var_fc = std::get<0>(fc_pair);
     FaceField *coarse_fc = std::get<1>(fc_pair);
@@ -287,7 +431,50 @@ void BoundaryValues::ProlongateGhostCells(const NeighborBlock& nb,
                                       si, ei, sj, ej, sk, ek);
   }
 
-  // prolongate face-centered S/AMR-enrolled quantities (magnetic fields)
+  ProlongateFaceFields(nb, si, ei, sj, ej, sk, ek);
+
+  // now that the ghost-ghost zones are filled and prolongated,
+  // calculate the loop limits for the finer grid
+  int fsi, fei, fsj, fej, fsk, fek;
+  fsi = (si - pmb->cis)*2 + pmb->is;
+  fei = (ei - pmb->cis)*2 + pmb->is + 1;
+  if (pmb->block_size.nx2 > 1) {
+    fsj = (sj - pmb->cjs)*2 + pmb->js;
+    fej = (ej - pmb->cjs)*2 + pmb->js + 1;
+  } else {
+    fsj = pmb->js;
+    fej = pmb->je;
+  }
+  if (pmb->block_size.nx3 > 1) {
+    fsk = (sk - pmb->cks)*2 + pmb->ks;
+    fek = (ek - pmb->cks)*2 + pmb->ks + 1;
+  } else {
+    fsk = pmb->ks;
+    fek = pmb->ke;
+  }
+
+  // KGF: COUPLING OF QUANTITIES (must be manually specified)
+  // Field prolongation completed, calculate cell centered fields
+  // TODO(KGF): passing nullptrs (pf) if no MHD (coarse_* no longer in MeshRefinement)
+  // (may be fine to unconditionally directly set to pmb->pfield now. see above comment)
+
+  // KGF: COUPLING OF QUANTITIES (must be manually specified)
+  // calculate conservative variables
+  //pmb->peos->PrimitiveToConserved(ph->w, pf->bcc, ph->u, pmb->pcoord,
+  //                                fsi, fei, fsj, fej, fsk, fek);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::ProlongateFaceFields(const NeighborBlock& nb,
+//           int si, int ei, int sj, int ej, int sk, int ek)
+//  \brief prolongate face-centered S/AMR-enrolled quantities (magnetic fields)
+
+void BoundaryValues::ProlongateFaceFields(const NeighborBlock& nb,
+                                          int si, int ei, int sj, int ej,
+                                          int sk, int ek) {
+  MeshBlock *pmb = pmy_block_;
+  auto &pmr = pmb->pmr;
   int &mylevel = pmb->loc.level;
   int il, iu, jl, ju, kl, ku;
   il = si, iu = ei + 1;
@@ -329,36 +516,6 @@ void BoundaryValues::ProlongateGhostCells(const NeighborBlock& nb,
     // step 4. calculate the internal finer fields using the Toth & Roe method
     pmr->ProlongateInternalField((*var_fc), si, ei, sj, ej, sk, ek);
   }
-
-  // now that the ghost-ghost zones are filled and prolongated,
-  // calculate the loop limits for the finer grid
-  int fsi, fei, fsj, fej, fsk, fek;
-  fsi = (si - pmb->cis)*2 + pmb->is;
-  fei = (ei - pmb->cis)*2 + pmb->is + 1;
-  if (pmb->block_size.nx2 > 1) {
-    fsj = (sj - pmb->cjs)*2 + pmb->js;
-    fej = (ej - pmb->cjs)*2 + pmb->js + 1;
-  } else {
-    fsj = pmb->js;
-    fej = pmb->je;
-  }
-  if (pmb->block_size.nx3 > 1) {
-    fsk = (sk - pmb->cks)*2 + pmb->ks;
-    fek = (ek - pmb->cks)*2 + pmb->ks + 1;
-  } else {
-    fsk = pmb->ks;
-    fek = pmb->ke;
-  }
-
-  // KGF: COUPLING OF QUANTITIES (must be manually specified)
-  // Field prolongation completed, calculate cell centered fields
-  // TODO(KGF): passing nullptrs (pf) if no MHD (coarse_* no longer in MeshRefinement)
-  // (may be fine to unconditionally directly set to pmb->pfield now. see above comment)
-
-  // KGF: COUPLING OF QUANTITIES (must be manually specified)
-  // calculate conservative variables
-  //pmb->peos->PrimitiveToConserved(ph->w, pf->bcc, ph->u, pmb->pcoord,
-  //                                fsi, fei, fsj, fej, fsk, fek);
   return;
 }
 }
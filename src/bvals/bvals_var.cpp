@@ -29,6 +29,7 @@
 // Athena++ headers
 #include "globals.hpp"
 #include "mesh/mesh.hpp"
+#include "utils/timers.hpp"
 #include "bvals_interfaces.hpp"
 
 // MPI header
@@ -68,6 +69,7 @@ void BoundaryVariable::InitBoundaryData(BoundaryData<> &bd, BoundaryQuantity typ
     bd.sflag[n] = BoundaryStatus::waiting;
     bd.send[n] = nullptr;
     bd.recv[n] = nullptr;
+    bd.wait_start[n] = 0;
 #ifdef MPI_PARALLEL
     bd.req_send[n] = MPI_REQUEST_NULL;
     bd.req_recv[n] = MPI_REQUEST_NULL;
@@ -85,6 +87,7 @@ void BoundaryVariable::InitBoundaryData(BoundaryData<> &bd, BoundaryQuantity typ
     }
     bd.send[n] = new Real[size];
     bd.recv[n] = new Real[size];
+    buffer_bytes_ += 2*sizeof(Real)*static_cast<std::size_t>(size);
   }
 }
 
@@ -145,6 +148,33 @@ void BoundaryVariable::CopyFluxCorrectionBufferSameProcess(NeighborBlock& nb, in
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryVariable::RecordReceivePending(BoundaryData<> &bd,
+//                                                   const NeighborBlock &nb)
+//  \brief start the wait clock of the receive from nb, if not already running
+
+void BoundaryVariable::RecordReceivePending(BoundaryData<> &bd, const NeighborBlock &nb) {
+  if (CommStats::enabled && bd.wait_start[nb.bufid] == 0)
+    bd.wait_start[nb.bufid] = CommStats::Now();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryVariable::RecordReceiveArrived(BoundaryData<> &bd,
+//                                                   const NeighborBlock &nb,
+//                                                   const CommStats::Channel c)
+//  \brief count the time a receive from nb was waited for, if it was
+
+void BoundaryVariable::RecordReceiveArrived(BoundaryData<> &bd, const NeighborBlock &nb,
+                                            const CommStats::Channel c) {
+  if (bd.wait_start[nb.bufid] == 0) return;
+  if (CommStats::enabled) {
+    CommStats::Wait(c, CommStats::RelationOf(nb.snb.level, pmy_block_->loc.level),
+                    nb.snb.rank == Globals::my_rank,
+                    CommStats::Now() - bd.wait_start[nb.bufid]);
+  }
+  bd.wait_start[nb.bufid] = 0;
+}
+
 // Default / shared implementations of 4x BoundaryBuffer public functions
 
 //----------------------------------------------------------------------------------------
@@ -164,6 +194,11 @@ void BoundaryVariable::SendBoundaryBuffers() {
       ssize = LoadBoundaryBufferToCoarser(bd_var_.send[nb.bufid], nb);
     else
       ssize = LoadBoundaryBufferToFiner(bd_var_.send[nb.bufid], nb);
+    if (CommStats::enabled) {
+      CommStats::Send(CommStats::Channel::boundary,
+                      CommStats::RelationOf(mylevel, nb.snb.level),
+                      nb.snb.rank == Globals::my_rank, ssize*sizeof(Real));
+    }
     if (nb.snb.rank == Globals::my_rank) {  // on the same process
       CopyVariableBufferSameProcess(nb, ssize);
     }
@@ -186,9 +221,13 @@ bool BoundaryVariable::ReceiveBoundaryBuffers() {
 
   for (int n=0; n < pmy_block_->pbval->nneighbor; n++) {
     NeighborBlock& nb = pmy_block_->pbval->neighbor[n];
-    if (bd_var_.flag[nb.bufid] == BoundaryStatus::arrived) continue;
+    if (bd_var_.flag[nb.bufid] == BoundaryStatus::arrived) {
+      RecordReceiveArrived(bd_var_, nb, CommStats::Channel::boundary);
+      continue;
+    }
     if (bd_var_.flag[nb.bufid] == BoundaryStatus::waiting) {
       if (nb.snb.rank == Globals::my_rank) {  // on the same process
+        RecordReceivePending(bd_var_, nb);
         bflag = false;
         continue;
       }
@@ -198,10 +237,12 @@ bool BoundaryVariable::ReceiveBoundaryBuffers() {
         MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &test, MPI_STATUS_IGNORE);
         MPI_Test(&(bd_var_.req_recv[nb.bufid]), &test, MPI_STATUS_IGNORE);
         if (!static_cast<bool>(test)) {
+          RecordReceivePending(bd_var_, nb);
           bflag = false;
           continue;
         }
         bd_var_.flag[nb.bufid] = BoundaryStatus::arrived;
+        RecordReceiveArrived(bd_var_, nb, CommStats::Channel::boundary);
       }
 #endif
     }
@@ -242,8 +283,12 @@ void BoundaryVariable::ReceiveAndSetBoundariesWithWait() {
   for (int n=0; n < pmb->pbval->nneighbor; n++) {
     NeighborBlock& nb = pmb->pbval->neighbor[n];
 #ifdef MPI_PARALLEL
-    if (nb.snb.rank != Globals::my_rank)
+    if (nb.snb.rank != Globals::my_rank) {
+      Timers::ScopedRegion region("MPI_Wait");
+      RecordReceivePending(bd_var_, nb);
       MPI_Wait(&(bd_var_.req_recv[nb.bufid]),MPI_STATUS_IGNORE);
+      RecordReceiveArrived(bd_var_, nb, CommStats::Channel::boundary);
+    }
 #endif
     if (nb.snb.level == mylevel)
       SetBoundarySameLevel(bd_var_.recv[nb.bufid], nb);
@@ -35,6 +35,7 @@
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
 #include "utils/buffer_utils.hpp"
+#include "utils/timers.hpp"
 #include "bvals_cc.hpp"
 
 // MPI header
@@ -467,6 +468,7 @@ void CellCenteredBoundaryVariable::ClearBoundary(BoundaryCommSubset phase) {
     MeshBlock *pmb = pmy_block_;
     int mylevel = pmb->loc.level;
     if (nb.snb.rank != Globals::my_rank) {
+      Timers::ScopedRegion region("MPI_Wait");
       // Wait for Isend
       MPI_Wait(&(bd_var_.req_send[nb.bufid]), MPI_STATUS_IGNORE);
       if (phase == BoundaryCommSubset::all && nb.ni.type == NeighborConnect::face
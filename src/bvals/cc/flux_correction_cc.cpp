@@ -142,6 +142,11 @@ void CellCenteredBoundaryVariable::SendFluxCorrection() {
           }
         }
       }
+      if (CommStats::enabled) {
+        CommStats::Send(CommStats::Channel::flux_correction,
+                        CommStats::Relation::fine_to_coarse,
+                        nb.snb.rank == Globals::my_rank, p*sizeof(Real));
+      }
       if (nb.snb.rank == Globals::my_rank) { // on the same node
         CopyFluxCorrectionBufferSameProcess(nb, p);
       }
@@ -171,6 +176,7 @@ bool CellCenteredBoundaryVariable::ReceiveFluxCorrection() {
       if (bd_var_flcor_.flag[nb.bufid] == BoundaryStatus::completed) continue;
       if (bd_var_flcor_.flag[nb.bufid] == BoundaryStatus::waiting) {
         if (nb.snb.rank == Globals::my_rank) {// on the same process
+          RecordReceivePending(bd_var_flcor_, nb);
           bflag = false;
           continue;
         }
@@ -181,6 +187,7 @@ bool CellCenteredBoundaryVariable::ReceiveFluxCorrection() {
                      MPI_STATUS_IGNORE);
           MPI_Test(&(bd_var_flcor_.req_recv[nb.bufid]), &test, MPI_STATUS_IGNORE);
           if (!static_cast<bool>(test)) {
+            RecordReceivePending(bd_var_flcor_, nb);
             bflag = false;
             continue;
           }
@@ -188,6 +195,7 @@ bool CellCenteredBoundaryVariable::ReceiveFluxCorrection() {
         }
 #endif
       }
+      RecordReceiveArrived(bd_var_flcor_, nb, CommStats::Channel::flux_correction);
       // boundary arrived; apply flux correction
       int p = 0;
       Real *rbuf=bd_var_flcor_.recv[nb.bufid];
@@ -36,6 +36,7 @@
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
 #include "utils/buffer_utils.hpp"
+#include "utils/timers.hpp"
 #include "bvals_fc.hpp"
 
 // MPI header
@@ -1000,6 +1001,7 @@ void FaceCenteredBoundaryVariable::ClearBoundary(BoundaryCommSubset phase) {
     MeshBlock *pmb = pmy_block_;
     int mylevel = pmb->loc.level;
     if (nb.snb.rank != Globals::my_rank && phase != BoundaryCommSubset::gr_amr) {
+      Timers::ScopedRegion region("MPI_Wait");
       // Wait for Isend
       MPI_Wait(&(bd_var_.req_send[nb.bufid]), MPI_STATUS_IGNORE);
 
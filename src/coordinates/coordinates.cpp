@@ -21,6 +21,7 @@
 
 // C++ headers
 #include <algorithm>
+#include <memory>
 
 // Athena++ headers
 #include "bvals/bvals.hpp"
@@ -49,6 +50,9 @@ Coordinates::Coordinates(MeshBlock *pmb, ParameterInput *pin, bool flag) :
     ng = NGHOST;
     nc1 = pmy_block->ncells1, nc2 = pmy_block->ncells2, nc3 = pmy_block->ncells3;
   }
+  uniform_spacing_ = pm->use_uniform_meshgen_fn_[X1DIR]
+                     && (nc2 == 1 || pm->use_uniform_meshgen_fn_[X2DIR])
+                     && (nc3 == 1 || pm->use_uniform_meshgen_fn_[X3DIR]);
 
   // allocate arrays for volume-centered coordinates and positions of cells
   dx1v.NewAthenaArray(nc1);
@@ -531,6 +535,56 @@ Real Coordinates::GetCellVolume(const int k, const int j, const int i) {
   return dx1f(i)*dx2f(j)*dx3f(k);
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn const CachedMetric &Coordinates::GetCachedMetric()
+//  \brief returns the per-cell areas and volumes of this block, building them on the
+//  first call.  Not thread-safe on that first call.
+
+const CachedMetric &Coordinates::GetCachedMetric() {
+  if (cached_metric_ == nullptr) cached_metric_ = std::make_unique<CachedMetric>(*this);
+  return *cached_metric_;
+}
+
+//----------------------------------------------------------------------------------------
+// CachedMetric constructor: evaluates face areas and cell volumes over the whole block,
+// including ghost cells.  Face arrays in x2 and x3 are only filled in 2D and 3D.
+
+CachedMetric::CachedMetric(Coordinates &coord) {
+  const int nc1 = coord.dx1f.GetDim1();
+  const int nc2 = coord.dx2f.GetDim1();
+  const int nc3 = coord.dx3f.GetDim1();
+  AthenaArray<Real> row(nc1+1);
+
+  area1_.NewAthenaArray(nc3, nc2, nc1+1);
+  vol_.NewAthenaArray(nc3, nc2, nc1);
+  for (int k=0; k<nc3; ++k) {
+    for (int j=0; j<nc2; ++j) {
+      coord.Face1Area(k, j, 0, nc1, row);
+      for (int i=0; i<=nc1; ++i) area1_(k,j,i) = row(i);
+      coord.CellVolume(k, j, 0, nc1-1, row);
+      for (int i=0; i<nc1; ++i) vol_(k,j,i) = row(i);
+    }
+  }
+  if (nc2 > 1) {
+    area2_.NewAthenaArray(nc3, nc2+1, nc1);
+    for (int k=0; k<nc3; ++k) {
+      for (int j=0; j<=nc2; ++j) {
+        coord.Face2Area(k, j, 0, nc1-1, row);
+        for (int i=0; i<nc1; ++i) area2_(k,j,i) = row(i);
+      }
+    }
+  }
+  if (nc3 > 1) {
+    area3_.NewAthenaArray(nc3+1, nc2, nc1);
+    for (int k=0; k<=nc3; ++k) {
+      for (int j=0; j<nc2; ++j) {
+        coord.Face3Area(k, j, 0, nc1-1, row);
+        for (int i=0; i<nc1; ++i) area3_(k,j,i) = row(i);
+      }
+    }
+  }
+}
+
 //-------------------------------------------------------------------------------------
 // Laplacian: calculate total Laplacian of 4D scalar array s() to second order accuracy
 // may need to replace dx*f with dx*v for nonuniform coordinates for some applications
@@ -26,6 +26,7 @@
 
 // C++ headers
 #include <iostream>
+#include <memory>
 
 // Athena++ headers
 #include "athena.hpp"
@@ -36,6 +37,26 @@ namespace parthenon {
 class Mesh;
 class MeshBlock;
 class ParameterInput;
+class Coordinates;
+
+//----------------------------------------------------------------------------------------
+//! \class CachedMetric
+//  \brief face areas and cell volumes of a block in any geometry, evaluated once through
+//  the virtual Coordinates functions and stored per cell.  Together with
+//  UniformCartesianMetric this is a geometry policy for kernels templated on it.
+
+class CachedMetric {
+ public:
+  explicit CachedMetric(Coordinates &coord);
+
+  Real Face1Area(const int k, const int j, const int i) const {return area1_(k,j,i);}
+  Real Face2Area(const int k, const int j, const int i) const {return area2_(k,j,i);}
+  Real Face3Area(const int k, const int j, const int i) const {return area3_(k,j,i);}
+  Real CellVolume(const int k, const int j, const int i) const {return vol_(k,j,i);}
+
+ private:
+  AthenaArray<Real> area1_, area2_, area3_, vol_;
+};
 
 //----------------------------------------------------------------------------------------
 //! \class Coordinates
@@ -131,6 +152,10 @@ class Coordinates {
                           AthenaArray<Real> &vol);
   virtual Real GetCellVolume(const int k, const int j, const int i);
 
+  // ...to select a geometry policy for kernels templated on it
+  virtual bool IsUniformCartesian() const {return false;}
+  const CachedMetric &GetCachedMetric();
+
   // ...to compute geometrical source terms
   virtual void AddCoordTermsDivergence(const Real dt, const AthenaArray<Real> *flux,
                              const AthenaArray<Real> &prim, const AthenaArray<Real> &bcc,
@@ -192,6 +217,8 @@ class Coordinates {
  protected:
   bool coarse_flag;  // true if this coordinate object is parent (coarse) mesh in AMR
   Mesh *pm;
+  bool uniform_spacing_;  // true if dx1f, dx2f, dx3f are each constant on the block
+  std::unique_ptr<CachedMetric> cached_metric_;  // built on first GetCachedMetric()
   int il, iu, jl, ju, kl, ku, ng;  // limits of indices of arrays (normal or coarse)
   int nc1, nc2, nc3;               // # cells in each dir of arrays (normal or coarse)
   // Scratch arrays for coordinate factors
@@ -292,6 +319,28 @@ class Cartesian : public Coordinates {
 
  public:
   Cartesian(MeshBlock *pmb, ParameterInput *pin, bool flag);
+  bool IsUniformCartesian() const override {return uniform_spacing_;}
+};
+
+//----------------------------------------------------------------------------------------
+//! \class UniformCartesianMetric
+//  \brief face areas and cell volumes of a Cartesian block with uniform spacing, which
+//  are block-level constants.  Only valid if coord.IsUniformCartesian() is true.
+
+class UniformCartesianMetric {
+ public:
+  explicit UniformCartesianMetric(const Coordinates &coord) :
+      area1_(coord.dx2f(0)*coord.dx3f(0)), area2_(coord.dx1f(0)*coord.dx3f(0)),
+      area3_(coord.dx1f(0)*coord.dx2f(0)),
+      vol_(coord.dx1f(0)*coord.dx2f(0)*coord.dx3f(0)) {}
+
+  Real Face1Area(const int k, const int j, const int i) const {return area1_;}
+  Real Face2Area(const int k, const int j, const int i) const {return area2_;}
+  Real Face3Area(const int k, const int j, const int i) const {return area3_;}
+  Real CellVolume(const int k, const int j, const int i) const {return vol_;}
+
+ private:
+  const Real area1_, area2_, area3_, vol_;
 };
 }
 #endif // COORDINATES_COORDINATES_HPP_
@@ -17,6 +17,9 @@
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
 #include "outputs/outputs.hpp"
+#include "utils/comm_stats.hpp"
+#include "utils/memory_usage.hpp"
+#include "utils/timers.hpp"
 
 namespace parthenon {
 
@@ -28,7 +31,10 @@ DriverStatus EvolutionDriver::Execute() {
     if (Globals::my_rank == 0)
       pmesh->OutputCycleDiagnostics();
 
-    Step();
+    {
+      Timers::ScopedRegion region("Step");
+      Step();
+    }
     //pmesh->UserWorkInLoop();
 
     pmesh->ncycle++;
@@ -36,14 +42,25 @@ DriverStatus EvolutionDriver::Execute() {
     pmesh->mbcnt += pmesh->nbtotal;
     pmesh->step_since_lb++;
 
-    pmesh->LoadBalancingAndAdaptiveMeshRefinement(pinput);
+    {
+      Timers::ScopedRegion region("LoadBalancingAndAMR");
+      const int nchanged = pmesh->nbnew + pmesh->nbdel;
+      pmesh->LoadBalancingAndAdaptiveMeshRefinement(pinput);
+      if (pmesh->nbnew + pmesh->nbdel != nchanged)
+        MemoryUsage::Report(pmesh, "after AMR in cycle " + std::to_string(pmesh->ncycle));
+    }
 
-    pmesh->NewTimeStep();
+    {
+      Timers::ScopedRegion region("NewTimeStep");
+      pmesh->NewTimeStep();
+    }
 #ifdef ENABLE_EXCEPTIONS
     try {
 #endif
-      if (pmesh->time < pmesh->tlim) // skip the final output as it happens later
+      if (pmesh->time < pmesh->tlim) { // skip the final output as it happens later
+        Timers::ScopedRegion region("Outputs");
         pouts->MakeOutputs(pmesh,pinput);
+      }
 #ifdef ENABLE_EXCEPTIONS
     }
     catch(std::bad_alloc& ba) {
@@ -63,6 +80,9 @@ DriverStatus EvolutionDriver::Execute() {
     }
 #endif // ENABLE_EXCEPTIONS
 
+    Timers::ReportIfDue(pmesh->ncycle);
+    CommStats::ReportIfDue(pmesh->ncycle);
+
     // check for signals
     if (SignalHandler::CheckSignalFlags() != 0) {
       break;
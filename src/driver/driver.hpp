@@ -20,6 +20,7 @@
 #include "athena.hpp"
 #include "task_list/tasks.hpp"
 #include "mesh/mesh.hpp"
+#include "utils/timers.hpp"
 
 namespace parthenon {
 
@@ -54,6 +55,7 @@ class EvolutionDriver : public Driver {
 namespace DriverUtils {
   template <typename T, class...Args>
   TaskListStatus ConstructAndExecuteBlockTasks(T* driver, Args... args) {
+    Timers::ScopedRegion region("BlockTasks");
     int nthreads = driver->pmesh->GetNumMeshThreads();
     int nmb = driver->pmesh->GetNumMeshBlocksThisRank(Globals::my_rank);
     std::vector<TaskList> task_lists;
@@ -62,14 +64,18 @@ namespace DriverUtils {
     MeshBlock *pmb = driver->pmesh->pblock;
     while (pmb != nullptr) {
       task_lists[i] = driver->MakeTaskList(pmb, std::forward<Args>(args)...);
+      task_lists[i].SetBlockID(pmb->gid);
       i++;
       pmb = pmb->next;
     }
+    // threads other than this one nest their task timers under the current region
+    const std::vector<std::string> timer_path = Timers::CurrentPath();
     int complete_cnt = 0;
     while (complete_cnt != nmb) {
 #pragma omp parallel for reduction(+ : complete_cnt) num_threads(nthreads) schedule(dynamic,1)
       for (auto i = 0; i < nmb; ++i) {
         if (!task_lists[i].IsComplete()) {
+          Timers::ScopedPath path(timer_path);
           auto status = task_lists[i].DoAvailable();
           if (status == TaskListStatus::complete) {
             complete_cnt++;
@@ -357,6 +357,11 @@ class Container {
     stages["base"] = baseStage;
   }
 
+  /// All stages by name, e.g. for memory accounting
+  const std::map<std::string, std::shared_ptr<Stage<T>>>& AllStages() const {
+    return stages;
+  }
+
   void StagePrint() {
     for (auto & st : stages) {
       std::cout << "Stage " << st.first << std::endl;
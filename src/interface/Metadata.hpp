@@ -236,8 +236,11 @@ class Metadata {
     });
   }
 
-  /// returns true if bit is set, false otherwise
-  bool IsSet(const MetadataFlag bit) const { return bits_[bit.flag_]; }
+  /// returns true if bit is set, false otherwise; bits_ only extends to the highest
+  /// flag that was ever set
+  bool IsSet(const MetadataFlag bit) const {
+    return static_cast<std::size_t>(bit.flag_) < bits_.size() && bits_[bit.flag_];
+  }
 
   // Operators
   bool operator==(const Metadata &b) const {
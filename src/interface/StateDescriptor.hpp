@@ -25,6 +25,17 @@
 namespace parthenon {
 enum class DerivedOwnership {shared, unique};
 
+/// A history output column: one component of a field reduced over the interior cells
+/// of all blocks.  Volume-weighted sums add value*cell volume; min and max ignore the
+/// weighting.
+struct HistoryQuantity {
+  std::string name;
+  std::string field;
+  int component;
+  UserHistoryOperation op;
+  bool volume_weighted;
+};
+
 ///
 /// The state metadata descriptor class.
 ///
@@ -95,6 +106,22 @@ class StateDescriptor {
     // get all metadata for this physics
     const std::map<std::string, Metadata>& AllMetadata() { return _metadataMap; }
 
+    // history output routines
+    // add a history column reducing one component of field_name with op
+    void AddHistory(const std::string& name, const std::string& field_name,
+                    UserHistoryOperation op = UserHistoryOperation::sum,
+                    bool volume_weighted = true, int component = 0) {
+      for (auto& h : _history) {
+        if (h.name == name) {
+          throw std::invalid_argument("History quantity " + name + " already exists");
+        }
+      }
+      _history.push_back({name, field_name, component, op, volume_weighted});
+    }
+
+    // history columns in the order they were added
+    const std::vector<HistoryQuantity>& AllHistory() { return _history; }
+
     std::vector<std::shared_ptr<AMRCriteria>> amr_criteria;
     void (*FillDerived)(Container<Real>& rc);
     Real (*EstimateTimestep)(Container<Real>& rc);
@@ -105,6 +132,7 @@ class StateDescriptor {
     Params _params;
     const std::string _label;
     std::map<std::string, Metadata> _metadataMap;
+    std::vector<HistoryQuantity> _history;
 };
 
 using Packages_t = std::map<std::string, std::shared_ptr<StateDescriptor>>;
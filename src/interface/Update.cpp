@@ -20,6 +20,49 @@
 namespace parthenon {
 namespace Update {
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void FluxDivergence(const Metric &metric, ...)
+//  \brief computes dudt = -div(F) on the interior of a block.  Metric is a geometry
+//  policy (UniformCartesianMetric or CachedMetric) so the face areas and volumes are
+//  resolved at compile time instead of through virtual calls per row.
+
+template <typename Metric>
+void FluxDivergence(const Metric &metric, ContainerIterator<Real> &cin_iter,
+                    ContainerIterator<Real> &cout_iter, const int ndim,
+                    const int is, const int ie, const int js, const int je,
+                    const int ks, const int ke) {
+  const int nvars = cout_iter.vars.size();
+  for (int n = 0; n < nvars; n++) {
+    Variable<Real> &q = *cin_iter.vars[n];
+    AthenaArray<Real> &x1flux = q.flux[0];
+    AthenaArray<Real> &x2flux = q.flux[1];
+    AthenaArray<Real> &x3flux = q.flux[2];
+    Variable<Real> &dudt = *cout_iter.vars[n];
+    for (int l = 0; l < q.GetDim4(); l++) {
+      for (int k = ks; k <= ke; k++) {
+        for (int j = js; j <= je; j++) {
+#pragma omp simd
+          for (int i = is; i <= ie; i++) {
+            Real du = (metric.Face1Area(k, j, i + 1) * x1flux(l, k, j, i + 1) -
+                       metric.Face1Area(k, j, i) * x1flux(l, k, j, i));
+            if (ndim >= 2) {
+              du += (metric.Face2Area(k, j + 1, i) * x2flux(l, k, j + 1, i) -
+                     metric.Face2Area(k, j, i) * x2flux(l, k, j, i));
+            }
+            if (ndim >= 3) {
+              du += (metric.Face3Area(k + 1, j, i) * x3flux(l, k + 1, j, i) -
+                     metric.Face3Area(k, j, i) * x3flux(l, k, j, i));
+            }
+            dudt(l, k, j, i) = -du / metric.CellVolume(k, j, i);
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
 void FluxDivergence(Container<Real> &in, Container<Real> &dudt_cont) {
   MeshBlock *pmb = in.pmy_block;
   int is = pmb->is;
@@ -29,69 +72,18 @@ void FluxDivergence(Container<Real> &in, Container<Real> &dudt_cont) {
   int je = pmb->je;
   int ke = pmb->ke;
 
-  Metadata m;
   ContainerIterator<Real> cin_iter(in, {Metadata::Independent});
   ContainerIterator<Real> cout_iter(dudt_cont, {Metadata::Independent});
-  int nvars = cout_iter.vars.size();
-
-  AthenaArray<Real> x1area(pmb->ncells1);
-  AthenaArray<Real> x2area0(pmb->ncells1);
-  AthenaArray<Real> x2area1(pmb->ncells1);
-  AthenaArray<Real> x3area0(pmb->ncells1);
-  AthenaArray<Real> x3area1(pmb->ncells1);
-  AthenaArray<Real> vol(pmb->ncells1);
-
-  /*for (int n = 0; n < nvars; n++) {
-    Variable<Real>& dudt = *cout_iter.vars[n];
-    dudt.ZeroClear();
-  }*/
   int ndim = pmb->pmy_mesh->ndim;
-  AthenaArray<Real> du(pmb->ncells1);
-  for (int k = ks; k <= ke; k++) {
-    for (int j = js; j <= je; j++) {
-      pmb->pcoord->Face1Area(k, j, is, ie + 1, x1area);
-      pmb->pcoord->CellVolume(k, j, is, ie, vol);
-      if (pmb->pmy_mesh->ndim >= 2) {
-        pmb->pcoord->Face2Area(k, j, is, ie, x2area0);
-        pmb->pcoord->Face2Area(k, j + 1, is, ie, x2area1);
-      }
-      if (pmb->pmy_mesh->ndim >= 3) {
-        pmb->pcoord->Face3Area(k, j, is, ie, x3area0);
-        pmb->pcoord->Face3Area(k + 1, j, is, ie, x3area1);
-      }
-      for (int n = 0; n < nvars; n++) {
-        Variable<Real> &q = *cin_iter.vars[n];
-        AthenaArray<Real> &x1flux = q.flux[0];
-        AthenaArray<Real> &x2flux = q.flux[1];
-        AthenaArray<Real> &x3flux = q.flux[2];
-        Variable<Real> &dudt = *cout_iter.vars[n];
-        for (int l = 0; l < q.GetDim4(); l++) {
-          du.ZeroClear();
-          for (int i = is; i <= ie; i++) {
-            du(i) = (x1area(i + 1) * x1flux(l, k, j, i + 1) -
-                     x1area(i) * x1flux(l, k, j, i));
-          }
 
-          if (pmb->pmy_mesh->ndim >= 2) {
-            for (int i = is; i <= ie; i++) {
-              du(i) += (x2area1(i) * x2flux(l, k, j + 1, i) -
-                        x2area0(i) * x2flux(l, k, j, i));
-            }
-          }
-          // TODO(jcd): should the next block be in the preceding if??
-          if (pmb->pmy_mesh->ndim >= 3) {
-            for (int i = is; i <= ie; i++) {
-              du(i) += (x3area1(i) * x3flux(l, k + 1, j, i) -
-                        x3area0(i) * x3flux(l, k, j, i));
-            }
-          }
-
-          for (int i = is; i <= ie; i++) {
-            dudt(l, k, j, i) = -du(i) / vol(i);
-          }
-        }
-      }
-    }
+  // pick the geometry once per block; the kernel itself has no virtual calls
+  Coordinates *pco = pmb->pcoord.get();
+  if (pco->IsUniformCartesian()) {
+    FluxDivergence(UniformCartesianMetric(*pco), cin_iter, cout_iter, ndim,
+                   is, ie, js, je, ks, ke);
+  } else {
+    FluxDivergence(pco->GetCachedMetric(), cin_iter, cout_iter, ndim,
+                   is, ie, js, je, ks, ke);
   }
 
   return;
@@ -20,11 +20,17 @@
 #ifndef KOKKOS_ABSTRACTION_HPP_
 #define KOKKOS_ABSTRACTION_HPP_
 
+#include <array> // array
+#include <chrono> // steady_clock
 #include <string> // string
+#include <utility> // forward
 
 // Kokkos headers
 #include <Kokkos_Core.hpp>
 
+#include "utils/loop_tuning.hpp"
+#include "utils/timers.hpp"
+
 namespace parthenon {
 
 #ifdef KOKKOS_ENABLE_CUDA_UVM
@@ -91,10 +97,50 @@ static struct LoopPatternUndefined {
 #define DEFAULT_LOOP_PATTERN loop_pattern_undefined_tag
 #endif
 
+namespace LoopTuning {
+// calls launch(tag) with the tag of "pattern"; undecided runs the compile-time default
+template <typename Launch>
+inline void Dispatch(const Pattern pattern, const Launch &launch) {
+  switch (pattern) {
+    case Pattern::flatrange: launch(loop_pattern_flatrange_tag); break;
+#ifndef KOKKOS_ENABLE_CUDA
+    case Pattern::simdfor: launch(loop_pattern_simdfor_tag); break;
+    case Pattern::tptvr: launch(loop_pattern_tptvr_tag); break;
+#endif
+    case Pattern::mdrange: launch(loop_pattern_mdrange_tag); break;
+    case Pattern::tpttr: launch(loop_pattern_tpttr_tag); break;
+    case Pattern::tpttrtvr: launch(loop_pattern_tpttrtvr_tag); break;
+    default: launch(DEFAULT_LOOP_PATTERN); break;
+  }
+}
+
+// runs "launch" with the pattern chosen for kernel "name", timing it while tuning;
+// every par_for call site has its own Launch type and therefore its own CallSite
+template <typename Launch>
+inline void TunedLaunch(const std::string &name, const std::array<int, 4> &extents,
+                        const Launch &launch) {
+  thread_local CallSite site;
+  Kernel &kernel = site.Get(name, extents);
+  bool timed;
+  const Pattern pattern = kernel.Next(&timed);
+  if (!timed) {
+    Dispatch(pattern, launch);
+    return;
+  }
+  Kokkos::fence();
+  const auto start = std::chrono::steady_clock::now();
+  Dispatch(pattern, launch);
+  Kokkos::fence();
+  kernel.Report(pattern, std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start).count());
+}
+} // namespace LoopTuning
+
 // 1D default loop pattern
 template <typename Function>
 inline void par_for(const std::string &name, DevSpace exec_space, const int &il,
                     const int &iu, const Function &function) {
+  Timers::ScopedRegion region(name);
   // using loop_pattern_mdrange_tag instead of DEFAULT_LOOP_PATTERN for now
   // as the other wrappers are not implemented yet for 1D loops
   par_for(loop_pattern_mdrange_tag, name, exec_space, il, iu, function);
@@ -105,6 +151,7 @@ template <typename Function>
 inline void par_for(const std::string &name, DevSpace exec_space, const int &jl,
                     const int &ju, const int &il, const int &iu,
                     const Function &function) {
+  Timers::ScopedRegion region(name);
   // using loop_pattern_mdrange_tag instead of DEFAULT_LOOP_PATTERN for now
   // as the other wrappers are not implemented yet for 2D loops
   par_for(loop_pattern_mdrange_tag, name, exec_space, jl, ju, il, iu, function);
@@ -115,6 +162,14 @@ template <typename Function>
 inline void par_for(const std::string &name, DevSpace exec_space, const int &kl,
                     const int &ku, const int &jl, const int &ju, const int &il,
                     const int &iu, const Function &function) {
+  Timers::ScopedRegion region(name);
+  if (LoopTuning::enabled) {
+    LoopTuning::TunedLaunch(name, {1, ku - kl + 1, ju - jl + 1, iu - il + 1},
+                            [&](auto tag) {
+      par_for(tag, name, exec_space, kl, ku, jl, ju, il, iu, function);
+    });
+    return;
+  }
   par_for(DEFAULT_LOOP_PATTERN, name, exec_space, kl, ku, jl, ju, il, iu,
           function);
 }
@@ -125,6 +180,14 @@ inline void par_for(const std::string &name, DevSpace exec_space, const int &nl,
                     const int &nu, const int &kl, const int &ku, const int &jl,
                     const int &ju, const int &il, const int &iu,
                     const Function &function) {
+  Timers::ScopedRegion region(name);
+  if (LoopTuning::enabled) {
+    LoopTuning::TunedLaunch(name, {nu - nl + 1, ku - kl + 1, ju - jl + 1, iu - il + 1},
+                            [&](auto tag) {
+      par_for(tag, name, exec_space, nl, nu, kl, ku, jl, ju, il, iu, function);
+    });
+    return;
+  }
   par_for(DEFAULT_LOOP_PATTERN, name, exec_space, nl, nu, kl, ku, jl, ju, il,
           iu, function);
 }
@@ -403,6 +466,44 @@ inline void par_for(LoopPatternSimdFor, const std::string &name,
   Kokkos::Profiling::popRegion();
 }
 
+// 3D loop over pencils using MDRange loops: function(n, k, j) handles the whole i
+// range of one pencil itself so that it can vectorize it.  As for par_reduce below, the
+// execution space is a template parameter so that host-resident data can be used.
+template <typename ExecSpace, typename Function>
+inline void par_for_pencils(const std::string &name, ExecSpace exec_space,
+                            const int nl, const int nu, const int kl, const int ku,
+                            const int jl, const int ju, const Function &function) {
+  Kokkos::parallel_for(
+      name,
+      Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<3>>(exec_space, {nl, kl, jl},
+                                                        {nu + 1, ku + 1, ju + 1}),
+      function);
+}
+
+// 1D reduction using a Kokkos 1D Range
+// The execution space is a template parameter so that arrays living in host memory
+// (e.g., AthenaArrays) can be reduced in Kokkos::DefaultHostExecutionSpace.
+template <typename ExecSpace, typename Function, typename Reduction>
+inline void par_reduce(const std::string &name, ExecSpace exec_space, const int &il,
+                       const int &iu, const Function &function,
+                       Reduction &&reduction) {
+  Kokkos::parallel_reduce(name, Kokkos::RangePolicy<ExecSpace>(exec_space, il, iu + 1),
+                          function, std::forward<Reduction>(reduction));
+}
+
+// 3D reduction using MDRange loops
+template <typename ExecSpace, typename Function, typename Reduction>
+inline void par_reduce(const std::string &name, ExecSpace exec_space, const int &kl,
+                       const int &ku, const int &jl, const int &ju, const int &il,
+                       const int &iu, const Function &function,
+                       Reduction &&reduction) {
+  Kokkos::parallel_reduce(
+      name,
+      Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<3>>(exec_space, {kl, jl, il},
+                                                        {ku + 1, ju + 1, iu + 1}),
+      function, std::forward<Reduction>(reduction));
+}
+
 // reused from kokoks/core/perf_test/PerfTest_ExecSpacePartitioning.cpp
 // commit a0d011fb30022362c61b3bb000ae3de6906cb6a7
 template <class ExecSpace> struct SpaceInstance {
@@ -20,16 +20,19 @@
 // C headers
 
 // C++ headers
-#include <algorithm>  // std::sort()
+#include <algorithm>  // std::sort(), std::upper_bound()
 #include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
 #include "athena_arrays.hpp"
 #include "globals.hpp"
+#include "utils/comm_stats.hpp"
 #include "utils/buffer_utils.hpp"
+#include "utils/timers.hpp"
 #include "mesh.hpp"
 #include "mesh_refinement.hpp"
 #include "meshblock_tree.hpp"
@@ -43,6 +46,32 @@
 
 
 namespace parthenon {
+namespace {
+#ifdef MPI_PARALLEL
+// MPI_Wait on a single request, timed as a communication wait
+void WaitForRequest(MPI_Request *req, const CommStats::Relation r) {
+  Timers::ScopedRegion region("MPI_Wait");
+  const std::int64_t start = CommStats::enabled ? CommStats::Now() : 0;
+  MPI_Wait(req, MPI_STATUS_IGNORE);
+  if (CommStats::enabled)
+    CommStats::Wait(CommStats::Channel::redistribution, r, false,
+                    CommStats::Now() - start);
+}
+
+// an off-rank block redistribution message of "size" Reals
+void CountSend(const CommStats::Relation r, const int size) {
+  if (CommStats::enabled)
+    CommStats::Send(CommStats::Channel::redistribution, r, false, size*sizeof(Real));
+}
+#endif
+
+// a block redistribution within the rank, "size" Reals copied in memory
+void CountLocalCopy(const CommStats::Relation r, const int size) {
+  if (CommStats::enabled)
+    CommStats::Send(CommStats::Channel::redistribution, r, true, size*sizeof(Real));
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // \!fn void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin)
 // \brief Main function for adaptive mesh refinement
@@ -60,11 +89,14 @@ void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin) {
   UpdateCostList();
 
   if (nnew != 0 || ndel != 0) { // at least one (de)refinement happened
-    GatherCostListAndCheckBalance();
+    mesh_generation++;
+    GatherCostList();
     RedistributeAndRefineMeshBlocks(pin, nbtotal + nnew - ndel);
   } else if (lb_flag_ && step_since_lb >= lb_interval_) {
-    if (!GatherCostListAndCheckBalance()) // load imbalance detected
+    if (!CheckLoadBalance()) { // load imbalance detected
+      GatherCostList();
       RedistributeAndRefineMeshBlocks(pin, nbtotal);
+    }
     lb_flag_ = false;
   }
   return;
@@ -72,12 +104,12 @@ void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin) {
 
 
 //----------------------------------------------------------------------------------------
-// \!fn void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist,
-//                                      int *nlist, int nb)
+// \!fn void Mesh::CalculateLoadBalance(double *clist, int *slist, int *nlist, int nb)
 // \brief Calculate distribution of MeshBlocks based on the cost list
+//  Each rank owns a contiguous range of gids, so the distribution is fully described by
+//  the O(nranks) slist/nlist arrays; use FindRankOfBlock() to recover the owner of a gid.
 
-void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlist,
-                                int nb) {
+void Mesh::CalculateLoadBalance(double *clist, int *slist, int *nlist, int nb) {
   std::stringstream msg;
   double real_max  =  std::numeric_limits<double>::max();
   double totalcost = 0, maxcost = 0.0, mincost = (real_max);
@@ -88,10 +120,12 @@ void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlis
     maxcost = std::max(maxcost,clist[i]);
   }
 
+  for (int j=0; j<Globals::nranks; j++)
+    slist[j] = 0;
   int j = (Globals::nranks) - 1;
   double targetcost = totalcost/Globals::nranks;
   double mycost = 0.0;
-  // create rank list from the end: the master MPI rank should have less load
+  // assign blocks from the end: the master MPI rank should have less load
   for (int i=nb-1; i>=0; i--) {
     if (targetcost == 0.0) {
       msg << "### FATAL ERROR in CalculateLoadBalance" << std::endl
@@ -100,7 +134,7 @@ void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlis
       ATHENA_ERROR(msg);
     }
     mycost += clist[i];
-    rlist[i] = j;
+    slist[j] = i;
     if (mycost >= targetcost && j>0) {
       j--;
       totalcost -= mycost;
@@ -108,15 +142,10 @@ void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlis
       targetcost = totalcost/(j+1);
     }
   }
-  slist[0] = 0;
-  j = 0;
-  for (int i=1; i<nb; i++) { // make the list of nbstart and nblocks
-    if (rlist[i] != rlist[i-1]) {
-      nlist[j] = i-slist[j];
-      slist[++j] = i;
-    }
-  }
-  nlist[j] = nb-slist[j];
+  // make the list of nblocks
+  for (j=0; j<Globals::nranks-1; j++)
+    nlist[j] = slist[j+1]-slist[j];
+  nlist[Globals::nranks-1] = nb-slist[Globals::nranks-1];
 
   if (Globals::my_rank == 0) {
     for (int i=0; i<Globals::nranks; i++) {
@@ -152,6 +181,16 @@ void Mesh::CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlis
   }
 }
 
+//----------------------------------------------------------------------------------------
+// \!fn int Mesh::FindRankOfBlock(int gid, const int *slist)
+// \brief returns the rank owning MeshBlock gid, given the first gid of each rank
+
+int Mesh::FindRankOfBlock(int gid, const int *slist) {
+  // ranks without blocks share their start with the next rank; pick the last of them
+  return static_cast<int>(std::upper_bound(slist, slist + Globals::nranks, gid)
+                          - slist) - 1;
+}
+
 //----------------------------------------------------------------------------------------
 // \!fn void Mesh::ResetLoadBalanceVariables()
 // \brief reset counters and flags for load balancing
@@ -191,7 +230,8 @@ void Mesh::UpdateCostList() {
 
 //----------------------------------------------------------------------------------------
 // \!fn void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel)
-// \brief collect refinement flags and manipulate the MeshBlockTree
+// \brief collect refinement flags and manipulate the MeshBlockTree; every rank
+//  updates its full copy of the tree, see the TODO at Mesh::tree
 
 void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   // compute nleaf= number of leaf MeshBlocks per refined block
@@ -334,25 +374,21 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
 }
 
 //----------------------------------------------------------------------------------------
-// \!fn bool Mesh::GatherCostListAndCheckBalance()
-// \brief collect the cost from MeshBlocks and check the load balance
+// \!fn bool Mesh::CheckLoadBalance()
+// \brief check the load balance using only the per-rank costs (two scalar reductions)
 
-bool Mesh::GatherCostListAndCheckBalance() {
+bool Mesh::CheckLoadBalance() {
   if (lb_manual_ || lb_automatic_) {
+    double rcost = 0.0;
+    int ns = nslist[Globals::my_rank];
+    int ne = ns + nblist[Globals::my_rank];
+    for (int n=ns; n<ne; ++n)
+      rcost += costlist[n];
+    double maxcost = rcost, avecost = rcost;
 #ifdef MPI_PARALLEL
-    MPI_Allgatherv(MPI_IN_PLACE, nblist[Globals::my_rank], MPI_DOUBLE, costlist, nblist,
-                   nslist, MPI_DOUBLE, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &maxcost, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &avecost, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
 #endif
-    double maxcost = 0.0, avecost = 0.0;
-    for (int rank=0; rank<Globals::nranks; rank++) {
-      double rcost = 0.0;
-      int ns = nslist[rank];
-      int ne = ns + nblist[rank];
-      for (int n=ns; n<ne; ++n)
-        rcost += costlist[n];
-      maxcost = std::max(maxcost,rcost);
-      avecost += rcost;
-    }
     avecost /= Globals::nranks;
 
     if (adaptive) lb_tolerance_ = 2.0*static_cast<double>(Globals::nranks)
@@ -364,6 +400,20 @@ bool Mesh::GatherCostListAndCheckBalance() {
   return true;
 }
 
+//----------------------------------------------------------------------------------------
+// \!fn void Mesh::GatherCostList()
+// \brief collect the cost from MeshBlocks; only needed before redistributing
+
+void Mesh::GatherCostList() {
+  if (lb_manual_ || lb_automatic_) {
+#ifdef MPI_PARALLEL
+    MPI_Allgatherv(MPI_IN_PLACE, nblist[Globals::my_rank], MPI_DOUBLE, costlist, nblist,
+                   nslist, MPI_DOUBLE, MPI_COMM_WORLD);
+#endif
+  }
+  return;
+}
+
 
 //----------------------------------------------------------------------------------------
 // \!fn void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot)
@@ -377,7 +427,6 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
 
   // Step 1. construct new lists
   LogicalLocation *newloc = new LogicalLocation[ntot];
-  int *newrank = new int[ntot];
   double *newcost = new double[ntot];
   int *newtoold = new int[ntot];
   int *oldtonew = new int[nbtotal];
@@ -420,8 +469,11 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   int onbs = nslist[Globals::my_rank];
   int onbe = onbs + nblist[Globals::my_rank] - 1;
 #endif
-  // Step 2. Calculate new load balance
-  CalculateLoadBalance(newcost, newrank, nslist, nblist, ntot);
+  // Step 2. Calculate new load balance; keep the old starting gids to find old owners
+  int *onslist = new int[Globals::nranks];
+  std::copy(nslist, nslist + Globals::nranks, onslist);
+  CalculateLoadBalance(newcost, nslist, nblist, ntot);
+  auto oldrank = [onslist](int ogid) { return FindRankOfBlock(ogid, onslist); };
 
   int nbs = nslist[Globals::my_rank];
   int nbe = nbs + nblist[Globals::my_rank] - 1;
@@ -431,17 +483,19 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   int bnx3 = pblock->block_size.nx3;
 
 #ifdef MPI_PARALLEL
+  auto newrank = [this](int ngid) { return FindRankOfBlock(ngid, nslist); };
+
   // Step 3. count the number of the blocks to be sent / received
   int nsend = 0, nrecv = 0;
   for (int n=nbs; n<=nbe; n++) {
     int on = newtoold[n];
     if (loclist[on].level > newloc[n].level) { // f2c
       for (int k=0; k<nleaf; k++) {
-        if (ranklist[on+k] != Globals::my_rank)
+        if (oldrank(on+k) != Globals::my_rank)
           nrecv++;
       }
     } else {
-      if (ranklist[on] != Globals::my_rank)
+      if (oldrank(on) != Globals::my_rank)
         nrecv++;
     }
   }
@@ -449,17 +503,18 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
     int nn = oldtonew[n];
     if (loclist[n].level < newloc[nn].level) { // c2f
       for (int k=0; k<nleaf; k++) {
-        if (newrank[nn+k] != Globals::my_rank)
+        if (newrank(nn+k) != Globals::my_rank)
           nsend++;
       }
     } else {
-      if (newrank[nn] != Globals::my_rank)
+      if (newrank(nn) != Globals::my_rank)
         nsend++;
     }
   }
 
-  // Step 4. calculate buffer sizes
-  Real **sendbuf, **recvbuf;
+#endif
+
+  // Step 4. calculate buffer sizes, which are also the data copied within the rank
   // use the first MeshBlock in the linked list of blocks belonging to this MPI rank as a
   // representative of all MeshBlocks for counting the "load-balancing registered" and
   // "SMR/AMR-enrolled" quantities (loop over MeshBlock::vars_cc_, not MeshRefinement)
@@ -493,7 +548,9 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   // add one more element to buffer size for storing the derefinement counter
   bssame++;
 
-  MPI_Request *req_send, *req_recv;
+#ifdef MPI_PARALLEL
+  Real **sendbuf = nullptr, **recvbuf = nullptr;
+  MPI_Request *req_send = nullptr, *req_recv = nullptr;
   // Step 5. allocate and start receiving buffers
   if (nrecv != 0) {
     recvbuf = new Real*[nrecv];
@@ -505,18 +562,18 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       LogicalLocation &nloc = newloc[n];
       if (oloc.level > nloc.level) { // f2c
         for (int l=0; l<nleaf; l++) {
-          if (ranklist[on+l] == Globals::my_rank) continue;
+          if (oldrank(on+l) == Globals::my_rank) continue;
           LogicalLocation &lloc = loclist[on+l];
           int ox1 = ((lloc.lx1 & 1LL) == 1LL), ox2 = ((lloc.lx2 & 1LL) == 1LL),
               ox3 = ((lloc.lx3 & 1LL) == 1LL);
           recvbuf[rb_idx] = new Real[bsf2c];
           int tag = CreateAMRMPITag(n-nbs, ox1, ox2, ox3);
-          MPI_Irecv(recvbuf[rb_idx], bsf2c, MPI_ATHENA_REAL, ranklist[on+l],
+          MPI_Irecv(recvbuf[rb_idx], bsf2c, MPI_ATHENA_REAL, oldrank(on+l),
                     tag, MPI_COMM_WORLD, &(req_recv[rb_idx]));
           rb_idx++;
         }
       } else { // same level or c2f
-        if (ranklist[on] == Globals::my_rank) continue;
+        if (oldrank(on) == Globals::my_rank) continue;
         int size;
         if (oloc.level == nloc.level) {
           size = bssame;
@@ -525,7 +582,7 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
         }
         recvbuf[rb_idx] = new Real[size];
         int tag = CreateAMRMPITag(n-nbs, 0, 0, 0);
-        MPI_Irecv(recvbuf[rb_idx], size, MPI_ATHENA_REAL, ranklist[on],
+        MPI_Irecv(recvbuf[rb_idx], size, MPI_ATHENA_REAL, oldrank(on),
                   tag, MPI_COMM_WORLD, &(req_recv[rb_idx]));
         rb_idx++;
       }
@@ -542,33 +599,36 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       LogicalLocation &nloc = newloc[nn];
       MeshBlock* pb = FindMeshBlock(n);
       if (nloc.level == oloc.level) { // same level
-        if (newrank[nn] == Globals::my_rank) continue;
+        if (newrank(nn) == Globals::my_rank) continue;
         sendbuf[sb_idx] = new Real[bssame];
         PrepareSendSameLevel(pb, sendbuf[sb_idx]);
-        int tag = CreateAMRMPITag(nn-nslist[newrank[nn]], 0, 0, 0);
-        MPI_Isend(sendbuf[sb_idx], bssame, MPI_ATHENA_REAL, newrank[nn],
+        int tag = CreateAMRMPITag(nn-nslist[newrank(nn)], 0, 0, 0);
+        MPI_Isend(sendbuf[sb_idx], bssame, MPI_ATHENA_REAL, newrank(nn),
                   tag, MPI_COMM_WORLD, &(req_send[sb_idx]));
+        CountSend(CommStats::Relation::same_level, bssame);
         sb_idx++;
       } else if (nloc.level > oloc.level) { // c2f
         // c2f must communicate to multiple leaf blocks (unlike f2c, same2same)
         for (int l=0; l<nleaf; l++) {
-          if (newrank[nn+l] == Globals::my_rank) continue;
+          if (newrank(nn+l) == Globals::my_rank) continue;
           sendbuf[sb_idx] = new Real[bsc2f];
           PrepareSendCoarseToFineAMR(pb, sendbuf[sb_idx], newloc[nn+l]);
-          int tag = CreateAMRMPITag(nn+l-nslist[newrank[nn+l]], 0, 0, 0);
-          MPI_Isend(sendbuf[sb_idx], bsc2f, MPI_ATHENA_REAL, newrank[nn+l],
+          int tag = CreateAMRMPITag(nn+l-nslist[newrank(nn+l)], 0, 0, 0);
+          MPI_Isend(sendbuf[sb_idx], bsc2f, MPI_ATHENA_REAL, newrank(nn+l),
                     tag, MPI_COMM_WORLD, &(req_send[sb_idx]));
+          CountSend(CommStats::Relation::coarse_to_fine, bsc2f);
           sb_idx++;
         } // end loop over nleaf (unique to c2f branch in this step 6)
       } else { // f2c: restrict + pack + send
-        if (newrank[nn] == Globals::my_rank) continue;
+        if (newrank(nn) == Globals::my_rank) continue;
         sendbuf[sb_idx] = new Real[bsf2c];
         PrepareSendFineToCoarseAMR(pb, sendbuf[sb_idx]);
         int ox1 = ((oloc.lx1 & 1LL) == 1LL), ox2 = ((oloc.lx2 & 1LL) == 1LL),
             ox3 = ((oloc.lx3 & 1LL) == 1LL);
-        int tag = CreateAMRMPITag(nn-nslist[newrank[nn]], ox1, ox2, ox3);
-        MPI_Isend(sendbuf[sb_idx], bsf2c, MPI_ATHENA_REAL, newrank[nn],
+        int tag = CreateAMRMPITag(nn-nslist[newrank(nn)], ox1, ox2, ox3);
+        MPI_Isend(sendbuf[sb_idx], bsf2c, MPI_ATHENA_REAL, newrank(nn),
                   tag, MPI_COMM_WORLD, &(req_send[sb_idx]));
+        CountSend(CommStats::Relation::fine_to_coarse, bsf2c);
         sb_idx++;
       }
     }
@@ -582,7 +642,7 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
 
   for (int n=nbs; n<=nbe; n++) {
     int on = newtoold[n];
-    if ((ranklist[on] == Globals::my_rank) && (loclist[on].level == newloc[n].level)) {
+    if ((oldrank(on) == Globals::my_rank) && (loclist[on].level == newloc[n].level)) {
       // on the same MPI rank and same level -> just move it
       MeshBlock* pob = FindMeshBlock(on);
       if (pob->prev == nullptr) {
@@ -603,6 +663,8 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       }
       pmb->gid = n;
       pmb->lid = n - nbs;
+      // the block is relinked, not copied
+      CountLocalCopy(CommStats::Relation::same_level, 0);
     } else {
       // on a different refinement level or MPI rank - create a new block
       BoundaryFlag block_bcs[6];
@@ -621,16 +683,18 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       // fill the conservative variables
       if ((loclist[on].level > newloc[n].level)) { // fine to coarse (f2c)
         for (int ll=0; ll<nleaf; ll++) {
-          if (ranklist[on+ll] != Globals::my_rank) continue;
+          if (oldrank(on+ll) != Globals::my_rank) continue;
           // fine to coarse on the same MPI rank (different AMR level) - restriction
           MeshBlock* pob = FindMeshBlock(on+ll);
           FillSameRankFineToCoarseAMR(pob, pmb, loclist[on+ll]);
+          CountLocalCopy(CommStats::Relation::fine_to_coarse, bsf2c);
         }
       } else if ((loclist[on].level < newloc[n].level) && // coarse to fine (c2f)
-                 (ranklist[on] == Globals::my_rank)) {
+                 (oldrank(on) == Globals::my_rank)) {
         // coarse to fine on the same MPI rank (different AMR level) - prolongation
         MeshBlock* pob = FindMeshBlock(on);
         FillSameRankCoarseToFineAMR(pob, pmb, newloc[n]);
+        CountLocalCopy(CommStats::Relation::coarse_to_fine, bsc2f);
       }
       ApplyBoundaryConditions(pmb->real_container);
       FillDerivedVariables::FillDerived(pmb->real_container);
@@ -659,20 +723,20 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       LogicalLocation &nloc = newloc[n];
       MeshBlock *pb = FindMeshBlock(n);
       if (oloc.level == nloc.level) { // same
-        if (ranklist[on] == Globals::my_rank) continue;
-        MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
+        if (oldrank(on) == Globals::my_rank) continue;
+        WaitForRequest(&(req_recv[rb_idx]), CommStats::Relation::same_level);
         FinishRecvSameLevel(pb, recvbuf[rb_idx]);
         rb_idx++;
       } else if (oloc.level > nloc.level) { // f2c
         for (int l=0; l<nleaf; l++) {
-          if (ranklist[on+l] == Globals::my_rank) continue;
-          MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
+          if (oldrank(on+l) == Globals::my_rank) continue;
+          WaitForRequest(&(req_recv[rb_idx]), CommStats::Relation::fine_to_coarse);
           FinishRecvFineToCoarseAMR(pb, recvbuf[rb_idx], loclist[on+l]);
           rb_idx++;
         }
       } else { // c2f
-        if (ranklist[on] == Globals::my_rank) continue;
-        MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
+        if (oldrank(on) == Globals::my_rank) continue;
+        WaitForRequest(&(req_recv[rb_idx]), CommStats::Relation::coarse_to_fine);
         FinishRecvCoarseToFineAMR(pb, recvbuf[rb_idx]);
         rb_idx++;
       }
@@ -682,13 +746,16 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
 
   // deallocate arrays
   delete [] loclist;
-  delete [] ranklist;
+  delete [] onslist;
   delete [] costlist;
   delete [] newtoold;
   delete [] oldtonew;
 #ifdef MPI_PARALLEL
   if (nsend != 0) {
-    MPI_Waitall(nsend, req_send, MPI_STATUSES_IGNORE);
+    {
+      Timers::ScopedRegion region("MPI_Wait");
+      MPI_Waitall(nsend, req_send, MPI_STATUSES_IGNORE);
+    }
     for (int n=0; n<nsend; n++)
       delete [] sendbuf[n];
     delete [] sendbuf;
@@ -704,15 +771,21 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
 
   // update the lists
   loclist = newloc;
-  ranklist = newrank;
   costlist = newcost;
 
-  // re-initialize the MeshBlocks
+  // re-initialize the MeshBlocks; the neighbor searches are independent lookups in the
+  // hashed tree index
+  tree.BuildLocationIndex();
+  std::vector<MeshBlock*> pmb_array(nblist[Globals::my_rank]);
   pmb = pblock;
-  while (pmb != nullptr) {
-    pmb->pbval->SearchAndSetNeighbors(tree, ranklist, nslist);
+  for (MeshBlock *&pb : pmb_array) {
+    pb = pmb;
     pmb = pmb->next;
   }
+  const int nmb = pmb_array.size();
+#pragma omp parallel for num_threads(num_mesh_threads_)
+  for (int i=0; i<nmb; ++i)
+    pmb_array[i]->pbval->SearchAndSetNeighbors(tree, nslist);
   Initialize(2, pin);
 
   ResetLoadBalanceVariables();
@@ -25,7 +25,7 @@
 
 // C++ headers
 #include <algorithm>
-#include <cinttypes>  // format macro "PRId64" for fixed-width integer type std::int64_t
+#include <chrono>
 #include <cmath>      // std::abs(), std::pow()
 #include <cstdint>    // std::int64_t fixed-wdith integer type alias
 #include <cstdlib>
@@ -59,6 +59,31 @@
 #endif
 
 namespace parthenon {
+namespace {
+// wall-clock time in seconds, used for the startup timing breakdown
+double WallTime() {
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// layout of mesh_structure.bin, written by Mesh::OutputMeshStructure(): the header,
+// followed by one record per MeshBlock in gid order, all in native byte order
+struct MeshStructureHeader {
+  char magic[8];                // "PMESH001"
+  std::int32_t ndim, root_level, nranks, record_size;
+  std::int64_t nbtotal;
+};
+
+struct MeshStructureRecord {
+  std::int64_t gid, lx1, lx2, lx3;
+  std::int32_t level, rank;
+  double cost;
+  double xmin[3], xmax[3];
+};
+static_assert(sizeof(MeshStructureHeader) == 32 && sizeof(MeshStructureRecord) == 96,
+              "mesh_structure.bin records must not contain padding");
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // Mesh constructor, builds mesh at start of calculation using parameters in input file
 
@@ -91,7 +116,7 @@ Mesh::Mesh(ParameterInput *pin,
   nlim(pin->GetOrAddInteger("time", "nlim", -1)), ncycle(),
   ncycle_out(pin->GetOrAddInteger("time", "ncycle_out", 1)),
   dt_diagnostics(pin->GetOrAddInteger("time", "dt_diagnostics", -1)),
-  nbnew(), nbdel(),
+  nbnew(), nbdel(), mesh_generation(),
   step_since_lb(), gflag(),
   properties(properties),
   packages(packages),
@@ -100,15 +125,14 @@ Mesh::Mesh(ParameterInput *pin,
   tree(this),
   use_uniform_meshgen_fn_{true, true, true},
   nreal_user_mesh_data_(), nint_user_mesh_data_(), nuser_history_output_(),
-  lb_flag_(true), lb_automatic_(), lb_manual_(),
+  startup_time_{}, lb_flag_(true), lb_automatic_(), lb_manual_(),
   MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
         UniformMeshGeneratorX3},
   BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
   AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, FieldDiffusivity_{}, pblock(nullptr) {
     std::stringstream msg;
+    double tstart = WallTime();
     RegionSize block_size;
-    MeshBlock *pfirst{};
-    BoundaryFlag block_bcs[6];
     std::int64_t nbmax;
 
     // mesh test
@@ -444,7 +468,6 @@ Mesh::Mesh(ParameterInput *pin,
   }
 #endif
 
-  ranklist = new int[nbtotal];
   nslist = new int[Globals::nranks];
   nblist = new int[Globals::nranks];
   costlist = new double[nbtotal];
@@ -462,38 +485,41 @@ Mesh::Mesh(ParameterInput *pin,
   // initialize cost array with the simplest estimate; all the blocks are equal
   for (int i=0; i<nbtotal; i++) costlist[i] = 1.0;
 
-  CalculateLoadBalance(costlist, ranklist, nslist, nblist, nbtotal);
+  CalculateLoadBalance(costlist, nslist, nblist, nbtotal);
 
   // Output some diagnostic information to terminal
 
   // Output MeshBlock list and quit (mesh test only); do not create meshes
   if (mesh_test > 0) {
-    if (Globals::my_rank == 0) OutputMeshStructure(ndim);
+    if (Globals::my_rank == 0) OutputMeshStructure(ndim, true);
     return;
   }
+  if (pin->GetOrAddBoolean("mesh", "write_structure", false))
+    OutputMeshStructure(ndim, false);
 
   // create MeshBlock list for this process
   int nbs = nslist[Globals::my_rank];
   int nbe = nbs + nblist[Globals::my_rank] - 1;
-  // create MeshBlock list for this process
-  for (int i=nbs; i<=nbe; i++) {
-    SetBlockSizeAndBoundaries(loclist[i], block_size, block_bcs);
-    // create a block and add into the link list
-    if (i == nbs) {
-      pblock = new MeshBlock(i, i-nbs, loclist[i], block_size,
-                             block_bcs, this, pin, properties,
-                             packages, gflag);
-      pfirst = pblock;
-    } else {
-      pblock->next = new MeshBlock(i, i-nbs, loclist[i], block_size,
-                                   block_bcs, this, pin, properties,
-                                   packages, gflag);
-      pblock->next->prev = pblock;
-      pblock = pblock->next;
-    }
-    pblock->pbval->SearchAndSetNeighbors(tree, ranklist, nslist);
-  }
-  pblock = pfirst;
+  tree.BuildLocationIndex();
+  double tblocks = WallTime();
+  startup_time_.tree = tblocks - tstart;
+  std::vector<MeshBlock*> pmb_array(nbe - nbs + 1);
+  auto build_block = [&](int i) {
+    RegionSize bsize = block_size;
+    BoundaryFlag bcs[6];
+    SetBlockSizeAndBoundaries(loclist[i], bsize, bcs);
+    pmb_array[i-nbs] = new MeshBlock(i, i-nbs, loclist[i], bsize, bcs, this, pin,
+                                     properties, packages, gflag);
+    pmb_array[i-nbs]->pbval->SearchAndSetNeighbors(tree, nslist);
+  };
+  // the first block adds any missing defaults to pin and sets the shared BoundaryBase
+  // data, after which the remaining blocks only read shared state
+  if (nbe >= nbs) build_block(nbs);
+#pragma omp parallel for num_threads(num_mesh_threads_)
+  for (int i=nbs+1; i<=nbe; i++)
+    build_block(i);
+  LinkMeshBlocks(pmb_array);
+  startup_time_.blocks = WallTime() - tblocks;
 
   ResetLoadBalanceVariables();
 }
@@ -531,7 +557,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile,
     nlim(pin->GetOrAddInteger("time", "nlim", -1)), ncycle(),
     ncycle_out(pin->GetOrAddInteger("time", "ncycle_out", 1)),
     dt_diagnostics(pin->GetOrAddInteger("time", "dt_diagnostics", -1)),
-    nbnew(), nbdel(),
+    nbnew(), nbdel(), mesh_generation(),
     step_since_lb(), gflag(),
     properties(properties),
     packages(packages),
@@ -540,15 +566,14 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile,
     tree(this),
     use_uniform_meshgen_fn_{true, true, true},
     nreal_user_mesh_data_(), nint_user_mesh_data_(), nuser_history_output_(),
-    lb_flag_(true), lb_automatic_(), lb_manual_(),
+    startup_time_{}, lb_flag_(true), lb_automatic_(), lb_manual_(),
     MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
                    UniformMeshGeneratorX3},
     BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
     AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, FieldDiffusivity_{}, pblock(nullptr) {
   std::stringstream msg;
+  double tstart = WallTime();
   RegionSize block_size;
-  BoundaryFlag block_bcs[6];
-  MeshBlock *pfirst{};
   IOWrapperSizeT *offset{};
   IOWrapperSizeT datasize, listsize, headeroffset;
 
@@ -610,7 +635,6 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile,
   loclist = new LogicalLocation[nbtotal];
   offset = new IOWrapperSizeT[nbtotal];
   costlist = new double[nbtotal];
-  ranklist = new int[nbtotal];
   nslist = new int[Globals::nranks];
   nblist = new int[Globals::nranks];
 
@@ -769,14 +793,16 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile,
     bddisp = new int[Globals::nranks];
   }
 
-  CalculateLoadBalance(costlist, ranklist, nslist, nblist, nbtotal);
+  CalculateLoadBalance(costlist, nslist, nblist, nbtotal);
 
   // Output MeshBlock list and quit (mesh test only); do not create meshes
   if (mesh_test > 0) {
-    if (Globals::my_rank == 0) OutputMeshStructure(ndim);
+    if (Globals::my_rank == 0) OutputMeshStructure(ndim, true);
     delete [] offset;
     return;
   }
+  if (pin->GetOrAddBoolean("mesh", "write_structure", false))
+    OutputMeshStructure(ndim, false);
 
   // allocate data buffer
   int nb = nblist[Globals::my_rank];
@@ -791,24 +817,28 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile,
         << std::endl;
     ATHENA_ERROR(msg);
   }
-  for (int i=nbs; i<=nbe; i++) {
+  tree.BuildLocationIndex();
+  double tblocks = WallTime();
+  startup_time_.tree = tblocks - tstart;
+  std::vector<MeshBlock*> pmb_array(nb);
+  auto build_block = [&](int i) {
     // Match fixed-width integer precision of IOWrapperSizeT datasize
     std::uint64_t buff_os = datasize * (i-nbs);
-    SetBlockSizeAndBoundaries(loclist[i], block_size, block_bcs);
-    // create a block and add into the link list
-    if (i == nbs) {
-      pblock = new MeshBlock(i, i-nbs, this, pin, properties, packages, loclist[i], block_size,
-                             block_bcs, costlist[i], mbdata+buff_os, gflag);
-      pfirst = pblock;
-    } else {
-      pblock->next = new MeshBlock(i, i-nbs, this, pin, properties, packages, loclist[i], block_size,
-                                   block_bcs, costlist[i], mbdata+buff_os, gflag);
-      pblock->next->prev = pblock;
-      pblock = pblock->next;
-    }
-    pblock->pbval->SearchAndSetNeighbors(tree, ranklist, nslist);
-  }
-  pblock = pfirst;
+    RegionSize bsize = block_size;
+    BoundaryFlag bcs[6];
+    SetBlockSizeAndBoundaries(loclist[i], bsize, bcs);
+    pmb_array[i-nbs] = new MeshBlock(i, i-nbs, this, pin, properties, packages,
+                                     loclist[i], bsize, bcs, costlist[i],
+                                     mbdata+buff_os, gflag);
+    pmb_array[i-nbs]->pbval->SearchAndSetNeighbors(tree, nslist);
+  };
+  // as above, build the first block alone before the rest in parallel
+  if (nbe >= nbs) build_block(nbs);
+#pragma omp parallel for num_threads(num_mesh_threads_)
+  for (int i=nbs+1; i<=nbe; i++)
+    build_block(i);
+  LinkMeshBlocks(pmb_array);
+  startup_time_.blocks = WallTime() - tblocks;
   delete [] mbdata;
   // check consistency
   if (datasize != pblock->GetBlockSizeInBytes()) {
@@ -838,7 +868,6 @@ Mesh::~Mesh() {
   }
   delete [] nslist;
   delete [] nblist;
-  delete [] ranklist;
   delete [] costlist;
   delete [] loclist;
   if (adaptive) { // deallocate arrays for AMR
@@ -862,22 +891,97 @@ Mesh::~Mesh() {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void Mesh::OutputMeshStructure(int ndim)
-//  \brief print the mesh structure information
-
-void Mesh::OutputMeshStructure(int ndim) {
-  RegionSize block_size;
-  BoundaryFlag block_bcs[6];
-  FILE *fp = nullptr;
+//! \fn void Mesh::OutputMeshStructure(const int ndim, const bool mesh_test)
+//  \brief print per-level and per-rank statistics of the MeshBlock list and write it to
+//  mesh_structure.bin.  Every rank handles its own blocks, and the statistics are
+//  combined by reductions, so this is collective.  A mesh test emulates Globals::nranks
+//  ranks in one process, which then handles all blocks on its own.
+
+void Mesh::OutputMeshStructure(const int ndim, const bool mesh_test) {
+  // the ranks whose blocks this process handles
+  const int rfirst = mesh_test ? 0 : Globals::my_rank;
+  const int rlast = mesh_test ? Globals::nranks : Globals::my_rank + 1;
+  const int first = nslist[rfirst];
+  const int nblocks = nslist[rlast-1] + nblist[rlast-1] - first;
+  const int nlevels = current_level - root_level + 1;
+  const bool root = mesh_test || Globals::my_rank == 0;
+
+  // blocks and cost per level, then the cost of the cheapest and the most expensive
+  // block and the fewest/most blocks and the lowest/highest cost of a rank; minima are
+  // stored negated so that one MPI_MAX reduces all extremes
+  std::vector<double> per_level(2*nlevels, 0.0);
+  double extremes[6];
+  for (double &e : extremes) e = std::numeric_limits<double>::lowest();
+  std::vector<double> per_rank(2*(rlast - rfirst), 0.0);
+
+  std::vector<MeshStructureRecord> records(nblocks);
+  for (int r=rfirst; r<rlast; r++) {
+    double &rank_blocks = per_rank[2*(r - rfirst)];
+    double &rank_cost = per_rank[2*(r - rfirst) + 1];
+    for (int gid=nslist[r]; gid<nslist[r]+nblist[r]; gid++) {
+      const LogicalLocation &loc = loclist[gid];
+      RegionSize block_size;
+      BoundaryFlag block_bcs[6];
+      SetBlockSizeAndBoundaries(loc, block_size, block_bcs);
+      MeshStructureRecord &rec = records[gid - first];
+      rec.gid = gid;
+      rec.lx1 = loc.lx1;
+      rec.lx2 = loc.lx2;
+      rec.lx3 = loc.lx3;
+      rec.level = loc.level;
+      rec.rank = r;
+      rec.cost = costlist[gid];
+      rec.xmin[0] = block_size.x1min; rec.xmax[0] = block_size.x1max;
+      rec.xmin[1] = block_size.x2min; rec.xmax[1] = block_size.x2max;
+      rec.xmin[2] = block_size.x3min; rec.xmax[2] = block_size.x3max;
+
+      per_level[loc.level - root_level] += 1.0;
+      per_level[nlevels + loc.level - root_level] += costlist[gid];
+      extremes[0] = std::max(extremes[0], -costlist[gid]);
+      extremes[1] = std::max(extremes[1], costlist[gid]);
+      rank_blocks += 1.0;
+      rank_cost += costlist[gid];
+    }
+    extremes[2] = std::max(extremes[2], -rank_blocks);
+    extremes[3] = std::max(extremes[3], rank_blocks);
+    extremes[4] = std::max(extremes[4], -rank_cost);
+    extremes[5] = std::max(extremes[5], rank_cost);
+  }
 
-  // open 'mesh_structure.dat' file
-  if ((fp = std::fopen("mesh_structure.dat","wb")) == nullptr) {
-    std::cout << "### ERROR in function Mesh::OutputMeshStructure" << std::endl
-      << "Cannot open mesh_structure.dat" << std::endl;
-    return;
+  // write the header and every rank's records at the offset of its first block
+  IOWrapper file;
+#ifdef MPI_PARALLEL
+  if (mesh_test) file.SetCommunicator(MPI_COMM_SELF);
+#endif
+  MeshStructureHeader header = {{'P', 'M', 'E', 'S', 'H', '0', '0', '1'}, ndim,
+                                root_level, Globals::nranks,
+                                static_cast<std::int32_t>(sizeof(MeshStructureRecord)),
+                                nbtotal};
+  file.Open("mesh_structure.bin", IOWrapper::FileMode::write);
+  file.Write_at_all(&header, sizeof(header), root ? 1 : 0, 0);
+  file.Write_at_all(records.data(), sizeof(MeshStructureRecord), nblocks,
+                    sizeof(header) + first*sizeof(MeshStructureRecord));
+  file.Close();
+
+  // combine the statistics on rank 0, including the individual ranks if there are few
+  const int kMaxRanksListed = 64;
+  const bool list_ranks = Globals::nranks <= kMaxRanksListed;
+#ifdef MPI_PARALLEL
+  if (!mesh_test) {
+    MPI_Reduce(root ? MPI_IN_PLACE : per_level.data(), per_level.data(), 2*nlevels,
+               MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(root ? MPI_IN_PLACE : extremes, extremes, 6, MPI_DOUBLE, MPI_MAX, 0,
+               MPI_COMM_WORLD);
+    if (list_ranks) {
+      std::vector<double> all_ranks(root ? 2*Globals::nranks : 0);
+      MPI_Gather(per_rank.data(), 2, MPI_DOUBLE, all_ranks.data(), 2, MPI_DOUBLE, 0,
+                 MPI_COMM_WORLD);
+      per_rank.swap(all_ranks);
+    }
   }
+#endif
+  if (!root) return;
 
-  // Write overall Mesh structure to stdout and file
   std::cout << std::endl;
   std::cout << "Root grid = " << nrbx1 << " x " << nrbx2 << " x " << nrbx3
             << " MeshBlocks" << std::endl;
@@ -885,126 +989,33 @@ void Mesh::OutputMeshStructure(int ndim) {
   std::cout << "Number of physical refinement levels = "
             << (current_level - root_level) << std::endl;
   std::cout << "Number of logical  refinement levels = " << current_level << std::endl;
-
-  // compute/output number of blocks per level, and cost per level
-  int *nb_per_plevel = new int[max_level];
-  int *cost_per_plevel = new int[max_level];
-  for (int i=0; i<=max_level; ++i) {
-    nb_per_plevel[i] = 0;
-    cost_per_plevel[i] = 0;
-  }
-  for (int i=0; i<nbtotal; i++) {
-    nb_per_plevel[(loclist[i].level - root_level)]++;
-    cost_per_plevel[(loclist[i].level - root_level)] += costlist[i];
-  }
-  for (int i=root_level; i<=max_level; i++) {
-    if (nb_per_plevel[i-root_level] != 0) {
-      std::cout << "  Physical level = " << i-root_level << " (logical level = " << i
-                << "): " << nb_per_plevel[i-root_level] << " MeshBlocks, cost = "
-                << cost_per_plevel[i-root_level] <<  std::endl;
+  double totalcost = 0.0;
+  for (int l=0; l<nlevels; l++) {
+    totalcost += per_level[nlevels + l];
+    if (per_level[l] != 0.0) {
+      std::cout << "  Physical level = " << l << " (logical level = " << l + root_level
+                << "): " << per_level[l] << " MeshBlocks, cost = "
+                << per_level[nlevels + l] << std::endl;
     }
   }
 
-  // compute/output number of blocks per rank, and cost per rank
   std::cout << "Number of parallel ranks = " << Globals::nranks << std::endl;
-  int *nb_per_rank = new int[Globals::nranks];
-  int *cost_per_rank = new int[Globals::nranks];
-  for (int i=0; i<Globals::nranks; ++i) {
-    nb_per_rank[i] = 0;
-    cost_per_rank[i] = 0;
-  }
-  for (int i=0; i<nbtotal; i++) {
-    nb_per_rank[ranklist[i]]++;
-    cost_per_rank[ranklist[i]] += costlist[i];
-  }
-  for (int i=0; i<Globals::nranks; ++i) {
-    std::cout << "  Rank = " << i << ": " << nb_per_rank[i] <<" MeshBlocks, cost = "
-              << cost_per_rank[i] << std::endl;
-  }
-
-  // output relative size/locations of meshblock to file, for plotting
-  double real_max = std::numeric_limits<double>::max();
-  double mincost = real_max, maxcost = 0.0, totalcost = 0.0;
-  for (int i=root_level; i<=max_level; i++) {
-    for (int j=0; j<nbtotal; j++) {
-      if (loclist[j].level == i) {
-        SetBlockSizeAndBoundaries(loclist[j], block_size, block_bcs);
-        std::int64_t &lx1 = loclist[j].lx1;
-        std::int64_t &lx2 = loclist[j].lx2;
-        std::int64_t &lx3 = loclist[j].lx3;
-        int &ll = loclist[j].level;
-        mincost = std::min(mincost,costlist[i]);
-        maxcost = std::max(maxcost,costlist[i]);
-        totalcost += costlist[i];
-        std::fprintf(fp,"#MeshBlock %d on rank=%d with cost=%g\n", j, ranklist[j],
-                     costlist[j]);
-        std::fprintf(
-            fp, "#  Logical level %d, location = (%" PRId64 " %" PRId64 " %" PRId64")\n",
-            ll, lx1, lx2, lx3);
-        if (ndim == 2) {
-          std::fprintf(fp, "%g %g\n", block_size.x1min, block_size.x2min);
-          std::fprintf(fp, "%g %g\n", block_size.x1max, block_size.x2min);
-          std::fprintf(fp, "%g %g\n", block_size.x1max, block_size.x2max);
-          std::fprintf(fp, "%g %g\n", block_size.x1min, block_size.x2max);
-          std::fprintf(fp, "%g %g\n", block_size.x1min, block_size.x2min);
-          std::fprintf(fp, "\n\n");
-        }
-        if (ndim == 3) {
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2min,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2min,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2max,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2max,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2min,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2min,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2min,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2min,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2min,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2max,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2max,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1max, block_size.x2max,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2max,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2max,
-                       block_size.x3min);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2max,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2min,
-                       block_size.x3max);
-          std::fprintf(fp, "%g %g %g\n", block_size.x1min, block_size.x2min,
-                       block_size.x3min);
-          std::fprintf(fp, "\n\n");
-        }
-      }
+  if (list_ranks) {
+    for (int r=0; r<Globals::nranks; r++) {
+      std::cout << "  Rank = " << r << ": " << per_rank[2*r] << " MeshBlocks, cost = "
+                << per_rank[2*r + 1] << std::endl;
     }
   }
+  std::cout << "  MeshBlocks per rank: minimum = " << -extremes[2] << ", maximum = "
+            << extremes[3] << std::endl;
+  std::cout << "  Cost per rank: minimum = " << -extremes[4] << ", maximum = "
+            << extremes[5] << ", average = " << totalcost/Globals::nranks << std::endl;
 
-  // close file, final outputs
-  std::fclose(fp);
   std::cout << "Load Balancing:" << std::endl;
-  std::cout << "  Minimum cost = " << mincost << ", Maximum cost = " << maxcost
+  std::cout << "  Minimum cost = " << -extremes[0] << ", Maximum cost = " << extremes[1]
             << ", Average cost = " << totalcost/nbtotal << std::endl << std::endl;
-  std::cout << "See the 'mesh_structure.dat' file for a complete list"
-            << " of MeshBlocks." << std::endl;
-  std::cout << "Use 'python ../vis/python/plot_mesh.py' or gnuplot"
-            << " to visualize mesh structure." << std::endl << std::endl;
-
-  delete [] nb_per_plevel;
-  delete [] cost_per_plevel;
-  delete [] nb_per_rank;
-  delete [] cost_per_rank;
-
+  std::cout << "See the 'mesh_structure.bin' file for a complete list"
+            << " of MeshBlocks." << std::endl << std::endl;
   return;
 }
 
@@ -1231,6 +1242,9 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
   int nthreads = GetNumMeshThreads();
   int nmb = GetNumMeshBlocksThisRank(Globals::my_rank);
   std::vector<MeshBlock*> pmb_array(nmb);
+  // res_flag=2 is the re-initialization after load balancing, which is not part of the
+  // startup timing (during startup it is accounted for in the refinement phase)
+  const bool time_startup = (res_flag != 2);
 
   do {
     // initialize a vector of MeshBlock pointers
@@ -1242,30 +1256,26 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
       pmbl = pmbl->next;
     }
 
-    if (res_flag == 0) {
-#pragma omp parallel for num_threads(nthreads)
-      for (int i=0; i<nmb; ++i) {
-        MeshBlock *pmb = pmb_array[i];
-        pmb->ProblemGenerator(pin);
-      }
-    }
-
-
-    // Create send/recv MPI_Requests for all BoundaryData objects
-#pragma omp parallel for num_threads(nthreads)
-    for (int i=0; i<nmb; ++i) {
-      MeshBlock *pmb = pmb_array[i];
-      // BoundaryVariable objects evolved in main TimeIntegratorTaskList:
-      pmb->pbval->SetupPersistentMPI();
-      pmb->real_container.SetupPersistentMPI();
-    }
-
+    double tphase = WallTime();
 #pragma omp parallel num_threads(nthreads)
     {
-      // prepare to receive conserved variables
+      // generate the initial conditions, create send/recv MPI_Requests for all
+      // BoundaryData objects and post the receives, so that the initial exchange below
+      // is a single send/receive phase
 #pragma omp for
       for (int i=0; i<nmb; ++i) {
-        pmb_array[i]->real_container.StartReceiving(BoundaryCommSubset::mesh_init);
+        MeshBlock *pmb = pmb_array[i];
+        if (res_flag == 0) pmb->ProblemGenerator(pin);
+        // BoundaryVariable objects evolved in main TimeIntegratorTaskList:
+        pmb->pbval->SetupPersistentMPI();
+        pmb->real_container.SetupPersistentMPI();
+        pmb->real_container.StartReceiving(BoundaryCommSubset::mesh_init);
+      }
+#pragma omp single
+      {
+        double tnow = WallTime();
+        if (time_startup) startup_time_.problem_generator += tnow - tphase;
+        tphase = tnow;
       }
 
       // send conserved variables
@@ -1274,59 +1284,34 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
         pmb_array[i]->real_container.SendBoundaryBuffers();
       }
 
-
-      // wait to receive conserved variables
-#pragma omp for
-      for (int i=0; i<nmb; ++i) {
-        pmb_array[i]->real_container.ReceiveAndSetBoundariesWithWait();
-      }
-
-#pragma omp for
-      for (int i=0; i<nmb; ++i) {
-        pmb_array[i]->real_container.SetBoundaries();
-        pmb_array[i]->real_container.ClearBoundary(BoundaryCommSubset::mesh_init);
-      }
-
-      // Now do prolongation, compute primitives, apply BCs
+      // wait to receive conserved variables, then do prolongation, compute primitives,
+      // apply BCs and check refinement; all of these only touch the block's own data
 #pragma omp for
       for (int i=0; i<nmb; ++i) {
         auto &pmb = pmb_array[i];
         auto &pbval = pmb->pbval;
+        pmb->real_container.ReceiveAndSetBoundariesWithWait();
+        pmb->real_container.SetBoundaries();
+        pmb->real_container.ClearBoundary(BoundaryCommSubset::mesh_init);
+
         if (multilevel)
           pbval->ProlongateBoundaries(time, 0.0);
 
-        int il = pmb->is, iu = pmb->ie,
-            jl = pmb->js, ju = pmb->je,
-            kl = pmb->ks, ku = pmb->ke;
-        if (pbval->nblevel[1][1][0] != -1) il -= NGHOST;
-        if (pbval->nblevel[1][1][2] != -1) iu += NGHOST;
-        if (pmb->block_size.nx2 > 1) {
-          if (pbval->nblevel[1][0][1] != -1) jl -= NGHOST;
-          if (pbval->nblevel[1][2][1] != -1) ju += NGHOST;
-        }
-        if (pmb->block_size.nx3 > 1) {
-          if (pbval->nblevel[0][1][1] != -1) kl -= NGHOST;
-          if (pbval->nblevel[2][1][1] != -1) ku += NGHOST;
-        }
-
         ApplyBoundaryConditions(pmb->real_container);
         FillDerivedVariables::FillDerived(pmb->real_container);
 
-        //pbval->ApplyPhysicalBoundaries(time, 0.0);
-      }
-
-      if (!res_flag && adaptive) {
-#pragma omp for
-        for (int i=0; i<nmb; ++i) {
-          pmb_array[i]->pmr->CheckRefinementCondition();
-        }
+        if (!res_flag && adaptive)
+          pmb->pmr->CheckRefinementCondition();
       }
     } // omp parallel
+    double tnow = WallTime();
+    if (time_startup) startup_time_.boundary_exchange += tnow - tphase;
 
     if (!res_flag && adaptive) {
       iflag = false;
       int onb = nbtotal;
       LoadBalancingAndAdaptiveMeshRefinement(pin);
+      startup_time_.refinement += WallTime() - tnow;
       if (nbtotal == onb) {
         iflag = true;
       } else if (nbtotal < onb && Globals::my_rank == 0) {
@@ -1346,12 +1331,28 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
   } while (!iflag);
 
   // calculate the first time step
+  double tphase = WallTime();
 #pragma omp parallel for num_threads(nthreads)
   for (int i=0; i<nmb; ++i) {
     pmb_array[i]->SetBlockTimestep(Update::EstimateTimestep(pmb_array[i]->real_container));
   }
 
   NewTimeStep();
+  if (time_startup) startup_time_.timestep += WallTime() - tphase;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::LinkMeshBlocks(std::vector<MeshBlock*> &pmb_array)
+//  \brief link the MeshBlocks of this rank, in gid order, into the list headed by pblock
+
+void Mesh::LinkMeshBlocks(std::vector<MeshBlock*> &pmb_array) {
+  const int nmb = pmb_array.size();
+  for (int i=0; i<nmb; ++i) {
+    pmb_array[i]->prev = (i > 0) ? pmb_array[i-1] : nullptr;
+    pmb_array[i]->next = (i < nmb-1) ? pmb_array[i+1] : nullptr;
+  }
+  pblock = (nmb > 0) ? pmb_array[0] : nullptr;
   return;
 }
 
@@ -1546,4 +1547,38 @@ void Mesh::OutputCycleDiagnostics() {
   }
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::OutputStartupTimes()
+//  \brief print the wall-clock time spent in each phase of Mesh construction and
+//  initialization, taking the maximum over ranks
+
+void Mesh::OutputStartupTimes() {
+  const int nphase = 6;
+  const char *phase_names[nphase] = {
+    "mesh tree and load balance", "MeshBlock construction",
+    "problem generator and comm setup", "initial boundary exchange",
+    "initial mesh refinement", "first time step"};
+  double phase_time[nphase] = {
+    startup_time_.tree, startup_time_.blocks, startup_time_.problem_generator,
+    startup_time_.boundary_exchange, startup_time_.refinement, startup_time_.timestep};
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, phase_time, nphase, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  if (Globals::my_rank == 0) {
+    double total = 0.0;
+    std::cout << std::endl << "Startup time breakdown (max over ranks):" << std::endl;
+    for (int n=0; n<nphase; ++n) {
+      std::cout << "  " << std::left << std::setw(34) << phase_names[n] << std::right
+                << std::fixed << std::setprecision(3) << phase_time[n] << " s"
+                << std::endl;
+      total += phase_time[n];
+    }
+    std::cout << "  " << std::left << std::setw(34) << "total" << std::right
+              << total << " s" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+  }
+  return;
+}
 }
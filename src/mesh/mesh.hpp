@@ -197,7 +197,7 @@ class MeshBlock {
   std::size_t GetBlockSizeInBytes();
   int GetNumberOfMeshBlockCells() {
     return block_size.nx1*block_size.nx2*block_size.nx3; }
-  void SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist, int *nslist);
+  void SearchAndSetNeighbors(MeshBlockTree &tree, int *nslist);
   void WeightedAve(AthenaArray<Real> &u_out, AthenaArray<Real> &u_in1,
                    AthenaArray<Real> &u_in2, const Real wght[3]);
   void WeightedAve(FaceField &b_out, FaceField &b_in1, FaceField &b_in2,
@@ -259,6 +259,7 @@ class Mesh {
   friend class FieldDiffusion;
 #ifdef HDF5OUTPUT
   friend class ATHDF5Output;
+  friend class InSituOutput;
 #endif
 
  public:
@@ -286,6 +287,7 @@ class Mesh {
   int nlim, ncycle, ncycle_out, dt_diagnostics;
   int nbtotal, nbnew, nbdel;
   std::uint64_t mbcnt;
+  std::uint64_t mesh_generation;  // incremented whenever the MeshBlock tree changes
 
   int step_since_lb;
   int gflag;
@@ -316,14 +318,16 @@ class Mesh {
   // defined in either the prob file or default_pgen.cpp in ../pgen/
   void UserWorkAfterLoop(ParameterInput *pin);   // called in main loop
   void UserWorkInLoop(); // called in main after each cycle
+  void OutputStartupTimes();
   int GetRootLevel() { return root_level; }
+  static int FindRankOfBlock(int gid, const int *slist);
 
  private:
   // data
   int next_phys_id_; // next unused value for encoding final component of MPI tag bitfield
   int root_level, max_level, current_level;
   int num_mesh_threads_;
-  int *nslist, *ranklist, *nblist;
+  int *nslist, *nblist;
   double *costlist;
   // 8x arrays used exclusively for AMR (not SMR):
   int *nref, *nderef;
@@ -332,6 +336,12 @@ class Mesh {
   int *brdisp, *bddisp;
   // the last 4x should be std::size_t, but are limited to int by MPI
 
+  // TODO: the tree, loclist and costlist are still replicated on every rank
+  // and hold all nbtotal blocks, so each rank needs O(nbtotal) memory and every
+  // refinement step allgathers the flagged blocks.  Distributing them needs each rank to
+  // keep only its own leaves plus a halo of their neighbors, with neighbor search
+  // (SearchAndSetNeighbors), gid numbering after refinement, restarts and the outputs
+  // that index loclist by gid moved to that halo.
   LogicalLocation *loclist;
   MeshBlockTree tree;
   // number of MeshBlocks in the x1, x2, x3 directions of the root grid:
@@ -348,6 +358,11 @@ class Mesh {
   std::string *user_history_output_names_;
   UserHistoryOperation *user_history_ops_;
 
+  // wall-clock seconds spent in each phase of Mesh construction and initialization
+  struct StartupTimes {
+    double tree, blocks, problem_generator, boundary_exchange, refinement, timestep;
+  } startup_time_;
+
   // variables for load balancing control
   bool lb_flag_, lb_automatic_, lb_manual_;
   double lb_tolerance_;
@@ -365,17 +380,19 @@ class Mesh {
 
   void AllocateRealUserMeshDataField(int n);
   void AllocateIntUserMeshDataField(int n);
-  void OutputMeshStructure(int dim);
-  void CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlist, int nb);
+  void OutputMeshStructure(const int ndim, const bool mesh_test);
+  void CalculateLoadBalance(double *clist, int *slist, int *nlist, int nb);
   void ResetLoadBalanceVariables();
 
   void CorrectMidpointInitialCondition(std::vector<MeshBlock*> &pmb_array, int nmb);
+  void LinkMeshBlocks(std::vector<MeshBlock*> &pmb_array);
   void ReserveMeshBlockPhysIDs();
 
   // Mesh::LoadBalancingAndAdaptiveMeshRefinement() helper functions:
   void UpdateCostList();
   void UpdateMeshBlockTree(int &nnew, int &ndel);
-  bool GatherCostListAndCheckBalance();
+  bool CheckLoadBalance();
+  void GatherCostList();
   void RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot);
 
   // Mesh::RedistributeAndRefineMeshBlocks() helper functions:
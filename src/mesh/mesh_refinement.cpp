@@ -44,12 +44,20 @@ namespace parthenon {
 //  \brief constructor
 
 MeshRefinement::MeshRefinement(MeshBlock *pmb, ParameterInput *pin) :
-    pmy_block_(pmb), deref_count_(0),
+    pmy_block_(pmb), refine_flag_(0), deref_count_(0),
     deref_threshold_(pin->GetOrAddInteger("mesh", "derefine_count", 10)),
+    check_interval_(pin->GetOrAddInteger("mesh", "refinement_interval", 1)),
     AMRFlag_(pmb->pmy_mesh->AMRFlag_) {
   // Create coarse mesh object for parent grid
   pcoarsec = new Cartesian(pmb, pin, true);
 
+  if (check_interval_ < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MeshRefinement constructor" << std::endl
+        << "refinement_interval=" << check_interval_ << " must be >= 1" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
   if (NGHOST % 2) {
     std::stringstream msg;
     msg << "### FATAL ERROR in MeshRefinement constructor" << std::endl
@@ -956,6 +964,11 @@ void MeshRefinement::ProlongateInternalField(
 
 void MeshRefinement::CheckRefinementCondition() {
   MeshBlock *pmb = pmy_block_;
+  // between checks, leave the block alone without resetting the derefinement counter
+  if (pmb->pmy_mesh->ncycle % check_interval_ != 0) {
+    refine_flag_ = 0;
+    return;
+  }
   Container<Real>& rc = pmb->real_container;
   int ret = 0;
   ret = BetterRefinement::CheckAllRefinement(rc);
@@ -969,6 +982,8 @@ void MeshRefinement::SetRefinement(int flag) {
 
   if (aret >= 0)
     deref_count_ = 0;
+  if (aret == 0)
+    refine_flag_ = 0;
   if (aret > 0) {
     if (pmb->loc.level == pmb->pmy_mesh->max_level) {
       refine_flag_ = 0;
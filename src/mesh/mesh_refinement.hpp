@@ -91,6 +91,7 @@ class MeshRefinement {
 
   AthenaArray<Real> fvol_[2][2], sarea_x1_[2][2], sarea_x2_[2][3], sarea_x3_[3][2];
   int refine_flag_, neighbor_rflag_, deref_count_, deref_threshold_;
+  int check_interval_;  // evaluate the refinement criteria every check_interval_ cycles
 
   // functions
   AMRFlagFunc AMRFlag_; // duplicate of Mesh class member
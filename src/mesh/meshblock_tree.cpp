@@ -41,6 +41,8 @@ namespace parthenon {
 Mesh* pmesh_;
 MeshBlockTree* MeshBlockTree::proot_;
 int MeshBlockTree::nleaf_;
+MeshBlockTree::LocationIndex MeshBlockTree::index_;
+bool MeshBlockTree::index_valid_;
 
 
 //----------------------------------------------------------------------------------------
@@ -87,6 +89,7 @@ MeshBlockTree::~MeshBlockTree() {
 //  \brief create the root grid; the root grid can be incomplete (less than 8 leaves)
 
 void MeshBlockTree::CreateRootGrid() {
+  index_valid_ = false;
   if (loc_.level == 0) {
     nleaf_ = 2;
     if (pmesh_->ndim >= 2) nleaf_ = 4;
@@ -116,6 +119,7 @@ void MeshBlockTree::CreateRootGrid() {
 //  \brief add a MeshBlock to the tree, also creates neighboring blocks
 
 void MeshBlockTree::AddMeshBlock(LogicalLocation rloc, int &nnew) {
+  index_valid_ = false;
   if (loc_.level == rloc.level) return; // done
 
   if (pleaf_ == nullptr) // leaf -> create the finer level
@@ -138,6 +142,7 @@ void MeshBlockTree::AddMeshBlock(LogicalLocation rloc, int &nnew) {
 //  \brief add a MeshBlock to the tree without refinement, used in restarting.
 //         MeshBlockTree::CreateRootGrid must be called before this method
 void MeshBlockTree::AddMeshBlockWithoutRefine(LogicalLocation rloc) {
+  index_valid_ = false;
   if (loc_.level == rloc.level) // done
     return;
 
@@ -166,6 +171,7 @@ void MeshBlockTree::AddMeshBlockWithoutRefine(LogicalLocation rloc) {
 //  \brief make finer leaves
 
 void MeshBlockTree::Refine(int &nnew) {
+  index_valid_ = false;
   if (pleaf_ != nullptr) return;
 
   pleaf_ = new MeshBlockTree*[nleaf_];
@@ -253,6 +259,7 @@ void MeshBlockTree::Refine(int &nnew) {
 //  \brief destroy leaves and make this block a leaf
 
 void MeshBlockTree::Derefine(int &ndel) {
+  index_valid_ = false;
   int s2=0, e2=0, s3=0, e3=0;
   if (pmesh_->ndim >= 2) s2=-1, e2=1;
   if (pmesh_->ndim >= 3) s3=-1, e3=1;
@@ -404,28 +411,46 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
   }
   if (ll<1) return proot_; // single grid; return root
 
-  for (int level=0; level<ll; level++) {
-    if (bt->pleaf_ == nullptr) { // leaf
-      if (level == ll-1) {
-        return bt;
-      } else {
+  if (index_valid_) {
+    // hashed lookup of the same-level node, else of its coarser parent, which must
+    // then be a leaf
+    LogicalLocation nloc;
+    nloc.lx1 = lx, nloc.lx2 = ly, nloc.lx3 = lz, nloc.level = ll;
+    bt = FindInLocationIndex(nloc);
+    if (bt == nullptr) {
+      nloc.lx1 = lx>>1, nloc.lx2 = ly>>1, nloc.lx3 = lz>>1, nloc.level = ll-1;
+      bt = FindInLocationIndex(nloc);
+      if (bt == nullptr || bt->pleaf_ != nullptr) {
         msg << "### FATAL ERROR in FindNeighbor" << std::endl
             << "Neighbor search failed. The Block Tree is broken." << std::endl;
         ATHENA_ERROR(msg);
-        return nullptr;
       }
+      return bt;
     }
-    // find a leaf in the next level
-    int sh=ll-level-1;
-    ox = ((lx>>sh) & 1LL) == 1LL;
-    oy = ((ly>>sh) & 1LL) == 1LL;
-    oz = ((lz>>sh) & 1LL) == 1LL;
-    bt=bt->GetLeaf(ox, oy, oz);
-    if (bt == nullptr) {
-      msg << "### FATAL ERROR in FindNeighbor" << std::endl
-          << "Neighbor search failed. The Block Tree is broken." << std::endl;
-      ATHENA_ERROR(msg);
-      return nullptr;
+  } else {
+    for (int level=0; level<ll; level++) {
+      if (bt->pleaf_ == nullptr) { // leaf
+        if (level == ll-1) {
+          return bt;
+        } else {
+          msg << "### FATAL ERROR in FindNeighbor" << std::endl
+              << "Neighbor search failed. The Block Tree is broken." << std::endl;
+          ATHENA_ERROR(msg);
+          return nullptr;
+        }
+      }
+      // find a leaf in the next level
+      int sh=ll-level-1;
+      ox = ((lx>>sh) & 1LL) == 1LL;
+      oy = ((ly>>sh) & 1LL) == 1LL;
+      oz = ((lz>>sh) & 1LL) == 1LL;
+      bt=bt->GetLeaf(ox, oy, oz);
+      if (bt == nullptr) {
+        msg << "### FATAL ERROR in FindNeighbor" << std::endl
+            << "Neighbor search failed. The Block Tree is broken." << std::endl;
+        ATHENA_ERROR(msg);
+        return nullptr;
+      }
     }
   }
   if (bt->pleaf_ == nullptr) // leaf on the same level
@@ -462,4 +487,40 @@ MeshBlockTree* MeshBlockTree::FindMeshBlock(LogicalLocation tloc) {
     return nullptr;
   return pleaf_[n]->FindMeshBlock(tloc);
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBlockTree::BuildLocationIndex()
+//  \brief (re)build the hashed index of all nodes, called from the root of a completed
+//         tree.  FindNeighbor() uses it until the tree structure changes again.
+
+void MeshBlockTree::BuildLocationIndex() {
+  index_.clear();
+  AddToLocationIndex();
+  index_valid_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBlockTree::AddToLocationIndex()
+//  \brief add this node and all nodes below it to the hashed index
+
+void MeshBlockTree::AddToLocationIndex() {
+  index_[loc_] = this;
+  if (pleaf_ != nullptr) {
+    for (int n=0; n<nleaf_; n++) {
+      if (pleaf_[n] != nullptr)
+        pleaf_[n]->AddToLocationIndex();
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn MeshBlockTree* MeshBlockTree::FindInLocationIndex(LogicalLocation tloc)
+//  \brief return the node at tloc from the hashed index, or nullptr if there is none
+
+MeshBlockTree* MeshBlockTree::FindInLocationIndex(LogicalLocation tloc) {
+  auto it = index_.find(tloc);
+  return (it == index_.end()) ? nullptr : it->second;
+}
 }
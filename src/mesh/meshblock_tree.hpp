@@ -23,6 +23,10 @@
 // C headers
 
 // C++ headers
+#include <cstddef>        // std::size_t
+#include <cstdint>        // std::uint64_t
+#include <initializer_list>
+#include <unordered_map>
 
 // Athena++ headers
 #include "athena.hpp"
@@ -33,6 +37,26 @@
 namespace parthenon {
 class Mesh;
 
+//--------------------------------------------------------------------------------------
+//! \struct LogicalLocationHash, LogicalLocationEqual
+//  \brief hash and equality of LogicalLocation, for use as an unordered_map key
+
+struct LogicalLocationHash {
+  std::size_t operator()(const LogicalLocation &loc) const {
+    std::uint64_t h = static_cast<std::uint64_t>(loc.level);
+    for (std::int64_t lx : {loc.lx1, loc.lx2, loc.lx3})
+      h ^= static_cast<std::uint64_t>(lx) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+    return static_cast<std::size_t>(h);
+  }
+};
+
+struct LogicalLocationEqual {
+  bool operator()(const LogicalLocation &left, const LogicalLocation &right) const {
+    return (left.level == right.level) && (left.lx1 == right.lx1)
+        && (left.lx2 == right.lx2) && (left.lx3 == right.lx3);
+  }
+};
+
 //--------------------------------------------------------------------------------------
 //! \class MeshBlockTree
 //  \brief Objects are nodes in an AMR MeshBlock tree structure
@@ -61,6 +85,7 @@ class MeshBlockTree {
   void GetMeshBlockList(LogicalLocation *list, int *pglist, int& count);
   MeshBlockTree* FindNeighbor(LogicalLocation myloc, int ox1, int ox2, int ox3,
                               bool amrflag=false);
+  void BuildLocationIndex();
 
  private:
   // data
@@ -70,6 +95,16 @@ class MeshBlockTree {
 
   static MeshBlockTree* proot_;
   static int nleaf_;
+
+  // hashed LogicalLocation -> node index of the whole tree, built by BuildLocationIndex()
+  // and dropped by any change to the tree structure
+  using LocationIndex = std::unordered_map<LogicalLocation, MeshBlockTree*,
+                                           LogicalLocationHash, LogicalLocationEqual>;
+  static LocationIndex index_;
+  static bool index_valid_;
+
+  void AddToLocationIndex();
+  MeshBlockTree* FindInLocationIndex(LogicalLocation tloc);
 };
 }
 #endif // MESH_MESHBLOCK_TREE_HPP_
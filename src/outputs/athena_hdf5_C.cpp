@@ -19,9 +19,19 @@
 #include <defs.hpp>
 
 // C++ headers
+#include <cmath>
+#include <cstdint>
+#include <cstdio>     // rename, remove
+#include <cstring>    // memcpy
 #include <fstream>    // ofstream, quoted
+#include <iostream>
+#include <limits>
 #include <sstream>
 #include <iomanip>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #ifdef MPI_PARALLEL
 // MPI headers
@@ -46,6 +56,8 @@
 
 #define PREDINT32 H5T_NATIVE_INT32
 #define PREDFLOAT64 H5T_NATIVE_DOUBLE
+// registered id of the LZ4 filter plugin, found by HDF5 through HDF5_PLUGIN_PATH
+#define H5Z_FILTER_LZ4 32004
 
 namespace parthenon {
 // XDMF subroutine to write a dataitem that refers to an HDF array
@@ -84,7 +96,7 @@ static void writeXdmfVariableRef(std::ofstream& fid, const std::string& prefix,
 
 static void writeXdmfSlabVariableRef(std::ofstream &fid, std::string& name, std::string& hdfFile,
                                      int iblock, const int&vlen, int& ndims, hsize_t *dims,
-                                     const std::string& dims321
+                                     const std::string& dims321, const int precision
                                      ) {
   // writes a slab reference to file
 
@@ -113,7 +125,8 @@ static void writeXdmfSlabVariableRef(std::ofstream &fid, std::string& name, std:
       << vlen
       <<  "</DataItem>"
       << std::endl;;
-  writeXdmfArrayRef(fid, prefix+"    ", hdfFile+":/",name, dims, ndims, "Float", 8);
+  writeXdmfArrayRef(fid, prefix+"    ", hdfFile+":/", name, dims, ndims, "Float",
+                    precision);
   fid << prefix << "  " << "</DataItem>" << std::endl;
   fid << prefix << "</Attribute>" << std::endl;
   return;
@@ -143,6 +156,33 @@ static herr_t writeH5AF64(const char *name, const Real* pData,
   return status;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn static bool IsListed(const std::string &labels, const std::string &label)
+//  \brief whether "label" is in the comma separated "labels"; an empty list holds all
+
+static bool IsListed(const std::string &labels, const std::string &label) {
+  if (labels.empty()) return true;
+  std::stringstream list(labels);
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    const auto first = item.find_first_not_of(" \t");
+    const auto last = item.find_last_not_of(" \t");
+    if (first != std::string::npos && item.substr(first, last - first + 1) == label)
+      return true;
+  }
+  return false;
+}
+
+// whether variable "label" is quantized before it is written
+static bool IsLossy(const OutputParameters &op, const std::string &label) {
+  return op.lossy != "none" && IsListed(op.lossy_variables, label);
+}
+
+// whether variable "label" is stored as float32
+static bool IsSinglePrecision(const OutputParameters &op, const std::string &label) {
+  return op.single_precision && IsListed(op.single_precision_variables, label);
+}
+
 void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
   // using round robin generation.
   // must switch to MPIIO at some point
@@ -151,7 +191,9 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
   if ( Globals::my_rank != 0) {
     return;
   }
+  // while staged files are drained the XDMF is written aside, see PublishXDMF()
   std::string filename_aux = hdfFile + ".xdmf";
+  if (filename_aux == xdmf_pending_) filename_aux += ".part";
   std::ofstream xdmf;
   MeshBlock *pmb;
   hsize_t dims[5]={0,0,0,0,0};
@@ -183,15 +225,25 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
 
   // Now write Grid for each block
   pmb = pm->pblock;
-  dims[0] = pm->nbtotal;
   std::string dims321 = std::to_string(nx3) + " " + std::to_string(nx2) + " " + std::to_string(nx1);
 
   int ndims = 5;
 
   // same set of variables for all grids so use only one container
   auto ciX = ContainerIterator<Real>(pmb->real_container,{Metadata::Graphics});
-  for(int ib=0; ib<pm->nbtotal; ib++) {
-    xdmf << "    <Grid GridType=\"Uniform\" Name=\""<<ib<<"\">" << std::endl;
+  for(int gid=0; gid<pm->nbtotal; gid++) {
+    // with staged rank files, the block is entry ib of the file of its rank
+    std::string blockFile = hdfFile;
+    int ib = gid;
+    dims[0] = pm->nbtotal;
+    if (!output_params.stage_dir.empty() && Globals::nranks > 1) {
+      int rank = 0;
+      while (gid >= pm->nslist[rank] + pm->nblist[rank]) rank++;
+      blockFile = RankFileName(hdfFile, rank);
+      ib = gid - pm->nslist[rank];
+      dims[0] = pm->nblist[rank];
+    }
+    xdmf << "    <Grid GridType=\"Uniform\" Name=\""<<gid<<"\">" << std::endl;
     xdmf << blockTopology;
     xdmf << R"(      <Geometry Type="VXVYVZ">)" << std::endl;
     xdmf << slabPreDim
@@ -200,7 +252,8 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
          << ib << " 0 1 1 1 " << nx1+1 << slabTrailer << std::endl;
 
     dims[1] =nx1+1;
-    writeXdmfArrayRef(xdmf, "          ", hdfFile+":/Locations/","x", dims, 2, "Float", 8);
+    writeXdmfArrayRef(xdmf, "          ", blockFile+":/Locations/", "x", dims, 2,
+                      "Float", 8);
     xdmf << "</DataItem>" << std::endl;
 
     xdmf << slabPreDim
@@ -209,7 +262,8 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
          << ib << " 0 1 1 1 " << nx2+1 << slabTrailer << std::endl;
 
     dims[1] =nx2+1;
-    writeXdmfArrayRef(xdmf, "          ", hdfFile+":/Locations/","y", dims, 2, "Float", 8);
+    writeXdmfArrayRef(xdmf, "          ", blockFile+":/Locations/", "y", dims, 2,
+                      "Float", 8);
     xdmf << "</DataItem>" << std::endl;
 
     xdmf << slabPreDim
@@ -218,7 +272,8 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
          << ib << " 0 1 1 1 " << nx3+1 << slabTrailer << std::endl;
 
     dims[1] =nx3+1;
-    writeXdmfArrayRef(xdmf, "          ", hdfFile+":/Locations/","z", dims, 2, "Float", 8);
+    writeXdmfArrayRef(xdmf, "          ", blockFile+":/Locations/", "z", dims, 2,
+                      "Float", 8);
     xdmf << "</DataItem>" << std::endl;
 
     xdmf << "      </Geometry>" << std::endl;
@@ -233,8 +288,8 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
       const int vlen = v->GetDim4();
       dims[4] = vlen;
       std::string name = v->label();
-      writeXdmfSlabVariableRef(xdmf, name, hdfFile,
-                               ib, vlen, ndims, dims, dims321);
+      writeXdmfSlabVariableRef(xdmf, name, blockFile, ib, vlen, ndims, dims, dims321,
+                               IsSinglePrecision(output_params, name) ? 4 : 8);
     }
     xdmf << "      </Grid>" << std::endl;
   }
@@ -263,25 +318,201 @@ void ATHDF5Output::genXDMF(std::string hdfFile, Mesh *pm) {
   }
 
 
-#define WRITEH5SLAB2(name, pData, theLocation, Starts, Counts, lDSpace, gDSpace, plist) { \
-    hid_t gDSet = H5Dcreate(theLocation, name, H5T_NATIVE_DOUBLE, gDSpace, \
-                            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);     \
+#define WRITEH5SLAB2(name, pData, theLocation, Starts, Counts, lDSpace, gDSpace, plist, \
+                     dcpl, type) {                                      \
+    hid_t gDSet = H5Dcreate(theLocation, name, type, gDSpace,           \
+                            H5P_DEFAULT, dcpl, H5P_DEFAULT);            \
     H5Sselect_hyperslab(gDSpace, H5S_SELECT_SET,                        \
                         Starts, NULL,                                   \
                         Counts, NULL);                                  \
-    H5Dwrite(gDSet, H5T_NATIVE_DOUBLE, lDSpace, gDSpace, plist, pData); \
+    H5Dwrite(gDSet, type, lDSpace, gDSpace, plist, pData);              \
     H5Dclose(gDSet);                                                    \
   }
 #define WRITEH5SLAB(name, pData, theLocation, localStart, localCount, globalCount, plist) { \
       hid_t lDSpace = H5Screate_simple(2, localCount, NULL);            \
       hid_t gDSpace = H5Screate_simple(2, globalCount, NULL);           \
       WRITEH5SLAB2(name, pData, theLocation, localStart, localCount,    \
-                   lDSpace, gDSpace, plist);                            \
+                   lDSpace, gDSpace, plist, H5P_DEFAULT, H5T_NATIVE_DOUBLE); \
       H5Sclose(gDSpace);                                                \
       H5Sclose(lDSpace);                                                \
   }
 
 
+#ifdef MPI_PARALLEL
+//----------------------------------------------------------------------------------------
+//! \fn static void SetFileAccessHints(const OutputParameters &op, hid_t acc_file,
+//                                     MPI_Info info)
+//  \brief fills the MPI-IO hints and hdf5 file access properties from the output block.
+//  Collective writes use two-phase I/O: the ranks ship their blocks to "aggregators"
+//  ranks (at most "aggregators_per_node" per node), which issue large contiguous writes
+//  of up to cb_buffer_size bytes.  The striping hints only apply when the file is
+//  created, and file systems without striping ignore them.
+
+static void SetFileAccessHints(const OutputParameters &op, hid_t acc_file,
+                               MPI_Info info) {
+  H5Pset_sieve_buf_size(acc_file, op.sieve_buffer_size);
+  H5Pset_alignment(acc_file, op.alignment_threshold, op.alignment);
+
+  MPI_Info_set(info, "access_style", "write_once");
+  MPI_Info_set(info, "collective_buffering", "true");
+  MPI_Info_set(info, "romio_cb_write", "enable");
+  MPI_Info_set(info, "cb_buffer_size", std::to_string(op.cb_buffer_size).c_str());
+  // aggregators access the file in units of the stripe size where one is given
+  MPI_Info_set(info, "cb_block_size",
+               std::to_string(op.stripe_size > 0 ? op.stripe_size : 1048576).c_str());
+  if (op.aggregators > 0)
+    MPI_Info_set(info, "cb_nodes", std::to_string(op.aggregators).c_str());
+  if (op.aggregators_per_node > 0)
+    MPI_Info_set(info, "cb_config_list",
+                 ("*:" + std::to_string(op.aggregators_per_node)).c_str());
+  if (op.stripe_count > 0)
+    MPI_Info_set(info, "striping_factor", std::to_string(op.stripe_count).c_str());
+  if (op.stripe_size > 0)
+    MPI_Info_set(info, "striping_unit", std::to_string(op.stripe_size).c_str());
+}
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn static hid_t CreateDatasetProperties(const OutputParameters &op,
+//                                           const hsize_t *chunk)
+//  \brief creation properties of a 5D variable dataset: H5P_DEFAULT for the contiguous
+//  layout, otherwise chunks of one MeshBlock each with the requested filters.  Since
+//  every chunk is owned by exactly one rank, each rank compresses its own blocks during
+//  the collective H5Dwrite and no chunk has to be shipped between ranks.
+
+static hid_t CreateDatasetProperties(const OutputParameters &op, const hsize_t *chunk) {
+  if (!op.chunking) return H5P_DEFAULT;
+  std::stringstream msg;
+#if defined(MPI_PARALLEL) && !H5_VERSION_GE(1, 10, 2)
+  if (op.compression != "none") {
+    msg << "### FATAL ERROR in ATHDF5Output::WriteOutputFile" << std::endl
+        << "Parallel HDF5 older than 1.10.2 cannot write compressed datasets; set "
+        << "compression = none in output block '" << op.block_name << "'" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+#endif
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, 5, chunk);
+  if (op.compression == "deflate") {
+    H5Pset_deflate(dcpl, op.compression_level);
+  } else if (op.compression == "shuffle_deflate") {
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, op.compression_level);
+  } else if (op.compression == "lz4") {
+    if (H5Zfilter_avail(H5Z_FILTER_LZ4) <= 0) {
+      msg << "### FATAL ERROR in ATHDF5Output::WriteOutputFile" << std::endl
+          << "The LZ4 filter plugin requested in output block '" << op.block_name
+          << "' was not found; check HDF5_PLUGIN_PATH" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    H5Pset_shuffle(dcpl);
+    H5Pset_filter(dcpl, H5Z_FILTER_LZ4, H5Z_FLAG_MANDATORY, 0, nullptr);
+  }
+  return dcpl;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> static std::uint64_t HashData(const T *data,
+//                                                        const hsize_t n)
+//  \brief FNV-1a hash of the bytes of n values, taken eight bytes at a time; incremental
+//  outputs compare it with the hash of the last written content to detect changes
+
+template <typename T>
+static std::uint64_t HashData(const T *data, const hsize_t n) {
+  const std::uint64_t prime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+  const char *bytes = reinterpret_cast<const char *>(data);
+  const std::size_t size = n*sizeof(T);
+  std::size_t b = 0;
+  for (; b + sizeof(std::uint64_t) <= size; b += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes + b, sizeof(word));
+    hash = (hash ^ word)*prime;
+  }
+  for (; b < size; b++) hash = (hash ^ static_cast<unsigned char>(bytes[b]))*prime;
+  return hash;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> static void QuantizeData(T *data, const hsize_t n,
+//                                                    const Real tolerance)
+//  \brief rounds every value to a multiple of the largest power of two q with
+//  q/2 <= tolerance.  The absolute error is bounded by the tolerance and, q being a
+//  power of two, the trailing mantissa bits become zero for the filters to squeeze out.
+
+template <typename T>
+static void QuantizeData(T *data, const hsize_t n, const Real tolerance) {
+  const T q = std::exp2(std::floor(std::log2(2.0*tolerance)));
+  const T inv_q = 1.0/q;
+#pragma omp parallel for
+  for (hsize_t i = 0; i < n; i++) data[i] = q*std::nearbyint(data[i]*inv_q);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> static void BitRoundData(T *data, const hsize_t n,
+//                                                    const int bits)
+//  \brief keeps the leading "bits" mantissa bits of every value, rounding to nearest,
+//  and zeroes the rest: the relative error is at most 2^-(bits+1).  Infinities and NaNs
+//  are left alone.
+
+template <typename T>
+static void BitRoundData(T *data, const hsize_t n, const int bits) {
+  using Bits = typename std::conditional<sizeof(T) == 8, std::uint64_t,
+                                         std::uint32_t>::type;
+  static_assert(sizeof(Bits) == sizeof(T), "unsupported floating point size");
+  const int mantissa = std::numeric_limits<T>::digits - 1;
+  const int drop = mantissa - bits;
+  if (drop < 1) return;  // float32 output already holds fewer bits than requested
+  const Bits half = Bits(1) << (drop - 1);
+  const Bits mask = ~((Bits(1) << drop) - 1);
+  const Bits exponent = ~Bits(0) >> 1 & ~((Bits(1) << mantissa) - 1);
+#pragma omp parallel for
+  for (hsize_t i = 0; i < n; i++) {
+    Bits b;
+    std::memcpy(&b, &data[i], sizeof(b));
+    if ((b & exponent) == exponent) continue;
+    b = (b + half) & mask;
+    std::memcpy(&data[i], &b, sizeof(b));
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> static hsize_t StageVariable(T *dst, MeshBlock *pmb, ...)
+//  \brief copies variable "label" of every block in the list starting at pmb into dst,
+//  block after block with the components fastest, converting to T on the way.  Returns
+//  the number of values staged.
+
+template <typename T>
+static hsize_t StageVariable(T *dst, MeshBlock *pmb, const std::string &label,
+                             const int out_is, const int out_ie, const int out_js,
+                             const int out_je, const int out_ks, const int out_ke) {
+  const int ni = out_ie - out_is + 1;
+  hsize_t index = 0;
+  for (; pmb != nullptr; pmb = pmb->next) {
+    auto ci = ContainerIterator<Real>(pmb->real_container,{Metadata::Graphics});
+    for (auto &v : ci.vars) {
+      if (v->label() != label) continue;
+      const int vlen = v->GetDim4();
+      for (int k = out_ks; k <= out_ke; k++) {
+        for (int j = out_js; j <= out_je; j++) {
+          T *row = dst + index;
+          if (vlen == 1) {
+            const Real *src = &(*v)(k,j,out_is);
+#pragma omp simd
+            for (int i = 0; i < ni; i++) row[i] = static_cast<T>(src[i]);
+          } else {
+            for (int l = 0; l < vlen; l++) {
+              const Real *src = &(*v)(l,k,j,out_is);
+              for (int i = 0; i < ni; i++) row[i*vlen + l] = static_cast<T>(src[i]);
+            }
+          }
+          index += static_cast<hsize_t>(ni)*vlen;
+        }
+      }
+    }
+  }
+  return index;
+}
 
 //----------------------------------------------------------------------------------------
 //! \fn void ATHDF5Output:::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
@@ -297,6 +528,16 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   int max_blocks_local = pm->nblist[Globals::my_rank];
   int num_blocks_local = 0;
 
+  // with a stage directory every rank writes its blocks to a file of its own there,
+  // after the previous file has been drained to the parallel file system
+  const bool staged = !output_params.stage_dir.empty();
+  const bool rank_files = staged && Globals::nranks > 1;
+  if (staged) {
+    WaitForDrain();
+    PublishXDMF();
+  }
+  if (rank_files) max_blocks_global = max_blocks_local;
+
   // shooting a blank just for getting the variable names
   out_is = pmb->is; out_ie = pmb->ie;
   out_js = pmb->js; out_je = pmb->je;
@@ -336,43 +577,44 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   filename.append(file_number.str());
   filename.append(".athdf");
 
+  // the file this rank writes: the output file itself, or its file in the stage
+  // directory, which is drained to the final location once it is complete
+  std::string final_name = filename;
+  std::string write_name = filename;
+  if (staged) {
+    final_name = RankFileName(filename, Globals::my_rank);
+    write_name = output_params.stage_dir + "/"
+                 + final_name.substr(final_name.find_last_of('/') + 1);
+  }
+
   hid_t file;
   hid_t acc_file = H5P_DEFAULT;
 
 #ifdef MPI_PARALLEL
-  /* set the file access template for parallel IO access */
-  acc_file = H5Pcreate(H5P_FILE_ACCESS);
-
-  /* ---------------------------------------------------------------------
-     platform dependent code goes here -- the access template must be
-     tuned for a particular filesystem blocksize.  some of these
-     numbers are guesses / experiments, others come from the file system
-     documentation.
-
-     The sieve_buf_size should be equal a multiple of the disk block size
-     ---------------------------------------------------------------------- */
-
-  /* create an MPI_INFO object -- on some platforms it is useful to
-     pass some information onto the underlying MPI_File_open call */
-  MPI_Info FILE_INFO_TEMPLATE;
   int ierr;
-  MPI_Status stat;
-  ierr = MPI_Info_create(&FILE_INFO_TEMPLATE);
-  ierr = H5Pset_sieve_buf_size(acc_file, 262144);
-  ierr = H5Pset_alignment(acc_file, 524288, 262144);
-
-  ierr = MPI_Info_set(FILE_INFO_TEMPLATE, "access_style", "write_once");
-   ierr = MPI_Info_set(FILE_INFO_TEMPLATE, "collective_buffering", "true");
-   ierr = MPI_Info_set(FILE_INFO_TEMPLATE, "cb_block_size", "1048576");
-   ierr = MPI_Info_set(FILE_INFO_TEMPLATE, "cb_buffer_size", "4194304");
-
-  /* tell the HDF5 library that we want to use MPI-IO to do the writing */
-  ierr = H5Pset_fapl_mpio(acc_file, MPI_COMM_WORLD, FILE_INFO_TEMPLATE);
-  ierr = H5Pset_fapl_mpio(acc_file, MPI_COMM_WORLD, MPI_INFO_NULL);
+  MPI_Info FILE_INFO_TEMPLATE = MPI_INFO_NULL;
+  if (!rank_files) {
+    /* set the file access template for parallel IO access */
+    acc_file = H5Pcreate(H5P_FILE_ACCESS);
+
+    /* create an MPI_INFO object to pass the aggregation and striping settings of the
+       output block onto the underlying MPI_File_open call */
+    ierr = MPI_Info_create(&FILE_INFO_TEMPLATE);
+    SetFileAccessHints(output_params, acc_file, FILE_INFO_TEMPLATE);
+
+    /* tell the HDF5 library that we want to use MPI-IO to do the writing */
+    ierr = H5Pset_fapl_mpio(acc_file, MPI_COMM_WORLD, FILE_INFO_TEMPLATE);
+  }
 #endif
 
   // now open the file
-  file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, acc_file);
+  file = H5Fcreate(write_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, acc_file);
+  if (file < 0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in ATHDF5Output::WriteOutputFile" << std::endl
+        << "Output file '" << write_name << "' could not be created" << std::endl;
+    ATHENA_ERROR(msg);
+  }
 
   // write timestep relevant attributes
   hsize_t dims[4]={1,0,0,0};
@@ -390,7 +632,7 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   status = writeH5AI32("NCycle", &pm->ncycle, file, localDSpace, myDSet);
   status = writeH5AF64("Time", &pm->time, file, localDSpace, myDSet);
   status = writeH5AI32("NumDims", &pm->ndim, file, localDSpace, myDSet);
-  status = writeH5AI32("NumMeshBlocks", &pm->nbtotal, file, localDSpace, myDSet);
+  status = writeH5AI32("NumMeshBlocks", &max_blocks_global, file, localDSpace, myDSet);
   status = writeH5AI32("MaxLevel", &max_level, file, localDSpace, myDSet);
   // write whether we include ghost cells or not
   int iTmp = (output_params.include_ghost_zones?1:0);
@@ -401,9 +643,10 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   // close scalar space
   status = H5Sclose(localDSpace);
-  hsize_t nPE = Globals::nranks;
+  hsize_t nPE = rank_files ? 1 : Globals::nranks;
   localDSpace = H5Screate_simple(1, &nPE, NULL);
-  status = writeH5AI32("BlocksPerPE", pm->nblist, file, localDSpace, myDSet);
+  status = writeH5AI32("BlocksPerPE", rank_files ? &max_blocks_local : pm->nblist, file,
+                       localDSpace, myDSet);
   status = H5Sclose(localDSpace);
 
 
@@ -432,6 +675,10 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   Real *tmpData = new Real[(nx1+1)*(nx2+1)*(nx3+1)*maxV*num_blocks_local];
   for(int i=0; i<(nx1+1)*(nx2+1)*(nx3+1)*maxV*num_blocks_local; i++) tmpData[i] = -1.25;
+  // staging buffer of the variables stored as float32
+  std::vector<float> tmpFloat;
+  if (output_params.single_precision)
+    tmpFloat.resize(static_cast<std::size_t>(nx1)*nx2*nx3*maxV*num_blocks_local);
 
   // Write mesh coordinates to file
   hsize_t local_start[5], global_count[5], local_count[5];
@@ -443,45 +690,66 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   local_start[2] = 0;
   local_start[3] = 0;
   local_start[4] = 0;
-  for( int i=0; i<Globals::my_rank; i++) {
-    local_start[0] += pm->nblist[i];
-  }
+  if (!rank_files) local_start[0] = pm->nslist[Globals::my_rank];
   hid_t property_list = H5Pcreate(H5P_DATASET_XFER);
 #ifdef MPI_PARALLEL
-  H5Pset_dxpl_mpio(property_list, H5FD_MPIO_COLLECTIVE);
+  if (!rank_files) H5Pset_dxpl_mpio(property_list, H5FD_MPIO_COLLECTIVE);
 #endif
 
 
   // set starting poing in hyperslab for our blocks and
   // number of blocks on our PE
 
+  // incremental outputs link the datasets that have not changed since they were last
+  // written to the file holding them.  A new MeshBlock tree, or in a rank file a new
+  // range of blocks, changes the shape and meaning of every dataset.
+  const std::string this_file = final_name.substr(final_name.find_last_of('/') + 1);
+  if (!output_params.incremental || pm->mesh_generation != mesh_generation_
+      || (rank_files && (local_start_ != pm->nslist[Globals::my_rank]
+                         || num_blocks_ != num_blocks_local))) {
+    dataset_file_.clear();
+    dataset_hash_.clear();
+  }
+  mesh_generation_ = pm->mesh_generation;
+  local_start_ = pm->nslist[Globals::my_rank];
+  num_blocks_ = num_blocks_local;
 
-  //open locations tab
-  gLocations = H5Gcreate(file, "/Locations", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
-  // write X coordinates
   local_count[0] = num_blocks_local;
   global_count[0] = max_blocks_global;
 
-  pmb = pm->pblock;
-  LOADVARIABLE(tmpData, pmb, pmb->pcoord->x1f, out_is, out_ie+1, 0, 0, 0, 0);
-  local_count[1] = global_count[1] = nx1+1;
-  WRITEH5SLAB("x", tmpData, gLocations, local_start, local_count, global_count, property_list);
+  if (dataset_file_.count("/Locations") > 0) {
+    // the coordinates only change with the mesh
+    H5Lcreate_external(dataset_file_["/Locations"].c_str(), "/Locations", file,
+                       "/Locations", H5P_DEFAULT, H5P_DEFAULT);
+  } else {
+    // open locations tab
+    gLocations = H5Gcreate(file, "/Locations", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
-  // write Y coordinates
-  pmb = pm->pblock;
-  LOADVARIABLE(tmpData, pmb, pmb->pcoord->x2f, out_js, out_je+1, 0, 0, 0, 0);
-  local_count[1] = global_count[1] = nx2+1;
-  WRITEH5SLAB("y", tmpData, gLocations, local_start, local_count, global_count, property_list);
+    // write X coordinates
+    pmb = pm->pblock;
+    LOADVARIABLE(tmpData, pmb, pmb->pcoord->x1f, out_is, out_ie+1, 0, 0, 0, 0);
+    local_count[1] = global_count[1] = nx1+1;
+    WRITEH5SLAB("x", tmpData, gLocations, local_start, local_count, global_count,
+                property_list);
 
-  // write Z coordinates
-  pmb = pm->pblock;
-  LOADVARIABLE(tmpData, pmb, pmb->pcoord->x3f, out_ks, out_ke+1, 0, 0, 0, 0);
-  local_count[1] = global_count[1] = nx3+1;
-  WRITEH5SLAB("z", tmpData, gLocations, local_start, local_count, global_count, property_list);
+    // write Y coordinates
+    pmb = pm->pblock;
+    LOADVARIABLE(tmpData, pmb, pmb->pcoord->x2f, out_js, out_je+1, 0, 0, 0, 0);
+    local_count[1] = global_count[1] = nx2+1;
+    WRITEH5SLAB("y", tmpData, gLocations, local_start, local_count, global_count,
+                property_list);
 
-  //close locations tab
-  H5Gclose(gLocations);
+    // write Z coordinates
+    pmb = pm->pblock;
+    LOADVARIABLE(tmpData, pmb, pmb->pcoord->x3f, out_ks, out_ke+1, 0, 0, 0, 0);
+    local_count[1] = global_count[1] = nx3+1;
+    WRITEH5SLAB("z", tmpData, gLocations, local_start, local_count, global_count,
+                property_list);
+
+    // close locations tab
+    H5Gclose(gLocations);
+    if (output_params.incremental) dataset_file_["/Locations"] = this_file;
+  }
 
   //write variables
   // create persistent spaces
@@ -506,8 +774,6 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   // If I'm wrong about this, we can always rewrite this later.
   // Sriram
 
-  const hsize_t varSize = nx3*nx2*nx1;
-
   // this is a stupidly complicated multi-pass through the variable
   // list, but again will revisit when the time comes to redo
   for (auto &vwrite : ciX.vars) { // for each variable we write
@@ -525,42 +791,53 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
       vGlobalSpace = H5Screate_simple(5, global_count, NULL);
     }
 
-    while (pmb != nullptr) { // for every block
-      auto ci = ContainerIterator<Real>(pmb->real_container,{Metadata::Graphics});
-      for (auto &v : ci.vars) {
-        std::string name=v->label();
-        if (name.compare(vWriteName) != 0) {
-          // skip, not interested in this variable
-          continue;
-        }
-        hsize_t index = pmb->lid*varSize*vlen;
-        if (vlen == 1) {
-          for (int k = out_ks; k <= out_ke; k++) {
-            for (int j = out_js; j <= out_je; j++) {
-              for (int i = out_is; i <= out_ie; i++,index++) {
-                tmpData[index] = (*v)(k,j,i);
-              }
-            }
-          }
-        } else { // shuffle and use new dataspace
-          for (int k = out_ks; k <= out_ke; k++) {
-            for (int j = out_js; j <= out_je; j++) {
-              for (int i = out_is; i <= out_ie; i++) {
-                for (int l = 0; l < vlen; l++, index++) {
-                  tmpData[index] = (*v)(l,k,j,i);
-                }
-              }
-            }
-          }
-        }
+    // stage this rank's blocks, converting to float32 if requested, and quantize them
+    // before they reach the filters in the collective write
+    const bool single = IsSinglePrecision(output_params, vWriteName);
+    const bool lossy = IsLossy(output_params, vWriteName);
+    const hsize_t count = single
+        ? StageVariable(tmpFloat.data(), pmb, vWriteName, out_is, out_ie, out_js, out_je,
+                        out_ks, out_ke)
+        : StageVariable(tmpData, pmb, vWriteName, out_is, out_ie, out_js, out_je,
+                        out_ks, out_ke);
+    if (lossy && output_params.lossy == "quantize") {
+      if (single) QuantizeData(tmpFloat.data(), count, output_params.lossy_tolerance);
+      else        QuantizeData(tmpData, count, output_params.lossy_tolerance);
+    } else if (lossy) {
+      if (single) BitRoundData(tmpFloat.data(), count, output_params.lossy_bits);
+      else        BitRoundData(tmpData, count, output_params.lossy_bits);
+    }
+    // an unchanged variable on all ranks is linked to the file that holds it
+    int unchanged = 0;
+    if (output_params.incremental) {
+      const std::uint64_t hash = single ? HashData(tmpFloat.data(), count)
+                                        : HashData(tmpData, count);
+      unchanged = (dataset_file_.count(vWriteName) > 0
+                   && dataset_hash_[vWriteName] == hash);
+      dataset_hash_[vWriteName] = hash;
+#ifdef MPI_PARALLEL
+      if (!rank_files)
+        MPI_Allreduce(MPI_IN_PLACE, &unchanged, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+#endif
+    }
+    if (unchanged) {
+      H5Lcreate_external(dataset_file_[vWriteName].c_str(), ("/" + vWriteName).c_str(),
+                         file, vWriteName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+    } else {
+      // write dataset to file, chunked by MeshBlock if requested
+      const hsize_t chunk[5] = {1, global_count[1], global_count[2], global_count[3],
+                                vlen};
+      hid_t dcpl = CreateDatasetProperties(output_params, chunk);
+      if (single) {
+        WRITEH5SLAB2(vWriteName.c_str(), tmpFloat.data(), file, local_start, local_count,
+                     vLocalSpace, vGlobalSpace, property_list, dcpl, H5T_NATIVE_FLOAT);
+      } else {
+        WRITEH5SLAB2(vWriteName.c_str(), tmpData, file, local_start, local_count,
+                     vLocalSpace, vGlobalSpace, property_list, dcpl, H5T_NATIVE_DOUBLE);
       }
-      pmb = pmb->next;
+      if (dcpl != H5P_DEFAULT) H5Pclose(dcpl);
+      if (output_params.incremental) dataset_file_[vWriteName] = this_file;
     }
-    // write dataset to file
-    WRITEH5SLAB2(vWriteName.c_str(), tmpData, file,
-                 local_start, local_count,
-                 vLocalSpace, vGlobalSpace,
-                 property_list);
     if (vlen > 1 ) {
       H5Sclose(vLocalSpace);
       H5Sclose(vGlobalSpace);
@@ -572,12 +849,21 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
 #ifdef MPI_PARALLEL
   /* release the file access template */
-  ierr = H5Pclose(acc_file);
-  ierr = MPI_Info_free(&FILE_INFO_TEMPLATE);
+  if (!rank_files) {
+    ierr = H5Pclose(acc_file);
+    ierr = MPI_Info_free(&FILE_INFO_TEMPLATE);
+  }
 #endif
 
   H5Pclose(property_list);
   H5Fclose(file);
+  delete [] tmpData;
+
+  // hand the staged file over to the drain and continue
+  if (staged) {
+    StartDrain(write_name, final_name);
+    xdmf_pending_ = filename + ".xdmf";
+  }
 
   // generate XDMF companion file
   (void) genXDMF(filename, pm);
@@ -589,6 +875,109 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn std::string ATHDF5Output::RankFileName(const std::string &hdfFile, int rank)
+//  \brief name of the file of "rank" when every rank writes its own file, i.e. when
+//  staging with more than one rank: "<basename>.<id>.<number>.<rank>.athdf"
+
+std::string ATHDF5Output::RankFileName(const std::string &hdfFile, int rank) const {
+  if (output_params.stage_dir.empty() || Globals::nranks == 1) return hdfFile;
+  const std::string ext = ".athdf";
+  return hdfFile.substr(0, hdfFile.size() - ext.size()) + "." + std::to_string(rank)
+         + ext;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ATHDF5Output::StartDrain(const std::string &staged,
+//                                    const std::string &final_name)
+//  \brief moves the staged file to its final name in a background thread.  The copy is
+//  written next to the final file and renamed when complete, so that readers never see
+//  a partial file.
+
+void ATHDF5Output::StartDrain(const std::string &staged, const std::string &final_name) {
+  drain_ = std::thread([this, staged, final_name]() {
+    // a rename suffices when the stage directory is on the same file system
+    if (std::rename(staged.c_str(), final_name.c_str()) == 0) return;
+    const std::string part = final_name + ".part";
+    {
+      std::ifstream src(staged, std::ios::binary);
+      std::ofstream dst(part, std::ios::binary | std::ios::trunc);
+      if (src.is_open() && dst.is_open()) dst << src.rdbuf();
+      if (!src.is_open() || !dst) {
+        drain_error_ = "could not copy '" + staged + "' to '" + part + "'";
+        return;
+      }
+    }
+    if (std::rename(part.c_str(), final_name.c_str()) != 0) {
+      drain_error_ = "could not rename '" + part + "' to '" + final_name + "'";
+      return;
+    }
+    std::remove(staged.c_str());
+  });
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ATHDF5Output::WaitForDrain()
+//  \brief blocks until the previous staged file has reached its final location
+
+void ATHDF5Output::WaitForDrain() {
+  if (drain_.joinable()) drain_.join();
+  if (!drain_error_.empty()) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in ATHDF5Output::WaitForDrain" << std::endl
+        << "Draining output block '" << output_params.block_name << "' failed: "
+        << drain_error_ << std::endl;
+    drain_error_.clear();
+    ATHENA_ERROR(msg);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ATHDF5Output::PublishXDMF()
+//  \brief renames the XDMF of the drained output to its final name.  It references the
+//  files of all ranks, so readers must not see it before every rank's drain is done;
+//  collective, call after WaitForDrain()
+
+void ATHDF5Output::PublishXDMF() {
+  if (xdmf_pending_.empty()) return;
+#ifdef MPI_PARALLEL
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  const std::string part = xdmf_pending_ + ".part";
+  const std::string xdmf_name = xdmf_pending_;
+  xdmf_pending_.clear();
+  if (Globals::my_rank == 0 && std::rename(part.c_str(), xdmf_name.c_str()) != 0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in ATHDF5Output::PublishXDMF" << std::endl
+        << "Could not rename '" << part << "' to '" << xdmf_name << "'" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ATHDF5Output::FinishOutput()
+//  \brief drains the last staged file and publishes its XDMF; collective
+
+void ATHDF5Output::FinishOutput() {
+  WaitForDrain();
+  PublishXDMF();
+}
+
+// FinishOutput() publishes the last file.  Without it, e.g. when the run is aborting,
+// the drain is only joined: the other ranks may not be done, so the XDMF stays aside.
+ATHDF5Output::~ATHDF5Output() {
+  if (drain_.joinable()) drain_.join();
+  if (!drain_error_.empty()) {
+    std::cout << "### WARNING in ATHDF5Output::~ATHDF5Output" << std::endl
+              << "Draining output block '" << output_params.block_name << "' failed: "
+              << drain_error_ << std::endl;
+  }
+  if (!xdmf_pending_.empty() && Globals::my_rank == 0) {
+    std::cout << "### WARNING in ATHDF5Output::~ATHDF5Output" << std::endl
+              << "'" << xdmf_pending_ << ".part' was not renamed." << std::endl;
+  }
+}
 }
 #endif  // HDF5OUTPUT
 
@@ -16,11 +16,13 @@
 //========================================================================================
 //! \file history.cpp
 //  \brief writes history output data, volume-averaged quantities that are output
-//         frequently in time to trace their history.
+//         frequently in time to trace their history.  The quantities are declared per
+//         package with StateDescriptor::AddHistory().
 
 // C headers
 
 // C++ headers
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <iomanip>
@@ -30,123 +32,189 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
 #include "athena_arrays.hpp"
 #include "coordinates/coordinates.hpp"
 #include "globals.hpp"
+#include "interface/StateDescriptor.hpp"
+#include "kokkos_abstraction.hpp"
 #include "mesh/mesh.hpp"
 #include "outputs.hpp"
 
-// NEW_OUTPUT_TYPES:
+namespace parthenon {
+namespace {
+// history quantities reduced together in one pass over a block
+constexpr int kMaxFused = 16;
 
-// "3" for 1-KE, 2-KE, 3-KE additional columns (come before tot-E)
-#define NHISTORY_VARS ((NFIELD) + 3)
+struct HistoryValues {
+  Real v[kMaxFused];
+};
 
-namespace parthenon {
 //----------------------------------------------------------------------------------------
-//! \fn void OutputType::HistoryFile()
-//  \brief Writes a history file
+//! \class HistoryReduction
+//  \brief reduces up to kMaxFused history quantities over the interior cells of a block
+//  in a single par_reduce; Metric is one of the cell volume policies in coordinates.hpp
 
-void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
-  MeshBlock *pmb = pm->pblock;
-  Real real_max = std::numeric_limits<Real>::max();
-  Real real_min = std::numeric_limits<Real>::min();
-  AthenaArray<Real> vol(pmb->ncells1);
-  const int nhistory_output = NHISTORY_VARS + pm->nuser_history_output_;
-  std::unique_ptr<Real[]> hst_data(new Real[nhistory_output]);
-  // initialize built-in variable sums to 0.0
-  for (int n=0; n<NHISTORY_VARS; ++n) hst_data[n] = 0.0;
-  // initialize user-defined history outputs depending on the requested operation
-  for (int n=0; n<pm->nuser_history_output_; n++) {
-    switch (pm->user_history_ops_[n]) {
-      case UserHistoryOperation::sum:
-        hst_data[NHISTORY_VARS+n] = 0.0;
-        break;
-      case UserHistoryOperation::max:
-        hst_data[NHISTORY_VARS+n] = real_min;
-        break;
-      case UserHistoryOperation::min:
-        hst_data[NHISTORY_VARS+n] = real_max;
-        break;
+template <typename Metric>
+class HistoryReduction {
+ public:
+  using value_type = HistoryValues;
+
+  HistoryReduction(const Metric &metric, const int n, const Real *const *data,
+                   const HistoryQuantity *const *quantities, const int nx1,
+                   const int nx2) : metric_(metric), n_(n), nx1_(nx1), nx2_(nx2) {
+    for (int q=0; q<n; q++) {
+      data_[q] = data[q];
+      op_[q] = quantities[q]->op;
+      weighted_[q] = quantities[q]->volume_weighted;
     }
   }
 
-  // Loop over MeshBlocks
-  while (pmb != nullptr) {
-    // Sum history variables over cells.  Note ghost cells are never included in sums
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
-        pmb->pcoord->CellVolume(k, j, pmb->is, pmb->ie, vol);
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          // NEW_OUTPUT_TYPES:
-
-          hst_data[0] += 0.0;
-          hst_data[1] += 0.0;
-          hst_data[2] += 0.0;
-          hst_data[3] += 0.0;
-          // + partitioned KE by coordinate direction:
-          hst_data[4] += 0.0;
-          hst_data[5] += 0.0;
-          hst_data[6] += 0.0;
-        }
+  void operator()(const int k, const int j, const int i, value_type &val) const {
+    const Real vol = metric_.CellVolume(k, j, i);
+    const int c = i + nx1_*(j + nx2_*k);
+    for (int q=0; q<n_; q++) {
+      const Real x = data_[q][c];
+      switch (op_[q]) {
+        case UserHistoryOperation::sum:
+          val.v[q] += weighted_[q] ? x*vol : x;
+          break;
+        case UserHistoryOperation::max:
+          val.v[q] = (x > val.v[q]) ? x : val.v[q];
+          break;
+        case UserHistoryOperation::min:
+          val.v[q] = (x < val.v[q]) ? x : val.v[q];
+          break;
       }
     }
-    for (int n=0; n<pm->nuser_history_output_; n++) { // user-defined history outputs
-      if (pm->user_history_func_[n] != nullptr) {
-        Real usr_val = pm->user_history_func_[n](pmb, n);
-        switch (pm->user_history_ops_[n]) {
-          case UserHistoryOperation::sum:
-            // TODO(felker): this should automatically volume-weight the sum, like the
-            // built-in variables. But existing user-defined .hst fns are currently
-            // weighting their returned values.
-            hst_data[NHISTORY_VARS+n] += usr_val;
-            break;
-          case UserHistoryOperation::max:
-            hst_data[NHISTORY_VARS+n] = std::max(usr_val, hst_data[NHISTORY_VARS+n]);
-            break;
-          case UserHistoryOperation::min:
-            hst_data[NHISTORY_VARS+n] = std::min(usr_val, hst_data[NHISTORY_VARS+n]);
-            break;
-        }
+  }
+
+  void init(value_type &val) const {
+    for (int q=0; q<n_; q++) val.v[q] = Identity(op_[q]);
+  }
+
+  void join(volatile value_type &dst, const volatile value_type &src) const {
+    for (int q=0; q<n_; q++) {
+      switch (op_[q]) {
+        case UserHistoryOperation::sum:
+          dst.v[q] += src.v[q];
+          break;
+        case UserHistoryOperation::max:
+          if (src.v[q] > dst.v[q]) dst.v[q] = src.v[q];
+          break;
+        case UserHistoryOperation::min:
+          if (src.v[q] < dst.v[q]) dst.v[q] = src.v[q];
+          break;
       }
     }
-    pmb = pmb->next;
-  }  // end loop over MeshBlocks
-
-#ifdef MPI_PARALLEL
-  // sum built-in/predefined hst_data[] over all ranks
-  if (Globals::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, hst_data.get(), NHISTORY_VARS, MPI_ATHENA_REAL, MPI_SUM, 0,
-               MPI_COMM_WORLD);
-  } else {
-    MPI_Reduce(hst_data.get(), hst_data.get(), NHISTORY_VARS, MPI_ATHENA_REAL, MPI_SUM,
-               0, MPI_COMM_WORLD);
   }
-  // apply separate chosen operations to each user-defined history output
-  for (int n=0; n<pm->nuser_history_output_; n++) {
-    Real *usr_hst_data = hst_data.get() + NHISTORY_VARS + n;
-    MPI_Op usr_op;
-    switch (pm->user_history_ops_[n]) {
-      case UserHistoryOperation::sum:
-        usr_op = MPI_SUM;
-        break;
+
+  static Real Identity(const UserHistoryOperation op) {
+    switch (op) {
       case UserHistoryOperation::max:
-        usr_op = MPI_MAX;
-        break;
+        return std::numeric_limits<Real>::lowest();
       case UserHistoryOperation::min:
-        usr_op = MPI_MIN;
-        break;
+        return std::numeric_limits<Real>::max();
+      default:
+        return 0.0;
     }
-    if (Globals::my_rank == 0) {
-      MPI_Reduce(MPI_IN_PLACE, usr_hst_data, 1, MPI_ATHENA_REAL, usr_op, 0,
-                 MPI_COMM_WORLD);
-    } else {
-      MPI_Reduce(usr_hst_data, usr_hst_data, 1, MPI_ATHENA_REAL, usr_op, 0,
-                 MPI_COMM_WORLD);
+  }
+
+ private:
+  const Metric metric_;
+  int n_, nx1_, nx2_;
+  const Real *data_[kMaxFused];
+  UserHistoryOperation op_[kMaxFused];
+  bool weighted_[kMaxFused];
+};
+
+// combines a per-block value into the running value of a column
+void Combine(const UserHistoryOperation op, const Real x, Real *acc) {
+  switch (op) {
+    case UserHistoryOperation::sum:
+      *acc += x;
+      break;
+    case UserHistoryOperation::max:
+      *acc = std::max(x, *acc);
+      break;
+    case UserHistoryOperation::min:
+      *acc = std::min(x, *acc);
+      break;
+  }
+}
+
+// reduces quantities [first, first+n) of one block into the per-rank columns
+template <typename Metric>
+void ReduceBlock(MeshBlock *pmb, const Metric &metric,
+                 const std::vector<const HistoryQuantity *> &quantities, const int first,
+                 const int n, Real *columns) {
+  Container<Real> &rc = pmb->real_container;
+  const Real *data[kMaxFused];
+  int nx1 = 0, nx2 = 0;
+  for (int q=0; q<n; q++) {
+    const HistoryQuantity &h = *quantities[first + q];
+    Variable<Real> &v = rc.Get(h.field);
+    nx1 = v.GetDim1();
+    nx2 = v.GetDim2();
+    if (h.component < 0 || h.component >= v.GetDim4()) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in HistoryOutput::WriteOutputFile" << std::endl
+          << "History quantity '" << h.name << "' reduces component " << h.component
+          << " of '" << h.field << "', which has " << v.GetDim4() << std::endl;
+      ATHENA_ERROR(msg);
     }
+    data[q] = v.data() + static_cast<std::size_t>(h.component)*v.GetDim3()*nx2*nx1;
   }
+  HistoryValues result;
+  par_reduce("HistoryOutput::ReduceBlock", Kokkos::DefaultHostExecutionSpace(),
+             pmb->ks, pmb->ke, pmb->js, pmb->je, pmb->is, pmb->ie,
+             HistoryReduction<Metric>(metric, n, data, &quantities[first], nx1, nx2),
+             result);
+  for (int q=0; q<n; q++) Combine(quantities[first + q]->op, result.v[q], &columns[q]);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \struct HistoryOutput::Reduction
+//  \brief the columns of one history line while they are reduced across ranks.  The
+//  columns are grouped by operation, one non-blocking MPI_Ireduce per group, and the
+//  line is written by rank 0 once all of them have completed.
+
+struct HistoryOutput::Reduction {
+  Real time, dt;
+  bool header;
+  std::vector<std::string> names;
+  std::vector<UserHistoryOperation> ops;
+  std::vector<Real> group[3];  // sum, max and min columns, in column order
+#ifdef MPI_PARALLEL
+  MPI_Request requests[3];
+#endif
+};
+
+HistoryOutput::HistoryOutput(OutputParameters oparams) : OutputType(oparams) {}
+
+// FinishOutput() writes the last line.  If it was not called, e.g. because the run is
+// aborting, the line is dropped: waiting for the other ranks here could hang or throw.
+HistoryOutput::~HistoryOutput() {
+  if (pending_ != nullptr && Globals::my_rank == 0) {
+    std::cout << "### WARNING in HistoryOutput::~HistoryOutput" << std::endl
+              << "The history line at time " << pending_->time << " was not written."
+              << std::endl;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HistoryOutput::Complete()
+//  \brief waits for the pending cross-rank reduction, if any, and writes its line
+
+void HistoryOutput::Complete() {
+  if (pending_ == nullptr) return;
+  Reduction &r = *pending_;
+#ifdef MPI_PARALLEL
+  MPI_Waitall(3, r.requests, MPI_STATUSES_IGNORE);
 #endif
 
   // only the master rank writes the file
@@ -166,34 +234,107 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
     }
 
     // If this is the first output, write header
-    if (output_params.file_number == 0) {
-      // NEW_OUTPUT_TYPES:
-
+    if (r.header) {
       int iout = 1;
       std::fprintf(pfile,"# Athena++ history data\n"); // descriptor is first line
       std::fprintf(pfile,"# [%d]=time     ", iout++);
       std::fprintf(pfile,"[%d]=dt       ", iout++);
-      std::fprintf(pfile,"[%d]=mass     ", iout++);
-      std::fprintf(pfile,"[%d]=1-mom    ", iout++);
-      std::fprintf(pfile,"[%d]=2-mom    ", iout++);
-      std::fprintf(pfile,"[%d]=3-mom    ", iout++);
-      std::fprintf(pfile,"[%d]=1-KE     ", iout++);
-      std::fprintf(pfile,"[%d]=2-KE     ", iout++);
-      std::fprintf(pfile,"[%d]=3-KE     ", iout++);
-      for (int n=0; n<pm->nuser_history_output_; n++)
-        std::fprintf(pfile,"[%d]=%-8s", iout++,
-                     pm->user_history_output_names_[n].c_str());
+      for (auto &name : r.names)
+        std::fprintf(pfile,"[%d]=%-8s", iout++, name.c_str());
       std::fprintf(pfile,"\n");                              // terminate line
     }
 
     // write history variables
-    std::fprintf(pfile, output_params.data_format.c_str(), pm->time);
-    std::fprintf(pfile, output_params.data_format.c_str(), pm->dt);
-    for (int n=0; n<nhistory_output; ++n)
-      std::fprintf(pfile, output_params.data_format.c_str(), hst_data[n]);
+    std::fprintf(pfile, output_params.data_format.c_str(), r.time);
+    std::fprintf(pfile, output_params.data_format.c_str(), r.dt);
+    std::size_t next[3] = {0, 0, 0};
+    for (auto op : r.ops) {
+      const int g = static_cast<int>(op);
+      std::fprintf(pfile, output_params.data_format.c_str(), r.group[g][next[g]++]);
+    }
     std::fprintf(pfile,"\n"); // terminate line
     std::fclose(pfile);
   }
+  pending_.reset();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//  \brief reduces the history quantities declared by the packages and the enrolled user
+//  history functions over the blocks of this rank and starts their reduction across
+//  ranks.  The line is written once that has completed, at the latest at the next
+//  history output, so the ranks do not wait for each other here.
+
+void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+  Complete();
+
+  // columns: the quantities of all packages, then the user history functions
+  std::vector<const HistoryQuantity *> quantities;
+  for (auto &pkg : pm->packages) {
+    for (auto &h : pkg.second->AllHistory()) quantities.push_back(&h);
+  }
+  const int nquantities = static_cast<int>(quantities.size());
+  const int ncolumns = nquantities + pm->nuser_history_output_;
+
+  auto r = std::make_unique<Reduction>();
+  r->time = pm->time;
+  r->dt = pm->dt;
+  r->header = (output_params.file_number == 0);
+  for (auto h : quantities) {
+    r->names.push_back(h->name);
+    r->ops.push_back(h->op);
+  }
+  for (int n=0; n<pm->nuser_history_output_; n++) {
+    r->names.push_back(pm->user_history_output_names_[n]);
+    r->ops.push_back(pm->user_history_ops_[n]);
+  }
+  std::vector<Real> columns(ncolumns);
+  for (int n=0; n<ncolumns; n++)
+    columns[n] = HistoryReduction<UniformCartesianMetric>::Identity(r->ops[n]);
+
+  // Loop over MeshBlocks.  Note ghost cells are never included in the reductions
+  for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+    Coordinates *pco = pmb->pcoord.get();
+    for (int first=0; first<nquantities; first+=kMaxFused) {
+      const int n = std::min(kMaxFused, nquantities - first);
+      if (pco->IsUniformCartesian()) {
+        ReduceBlock(pmb, UniformCartesianMetric(*pco), quantities, first, n,
+                    &columns[first]);
+      } else {
+        ReduceBlock(pmb, pco->GetCachedMetric(), quantities, first, n,
+                    &columns[first]);
+      }
+    }
+    for (int n=0; n<pm->nuser_history_output_; n++) { // user-defined history outputs
+      if (pm->user_history_func_[n] != nullptr) {
+        // TODO(felker): this should automatically volume-weight the sum, like the
+        // package quantities. But existing user-defined .hst fns are currently
+        // weighting their returned values.
+        Combine(pm->user_history_ops_[n], pm->user_history_func_[n](pmb, n),
+                &columns[nquantities + n]);
+      }
+    }
+  }
+
+  for (int n=0; n<ncolumns; n++)
+    r->group[static_cast<int>(r->ops[n])].push_back(columns[n]);
+  pending_ = std::move(r);
+
+#ifdef MPI_PARALLEL
+  const MPI_Op mpi_ops[3] = {MPI_SUM, MPI_MAX, MPI_MIN};
+  for (int g=0; g<3; g++) {
+    std::vector<Real> &buf = pending_->group[g];
+    if (Globals::my_rank == 0) {
+      MPI_Ireduce(MPI_IN_PLACE, buf.data(), static_cast<int>(buf.size()),
+                  MPI_ATHENA_REAL, mpi_ops[g], 0, MPI_COMM_WORLD, &pending_->requests[g]);
+    } else {
+      MPI_Ireduce(buf.data(), nullptr, static_cast<int>(buf.size()), MPI_ATHENA_REAL,
+                  mpi_ops[g], 0, MPI_COMM_WORLD, &pending_->requests[g]);
+    }
+  }
+#else
+  Complete();
+#endif
 
   // increment counters, clean up
   output_params.file_number++;
@@ -202,4 +343,4 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
   return;
 }
-}
+} // namespace parthenon
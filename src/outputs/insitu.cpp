@@ -0,0 +1,369 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file insitu.cpp
+//  \brief writes reductions of the Graphics variables instead of full snapshots: 2D
+//  slices and column integrals on a uniform grid, and every MeshBlock downsampled by a
+//  fixed factor.  Each rank reduces its own blocks, the results are summed or gathered
+//  on rank 0, and rank 0 writes one small HDF5 file per output.
+
+// C++ headers
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+// Athena++ headers
+#include "athena.hpp"
+#include "athena_arrays.hpp"
+#include "coordinates/coordinates.hpp"
+#include "globals.hpp"
+#include "interface/ContainerIterator.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+#include "parameter_input.hpp"
+
+// Only proceed if HDF5 output enabled
+#ifdef HDF5OUTPUT
+
+#include "hdf5.h"
+
+namespace parthenon {
+namespace {
+// HDF5 type of Real
+hid_t RealType() {
+  return (sizeof(Real) == sizeof(double)) ? H5T_NATIVE_DOUBLE : H5T_NATIVE_FLOAT;
+}
+
+//! \struct Plane
+//  \brief a slice or column integral normal to direction "axis" (0, 1, 2 for x1, x2, x3)
+
+struct Plane {
+  int axis;
+  bool projection;
+  Real position;  // of the slice
+  std::string name;
+};
+
+// the two directions spanning the plane normal to "axis", in increasing order
+inline int FirstInPlane(const int axis) { return (axis == 0) ? 1 : 0; }
+inline int SecondInPlane(const int axis) { return (axis == 2) ? 1 : 2; }
+
+void WriteAttribute(hid_t loc, const char *name, hid_t type, const hsize_t n,
+                    const void *data) {
+  hid_t space = H5Screate_simple(1, &n, nullptr);
+  hid_t attr = H5Acreate(loc, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, type, data);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+void WriteDataset(hid_t loc, const std::string &name, hid_t type, const int ndims,
+                  const hsize_t *dims, const void *data) {
+  hid_t space = H5Screate_simple(ndims, dims, nullptr);
+  hid_t dset = H5Dcreate(loc, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT,
+                         H5P_DEFAULT);
+  H5Dwrite(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  H5Dclose(dset);
+  H5Sclose(space);
+}
+
+// sums buf over all ranks into buf on rank 0
+void ReduceToRoot(std::vector<Real> *buf) {
+#ifdef MPI_PARALLEL
+  if (Globals::my_rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, buf->data(), static_cast<int>(buf->size()),
+               MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(buf->data(), nullptr, static_cast<int>(buf->size()), MPI_ATHENA_REAL,
+               MPI_SUM, 0, MPI_COMM_WORLD);
+  }
+#endif
+}
+
+// concatenates the per-block records of all ranks in gid order on rank 0; every block
+// contributes "per_block" values of type T
+template <typename T>
+std::vector<T> GatherBlocks(const std::vector<T> &local, const int per_block,
+                            const int *nblist, const int nbtotal) {
+  std::vector<T> all;
+#ifdef MPI_PARALLEL
+  std::vector<int> counts, displs;
+  if (Globals::my_rank == 0) {
+    all.resize(static_cast<std::size_t>(nbtotal)*per_block);
+    counts.resize(Globals::nranks);
+    displs.resize(Globals::nranks);
+    int offset = 0;
+    for (int r = 0; r < Globals::nranks; r++) {
+      counts[r] = nblist[r]*per_block*static_cast<int>(sizeof(T));
+      displs[r] = offset;
+      offset += counts[r];
+    }
+  }
+  MPI_Gatherv(local.data(), static_cast<int>(local.size()*sizeof(T)), MPI_BYTE,
+              all.data(), counts.data(), displs.data(), MPI_BYTE, 0, MPI_COMM_WORLD);
+#else
+  all = local;
+#endif
+  return all;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AccumulatePlane(MeshBlock *pmb, Variable<Real> &v, const Plane &plane, ...)
+//  \brief adds the contribution of one block to a slice or column integral on the
+//  uniform grid with ng cells per direction at absolute level "level".  Cells of finer
+//  blocks are averaged onto the grid, cells of coarser blocks are repeated.  Returns
+//  without touching buf if a slice misses the block.
+
+void AccumulatePlane(MeshBlock *pmb, Variable<Real> &v, const Plane &plane,
+                     const int level, const int *ng, std::vector<Real> *buf) {
+  const int a = plane.axis, b = FirstInPlane(a), c = SecondInPlane(a);
+  const RegionSize &bs = pmb->block_size;
+  const int n[3] = {bs.nx1, bs.nx2, bs.nx3};
+  const int s[3] = {pmb->is, pmb->js, pmb->ks};
+  const std::int64_t l[3] = {pmb->loc.lx1, pmb->loc.lx2, pmb->loc.lx3};
+  const AthenaArray<Real> *xf[3] = {&pmb->pcoord->x1f, &pmb->pcoord->x2f,
+                                    &pmb->pcoord->x3f};
+  const AthenaArray<Real> *dxf[3] = {&pmb->pcoord->dx1f, &pmb->pcoord->dx2f,
+                                     &pmb->pcoord->dx3f};
+  const int shift = pmb->loc.level - level;  // > 0 for blocks finer than the grid
+  const int vlen = v.GetDim4();
+
+  // range of cells along the normal
+  int first = 0, last = n[a] - 1;
+  if (!plane.projection) {
+    if (plane.position < (*xf[a])(s[a]) || plane.position >= (*xf[a])(s[a] + n[a]))
+      return;
+    for (first = 0; first < n[a] - 1; first++) {
+      if ((*xf[a])(s[a] + first + 1) > plane.position) break;
+    }
+    last = first;
+  }
+
+  // along each active direction of the plane, a cell of a coarser block covers "rep"
+  // grid cells, and a cell of a finer block contributes "weight" to one grid cell
+  int rep[3] = {1, 1, 1};
+  Real weight = 1.0;
+  for (int d : {b, c}) {
+    if (ng[d] == 1) continue;
+    if (shift < 0) {
+      rep[d] = 1 << -shift;
+    } else {
+      weight /= static_cast<Real>(1 << shift);
+    }
+  }
+  auto grid = [&](const int d, const int m) -> int {
+    if (ng[d] == 1) return 0;
+    const std::int64_t g = l[d]*n[d] + m;
+    return static_cast<int>(shift >= 0 ? g >> shift : g << -shift);
+  };
+
+  int idx[3];
+  for (idx[a] = first; idx[a] <= last; idx[a]++) {
+    for (idx[c] = 0; idx[c] < n[c]; idx[c]++) {
+      const int tc = grid(c, idx[c]);
+      for (idx[b] = 0; idx[b] < n[b]; idx[b]++) {
+        const int tb = grid(b, idx[b]);
+        const int i = s[0] + idx[0], j = s[1] + idx[1], k = s[2] + idx[2];
+        const Real w = plane.projection ? weight*(*dxf[a])(s[a] + idx[a]) : weight;
+        for (int y = 0; y < rep[c]; y++) {
+          for (int x = 0; x < rep[b]; x++) {
+            Real *dst = buf->data()
+                        + (static_cast<std::size_t>(tc + y)*ng[b] + tb + x)*vlen;
+            for (int m = 0; m < vlen; m++) dst[m] += w*v(m, k, j, i);
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void InSituOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//  \brief reduces the Graphics variables of all blocks and writes the result from rank 0
+//  to <basename>.<file_id>.<number>.h5
+
+void InSituOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+  // all blocks have the same size; this rank may have none
+  const int n[3] = {pm->mesh_size.nx1/pm->nrbx1, pm->mesh_size.nx2/pm->nrbx2,
+                    pm->mesh_size.nx3/pm->nrbx3};
+  const int level = pm->root_level + output_params.reduction_level;
+  const int refine = 1 << output_params.reduction_level;
+  const int ng[3] = {pm->nrbx1*n[0]*refine,
+                     (n[1] > 1) ? pm->nrbx2*n[1]*refine : 1,
+                     (n[2] > 1) ? pm->nrbx3*n[2]*refine : 1};
+  const Real xmin[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min, pm->mesh_size.x3min};
+  const Real xmax[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max, pm->mesh_size.x3max};
+  const bool root = (Globals::my_rank == 0);
+
+  std::vector<Plane> planes;
+  const bool slice[3] = {output_params.output_slicex1, output_params.output_slicex2,
+                         output_params.output_slicex3};
+  const bool sum[3] = {output_params.output_sumx1, output_params.output_sumx2,
+                       output_params.output_sumx3};
+  const Real position[3] = {output_params.x1_slice, output_params.x2_slice,
+                            output_params.x3_slice};
+  for (int d = 0; d < 3; d++) {
+    if (slice[d])
+      planes.push_back({d, false, position[d], "slice_x" + std::to_string(d + 1)});
+    if (sum[d])
+      planes.push_back({d, true, 0.0, "projection_x" + std::to_string(d + 1)});
+  }
+
+  const int f = output_params.downsample;
+  int nd[3] = {1, 1, 1};
+  if (f > 0) {
+    for (int d = 0; d < 3; d++) {
+      if (n[d] == 1) continue;
+      if (n[d] % f != 0) {
+        std::stringstream msg;
+        msg << "### FATAL ERROR in InSituOutput::WriteOutputFile" << std::endl
+            << "downsample=" << f << " in output block '" << output_params.block_name
+            << "' does not divide the MeshBlock size " << n[d] << " in x" << d + 1
+            << std::endl;
+        ATHENA_ERROR(msg);
+      }
+      nd[d] = n[d]/f;
+    }
+  }
+  const int ndcells = nd[0]*nd[1]*nd[2];
+
+  hid_t file = -1;
+  if (root) {
+    std::stringstream fname;
+    fname << output_params.file_basename << "." << output_params.file_id << "."
+          << std::setw(5) << std::setfill('0') << output_params.file_number << ".h5";
+    file = H5Fcreate(fname.str().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (file < 0) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in InSituOutput::WriteOutputFile" << std::endl
+          << "Could not create file '" << fname.str() << "'" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    WriteAttribute(file, "Time", RealType(), 1, &pm->time);
+    WriteAttribute(file, "NCycle", H5T_NATIVE_INT, 1, &pm->ncycle);
+    WriteAttribute(file, "Level", H5T_NATIVE_INT, 1, &output_params.reduction_level);
+    WriteAttribute(file, "Downsample", H5T_NATIVE_INT, 1, &f);
+    for (auto &plane : planes) {
+      const int b = FirstInPlane(plane.axis), c = SecondInPlane(plane.axis);
+      hid_t group = H5Gcreate(file, plane.name.c_str(), H5P_DEFAULT, H5P_DEFAULT,
+                              H5P_DEFAULT);
+      // the plane spans extent[0..1] along its first and extent[2..3] along its second
+      // direction with ng cells each; a slice sits at "Position" along the normal
+      const Real extent[4] = {xmin[b], xmax[b], xmin[c], xmax[c]};
+      const int cells[2] = {ng[b], ng[c]};
+      WriteAttribute(group, "Extent", RealType(), 4, extent);
+      WriteAttribute(group, "Cells", H5T_NATIVE_INT, 2, cells);
+      if (!plane.projection)
+        WriteAttribute(group, "Position", RealType(), 1, &plane.position);
+      H5Gclose(group);
+    }
+  }
+
+  // block metadata of the downsampled volumes, in gid order
+  if (f > 0) {
+    std::vector<std::int64_t> locs;
+    std::vector<Real> bounds;
+    for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+      const RegionSize &b = pmb->block_size;
+      locs.insert(locs.end(), {pmb->loc.lx1, pmb->loc.lx2, pmb->loc.lx3,
+                               pmb->loc.level - pm->root_level});
+      bounds.insert(bounds.end(), {b.x1min, b.x1max, b.x2min, b.x2max, b.x3min,
+                                   b.x3max});
+    }
+    auto all_locs = GatherBlocks(locs, 4, pm->nblist, pm->nbtotal);
+    auto all_bounds = GatherBlocks(bounds, 6, pm->nblist, pm->nbtotal);
+    if (root) {
+      hid_t group = H5Gcreate(file, "downsampled", H5P_DEFAULT, H5P_DEFAULT,
+                              H5P_DEFAULT);
+      const hsize_t ldims[2] = {static_cast<hsize_t>(pm->nbtotal), 4};
+      WriteDataset(group, "LogicalLocation", H5T_NATIVE_INT64, 2, ldims,
+                   all_locs.data());
+      const hsize_t bdims[2] = {static_cast<hsize_t>(pm->nbtotal), 6};
+      WriteDataset(group, "Bounds", RealType(), 2, bdims, all_bounds.data());
+      H5Gclose(group);
+    }
+  }
+
+  for (auto &var : GraphicsVariables(pm)) {
+    const std::string &label = var.first;
+    const int vlen = var.second;
+
+    for (auto &plane : planes) {
+      const int b = FirstInPlane(plane.axis), c = SecondInPlane(plane.axis);
+      std::vector<Real> buf(static_cast<std::size_t>(ng[b])*ng[c]*vlen, 0.0);
+      for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+        auto ci = ContainerIterator<Real>(pmb->real_container, {Metadata::Graphics});
+        for (auto &v : ci.vars) {
+          if (v->label() == label) AccumulatePlane(pmb, *v, plane, level, ng, &buf);
+        }
+      }
+      ReduceToRoot(&buf);
+      if (root) {
+        const hsize_t dims[3] = {static_cast<hsize_t>(ng[c]),
+                                 static_cast<hsize_t>(ng[b]),
+                                 static_cast<hsize_t>(vlen)};
+        WriteDataset(file, plane.name + "/" + label, RealType(), 3, dims, buf.data());
+      }
+    }
+
+    if (f > 0) {
+      // average f^ndim cells of every block into one, components fastest
+      std::vector<Real> local(static_cast<std::size_t>(pm->nblist[Globals::my_rank])
+                              *ndcells*vlen, 0.0);
+      Real *dst = local.data();
+      for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+        auto ci = ContainerIterator<Real>(pmb->real_container, {Metadata::Graphics});
+        for (auto &v : ci.vars) {
+          if (v->label() != label) continue;
+          const int fi = (n[0] > 1) ? f : 1, fj = (n[1] > 1) ? f : 1;
+          const int fk = (n[2] > 1) ? f : 1;
+          const Real norm = 1.0/(fi*fj*fk);
+          for (int k = 0; k < n[2]; k++) {
+            for (int j = 0; j < n[1]; j++) {
+              for (int i = 0; i < n[0]; i++) {
+                Real *cell = dst + ((static_cast<std::size_t>(k/fk)*nd[1] + j/fj)*nd[0]
+                                    + i/fi)*vlen;
+                for (int m = 0; m < vlen; m++)
+                  cell[m] += norm*(*v)(m, pmb->ks + k, pmb->js + j, pmb->is + i);
+              }
+            }
+          }
+        }
+        dst += static_cast<std::size_t>(ndcells)*vlen;
+      }
+      auto all = GatherBlocks(local, ndcells*vlen, pm->nblist, pm->nbtotal);
+      if (root) {
+        const hsize_t dims[5] = {static_cast<hsize_t>(pm->nbtotal),
+                                 static_cast<hsize_t>(nd[2]), static_cast<hsize_t>(nd[1]),
+                                 static_cast<hsize_t>(nd[0]), static_cast<hsize_t>(vlen)};
+        WriteDataset(file, "downsampled/" + label, RealType(), 5, dims, all.data());
+      }
+    }
+  }
+  if (root) H5Fclose(file);
+
+  // advance output parameters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+}
+} // namespace parthenon
+
+#endif  // HDF5OUTPUT
@@ -30,7 +30,7 @@
 // Required parameters that must be specified in an <output[n]> block are:
 //   - variable     = cons,prim,D,d,E,e,m,m1,m2,m3,v,v1=vx,v2=vy,v3=vz,p,
 //                    bcc,bcc1,bcc2,bcc3,b,b1,b2,b3,phi,uov
-//   - file_type    = rst,tab,vtk,hst,hdf5
+//   - file_type    = rst,tab,vtk,hst,hdf5,insitu
 //   - dt           = problem time between outputs
 //
 // EXAMPLE of an <output[n]> block for a VTK dump:
@@ -42,6 +42,14 @@
 //   x2_slice    = 0.0       # slice in x2
 //   x3_slice    = 0.0       # slice in x3
 //
+// vtk outputs also accept "aggregate = true" to write one file per rank instead of one
+// file per MeshBlock.  hdf5 outputs accept "chunking", "compression", "compression_level",
+// "lossy", "lossy_tolerance", "lossy_bits", "lossy_variables", "single_precision",
+// "single_precision_variables" and the parallel I/O settings "aggregators",
+// "aggregators_per_node", "cb_buffer_size", "stripe_count", "stripe_size", "alignment",
+// "alignment_threshold", "sieve_buffer_size", the burst buffer directory "stage_dir" and
+// "incremental", see docs/README.md.
+//
 // Each <output[n]> block will result in a new node being created in a linked list of
 // OutputType stored in the Outputs class.  During a simulation, outputs are made when
 // the simulation time satisfies the criteria implemented in the MakeOutputs() function.
@@ -94,14 +102,20 @@
 #include <cstring>    // strcmp
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>   // std::string, to_string()
+#include <utility>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
 #include "athena_arrays.hpp"
 #include "coordinates/coordinates.hpp"
+#include "interface/PropertiesInterface.hpp"
+#include "interface/StateDescriptor.hpp"
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
 #include "outputs.hpp"
@@ -195,23 +209,25 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
           }
         }
 
-        // read sum options.  Check for conflicts with slicing.
+        // read sum options.  Check for conflicts with slicing, except for insitu outputs
+        // which write slices and sums side by side.
+        const bool slice_and_sum = (op.file_type.compare("insitu") == 0);
         op.output_sumx1 = pin->GetOrAddBoolean(op.block_name,"x1_sum",false);
-        if ((op.output_slicex1) && (op.output_sumx1)) {
+        if ((op.output_slicex1) && (op.output_sumx1) && !slice_and_sum) {
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
               << "Cannot request both slice and sum along x1-direction"
               << " in output block '" << op.block_name << "'" << std::endl;
           ATHENA_ERROR(msg);
         }
         op.output_sumx2 = pin->GetOrAddBoolean(op.block_name,"x2_sum",false);
-        if ((op.output_slicex2) && (op.output_sumx2)) {
+        if ((op.output_slicex2) && (op.output_sumx2) && !slice_and_sum) {
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
               << "Cannot request both slice and sum along x2-direction"
               << " in output block '" << op.block_name << "'" << std::endl;
           ATHENA_ERROR(msg);
         }
         op.output_sumx3 = pin->GetOrAddBoolean(op.block_name,"x3_sum",false);
-        if ((op.output_slicex3) && (op.output_sumx3)) {
+        if ((op.output_slicex3) && (op.output_sumx3) && !slice_and_sum) {
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
               << "Cannot request both slice and sum along x3-direction"
               << " in output block '" << op.block_name << "'" << std::endl;
@@ -222,6 +238,116 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
         op.include_ghost_zones = pin->GetOrAddBoolean(op.block_name, "ghost_zones",
                                                       false);
 
+        // read aggregation option, only meaningful for vtk
+        if (op.file_type.compare("vtk") == 0)
+          op.aggregate = pin->GetOrAddBoolean(op.block_name, "aggregate", false);
+
+        // read chunking, compression and lossy quantization options, only meaningful
+        // for hdf5.  Filters operate on chunks, so any filter implies chunking.
+        if (op.file_type.compare("hdf5") == 0 || op.file_type.compare("ath5") == 0) {
+          op.compression = pin->GetOrAddString(op.block_name, "compression", "none");
+          if (op.compression != "none" && op.compression != "deflate"
+              && op.compression != "shuffle_deflate" && op.compression != "lz4") {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Unknown compression = '" << op.compression << "' in output block '"
+                << op.block_name << "'; use none, deflate, shuffle_deflate or lz4"
+                << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (op.compression == "deflate" || op.compression == "shuffle_deflate") {
+            op.compression_level = pin->GetOrAddInteger(op.block_name,
+                                                        "compression_level", 4);
+            if (op.compression_level < 1 || op.compression_level > 9) {
+              msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                  << "compression_level must be between 1 and 9 in output block '"
+                  << op.block_name << "'" << std::endl;
+              ATHENA_ERROR(msg);
+            }
+          }
+          op.lossy = pin->GetOrAddString(op.block_name, "lossy", "none");
+          if (op.lossy == "quantize") {
+            op.lossy_tolerance = pin->GetReal(op.block_name, "lossy_tolerance");
+            if (op.lossy_tolerance <= 0.0) {
+              msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                  << "lossy_tolerance must be positive in output block '"
+                  << op.block_name << "'" << std::endl;
+              ATHENA_ERROR(msg);
+            }
+          } else if (op.lossy == "bitround") {
+            op.lossy_bits = pin->GetInteger(op.block_name, "lossy_bits");
+            const int max_bits = std::numeric_limits<Real>::digits - 2;
+            if (op.lossy_bits < 1 || op.lossy_bits > max_bits) {
+              msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                  << "lossy_bits must be between 1 and " << max_bits
+                  << " in output block '" << op.block_name << "'" << std::endl;
+              ATHENA_ERROR(msg);
+            }
+          } else if (op.lossy != "none") {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Unknown lossy = '" << op.lossy << "' in output block '"
+                << op.block_name << "'; use none, quantize or bitround" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (op.lossy != "none")
+            op.lossy_variables = pin->GetOrAddString(op.block_name, "lossy_variables",
+                                                     "");
+          op.single_precision = pin->GetOrAddBoolean(op.block_name, "single_precision",
+                                                     false);
+          if (op.single_precision)
+            op.single_precision_variables = pin->GetOrAddString(
+                op.block_name, "single_precision_variables", "");
+          op.chunking = pin->GetOrAddBoolean(op.block_name, "chunking",
+                                             op.compression != "none");
+          if (op.compression != "none" && !op.chunking) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "compression requires chunking in output block '" << op.block_name
+                << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+
+          // read the MPI-IO aggregation and file layout settings
+          op.aggregators = pin->GetOrAddInteger(op.block_name, "aggregators", 0);
+          op.aggregators_per_node = pin->GetOrAddInteger(op.block_name,
+                                                         "aggregators_per_node", 0);
+          op.cb_buffer_size = pin->GetOrAddInteger(op.block_name, "cb_buffer_size",
+                                                   4194304);
+          op.stripe_count = pin->GetOrAddInteger(op.block_name, "stripe_count", 0);
+          op.stripe_size = pin->GetOrAddInteger(op.block_name, "stripe_size", 0);
+          op.alignment = pin->GetOrAddInteger(op.block_name, "alignment", 262144);
+          op.alignment_threshold = pin->GetOrAddInteger(op.block_name,
+                                                        "alignment_threshold", 524288);
+          op.sieve_buffer_size = pin->GetOrAddInteger(op.block_name,
+                                                      "sieve_buffer_size", 262144);
+          if (op.aggregators < 0 || op.aggregators_per_node < 0 || op.stripe_count < 0
+              || op.stripe_size < 0 || op.alignment_threshold < 0) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "aggregators, aggregators_per_node, stripe_count, stripe_size and "
+                << "alignment_threshold must be >= 0 in output block '" << op.block_name
+                << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (op.cb_buffer_size < 1 || op.alignment < 1 || op.sieve_buffer_size < 1) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "cb_buffer_size, alignment and sieve_buffer_size must be >= 1 in "
+                << "output block '" << op.block_name << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          op.stage_dir = pin->GetOrAddString(op.block_name, "stage_dir", "");
+          op.incremental = pin->GetOrAddBoolean(op.block_name, "incremental", false);
+        }
+
+        // read the grid level and block downsampling of insitu reductions
+        if (op.file_type.compare("insitu") == 0) {
+          op.reduction_level = pin->GetOrAddInteger(op.block_name, "level", 0);
+          op.downsample = pin->GetOrAddInteger(op.block_name, "downsample", 0);
+          if (op.reduction_level < 0 || op.downsample < 0) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "level and downsample must be >= 0 in output block '"
+                << op.block_name << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+        }
+
         // read cartesian mapping option
         op.cartesian_vector = false;
 
@@ -253,6 +379,15 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
               << "Executable not configured for HDF5 outputs, but HDF5 file format "
               << "is requested in output block '" << op.block_name << "'" << std::endl;
           ATHENA_ERROR(msg);
+#endif
+        } else if (op.file_type.compare("insitu") == 0) {
+#ifdef HDF5OUTPUT
+          pnew_type = new InSituOutput(op);
+#else
+          msg << "### FATAL ERROR in Outputs constructor" << std::endl
+              << "Executable not configured for HDF5 outputs, but insitu outputs "
+              << "are requested in output block '" << op.block_name << "'" << std::endl;
+          ATHENA_ERROR(msg);
 #endif
         } else {
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
@@ -314,6 +449,16 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
   // if found == 2, do nothing; it's already at the tail node/end of the list
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Outputs::FinishOutputs()
+//  \brief completes the work every OutputType still has in flight, e.g. the cross-rank
+//  reduction of the last history line
+
+void Outputs::FinishOutputs() {
+  for (OutputType *ptype = pfirst_type_; ptype != nullptr; ptype = ptype->pnext_type)
+    ptype->FinishOutput();
+}
+
 // destructor - iterates through singly linked list of OutputTypes and deletes nodes
 
 Outputs::~Outputs() {
@@ -390,6 +535,30 @@ void OutputType::ClearOutputData() {
   plast_data_  = nullptr;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn std::vector<std::pair<std::string, int>> OutputType::GraphicsVariables(Mesh *pm)
+//  \brief labels and number of components of the Graphics variables, in the order the
+//  MeshBlocks add them to their containers.  They are taken from the descriptors, so a
+//  rank without blocks knows them as well as the others.
+
+std::vector<std::pair<std::string, int>> OutputType::GraphicsVariables(Mesh *pm) {
+  std::vector<std::pair<std::string, int>> vars;
+  auto add = [&vars](const std::map<std::string, Metadata> &fields) {
+    for (auto const &q : fields) {
+      const Metadata &m = q.second;
+      if (!m.IsSet(Metadata::Graphics)) continue;
+      if (!(m.Where() == Metadata::Cell || m.Where() == Metadata::Node)) continue;
+      std::string label = q.first;
+      if (m.IsSet(Metadata::Sparse))
+        label += "_" + PropertiesInterface::GetLabelFromID(m.GetSparseId());
+      vars.emplace_back(label, m.Shape().empty() ? 1 : m.Shape()[0]);
+    }
+  };
+  for (auto &p : pm->properties) add(p->State().AllFields());
+  for (auto &pkg : pm->packages) add(pkg.second->AllFields());
+  return vars;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Outputs::MakeOutputs(Mesh *pm, ParameterInput *pin, bool wtflag)
 //  \brief scans through singly linked list of OutputTypes and makes any outputs needed.
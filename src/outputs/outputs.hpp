@@ -22,8 +22,14 @@
 // C headers
 
 // C++ headers
+#include <cstdint>
 #include <cstdio>  // std::size_t
+#include <map>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
@@ -52,6 +58,31 @@ struct OutputParameters {
   bool output_slicex1, output_slicex2, output_slicex3;
   bool output_sumx1, output_sumx2, output_sumx3;
   bool include_ghost_zones, cartesian_vector;
+  bool aggregate;  // one file per rank and an index instead of one file per block (vtk)
+  // hdf5 dataset layout and filters applied in ATHDF5Output::WriteOutputFile()
+  bool chunking;                // one chunk per MeshBlock
+  std::string compression;      // none, deflate, shuffle_deflate or lz4
+  int compression_level;        // deflate level 1-9
+  std::string lossy;            // none, quantize or bitround
+  Real lossy_tolerance;         // quantize: maximum absolute error
+  int lossy_bits;               // bitround: mantissa bits kept
+  std::string lossy_variables;  // comma separated labels, empty for all variables
+  bool single_precision;        // store as float32 instead of float64
+  std::string single_precision_variables;  // comma separated labels, empty for all
+  // hdf5 parallel file access, see SetFileAccessHints() in athena_hdf5_C.cpp
+  int aggregators;              // ranks writing to the file, 0 for the MPI-IO default
+  int aggregators_per_node;     // at most this many aggregators per node, 0 for any
+  int cb_buffer_size;           // bytes staged per aggregator and write
+  int stripe_count;             // file system stripes of a new file, 0 for the default
+  int stripe_size;              // bytes per stripe, 0 for the default
+  int alignment;                // objects of at least alignment_threshold bytes start at
+  int alignment_threshold;      //   a multiple of alignment bytes in the file
+  int sieve_buffer_size;        // bytes of the hdf5 data sieve buffer
+  std::string stage_dir;        // node-local directory hdf5 files are written to first
+  bool incremental;             // link unchanged hdf5 datasets to earlier files
+  // insitu reductions, see InSituOutput
+  int reduction_level;          // level of the slice/projection grid above the root grid
+  int downsample;               // factor by which blocks are downsampled, 0 for none
   int islice, jslice, kslice;
   Real x1_slice, x2_slice, x3_slice;
   // TODO(felker): some of the parameters in this class are not initialized in constructor
@@ -59,7 +90,15 @@ struct OutputParameters {
                        output_slicex1(false),output_slicex2(false),output_slicex3(false),
                        output_sumx1(false), output_sumx2(false), output_sumx3(false),
                        include_ghost_zones(false), cartesian_vector(false),
-                       islice(0), jslice(0), kslice(0) {}
+                       aggregate(false), chunking(false), compression("none"),
+                       compression_level(0), lossy("none"), lossy_tolerance(0.0),
+                       lossy_bits(0), single_precision(false), aggregators(0),
+                       aggregators_per_node(0), cb_buffer_size(4194304),
+                       stripe_count(0), stripe_size(0), alignment(262144),
+                       alignment_threshold(524288), sieve_buffer_size(262144),
+                       incremental(false),
+                       reduction_level(0), downsample(0), islice(0), jslice(0),
+                       kslice(0) {}
 };
 
 //----------------------------------------------------------------------------------------
@@ -111,9 +150,13 @@ class OutputType {
   void SumOutputData(MeshBlock *pmb, int dim);
   void CalculateCartesianVector(AthenaArray<Real> &src, AthenaArray<Real> &dst,
                                 Coordinates *pco);
+  // labels and components of the Graphics variables, the same on every rank
+  static std::vector<std::pair<std::string, int>> GraphicsVariables(Mesh *pm);
   // following pure virtual function must be implemented in all derived classes
   virtual void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) = 0;
   virtual void WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) { return;};
+  // completes work that WriteOutputFile() left in flight; collective
+  virtual void FinishOutput() {}
 
  protected:
   int num_vars_;             // number of variables in output
@@ -128,8 +171,15 @@ class OutputType {
 
 class HistoryOutput : public OutputType {
  public:
-  explicit HistoryOutput(OutputParameters oparams) : OutputType(oparams) {}
+  explicit HistoryOutput(OutputParameters oparams);
+  ~HistoryOutput();
   void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+  void FinishOutput() override { Complete(); }
+
+ private:
+  struct Reduction;  // a cross-rank reduction in flight, see history.cpp
+  std::unique_ptr<Reduction> pending_;
+  void Complete();
 };
 
 //----------------------------------------------------------------------------------------
@@ -151,6 +201,9 @@ class VTKOutput : public OutputType {
   explicit VTKOutput(OutputParameters oparams) : OutputType(oparams) {}
   void WriteContainer(Mesh *pm, ParameterInput *pin, bool flag)  override;
   void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+
+ private:
+  void WriteAggregated(Mesh *pm, ParameterInput *pin);
 };
 
 //----------------------------------------------------------------------------------------
@@ -172,10 +225,29 @@ class ATHDF5Output : public OutputType {
  public:
   // Function declarations
   explicit ATHDF5Output(OutputParameters oparams) : OutputType(oparams) {}
+  ~ATHDF5Output();
   void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+  void FinishOutput() override;
   void genXDMF(std::string hdfFile, Mesh *pm);
 
  private:
+  // burst buffer staging: with stage_dir set, every rank writes its own file there and
+  // a background thread moves it to its final name while the simulation continues
+  std::string RankFileName(const std::string &hdfFile, int rank) const;
+  void StartDrain(const std::string &staged, const std::string &final_name);
+  void WaitForDrain();
+  void PublishXDMF();
+  std::thread drain_;
+  std::string drain_error_;   // set by the drain thread, reported by WaitForDrain()
+  std::string xdmf_pending_;  // XDMF written as <name>.part until the drain is done
+
+  // incremental output: the earlier file holding the current content of a dataset, and
+  // a hash of that content on this rank
+  std::map<std::string, std::string> dataset_file_;
+  std::map<std::string, std::uint64_t> dataset_hash_;
+  std::uint64_t mesh_generation_ = 0;   // of the mesh the datasets were written for
+  int local_start_ = 0, num_blocks_ = 0;  // blocks of this rank at that time
+
   // Parameters
   static const int max_name_length = 128;  // maximum length of names excluding \0
 
@@ -189,6 +261,17 @@ class ATHDF5Output : public OutputType {
   char (*dataset_names)[max_name_length+1];   // array of C-string names of datasets
   char (*variable_names)[max_name_length+1];  // array of C-string names of variables
 };
+
+//----------------------------------------------------------------------------------------
+//! \class InSituOutput
+//  \brief derived OutputType class for slices, column integrals and downsampled blocks
+//  reduced across ranks into one HDF5 file
+
+class InSituOutput : public OutputType {
+ public:
+  explicit InSituOutput(OutputParameters oparams) : OutputType(oparams) {}
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+};
 #endif
 
 //----------------------------------------------------------------------------------------
@@ -203,6 +286,8 @@ class Outputs {
   ~Outputs();
 
   void MakeOutputs(Mesh *pm, ParameterInput *pin, bool wtflag=false);
+  // completes the outputs still in flight; collective, call before destruction
+  void FinishOutputs();
 
  private:
   OutputType *pfirst_type_; // ptr to head OutputType node in singly linked list
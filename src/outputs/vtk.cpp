@@ -17,24 +17,32 @@
 //! \file vtk.cpp
 //  \brief writes output data in (legacy) vtk format.
 //  Data is written in RECTILINEAR_GRID geometry, in BINARY format, and in FLOAT type
-//  Writes one file per MeshBlock.
+//  Writes one file per MeshBlock.  With aggregate=true, every rank instead writes all of
+//  its MeshBlocks to one XML UnstructuredGrid (.vtu) file with raw appended data, and
+//  rank 0 writes a .pvtu index of the rank files.
 
 // C headers
 
 // C++ headers
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
 #include <cstdlib>
+#include <cstring>     // memcpy()
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
 #include "athena_arrays.hpp"
 #include "coordinates/coordinates.hpp"
+#include "globals.hpp"
 #include "mesh/mesh.hpp"
 #include "outputs.hpp"
 #include "interface/ContainerIterator.hpp"
@@ -53,10 +61,15 @@ int IsBigEndian() {
 }
 
 namespace {
-inline void Swap4Bytes(void *vdat) {
-  char tmp, *dat = static_cast<char *>(vdat);
-  tmp = dat[0];  dat[0] = dat[3];  dat[3] = tmp;
-  tmp = dat[1];  dat[1] = dat[2];  dat[2] = tmp;
+// reverses the byte order of n floats in place; the loop is free of branches and
+// aliasing so that compilers turn it into SIMD byte shuffles
+inline void Swap4Bytes(float *data, const std::size_t n) {
+  for (std::size_t i=0; i<n; ++i) {
+    std::uint32_t w;
+    std::memcpy(&w, &data[i], sizeof(w));
+    w = (w >> 24) | ((w >> 8) & 0x0000ff00u) | ((w << 8) & 0x00ff0000u) | (w << 24);
+    std::memcpy(&data[i], &w, sizeof(w));
+  }
 }
 } // namespace
 
@@ -153,7 +166,7 @@ void VTKOutput::WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) {
         data[i-out_is] = static_cast<float>(pmb->pcoord->x1f(i));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord1; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord1);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord1), pfile);
 
     // write x2-coordinates as binary float in big endian order
@@ -165,7 +178,7 @@ void VTKOutput::WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) {
         data[j-out_js] = static_cast<float>(pmb->pcoord->x2f(j));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord2; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord2);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord2), pfile);
 
     // write x3-coordinates as binary float in big endian order
@@ -177,7 +190,7 @@ void VTKOutput::WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) {
         data[k-out_ks] = static_cast<float>(pmb->pcoord->x3f(k));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord3; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord3);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord3), pfile);
 
     //  5. Data.  An arbitrary number of scalars and vectors can be written (every node
@@ -192,19 +205,16 @@ void VTKOutput::WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) {
 	std::cout << "____________________SKIPPPING:"<<v->label() << std::endl;
 	continue;
       }
-      std::fprintf(pfile, "\nLOOKUP_TABLE default\n");
+      std::fprintf(pfile, "\nSCALARS %s float\n", v->label().c_str());
+      std::fprintf(pfile, "LOOKUP_TABLE default\n");
       for (int k = out_ks; k <= out_ke; k++) {
 	for (int j = out_js; j <= out_je; j++) {
-	  int index = 0;
-	  for (int i = out_is; i <= out_ie; i++, index++) {
-	    data[(i-out_is)+index] = (*v)(k,j,i);
+	  for (int i = out_is; i <= out_ie; i++) {
+	    data[i-out_is] = (*v)(k,j,i);
 	  }
 
           // write data in big endian order
-          if (!big_end) {
-            for (int i=0; i<(ncells1); ++i)
-              Swap4Bytes(&data[i]);
-          }
+          if (!big_end) Swap4Bytes(data, ncells1);
           std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncells1), pfile);
 	}
       }
@@ -227,7 +237,11 @@ void VTKOutput::WriteContainer(Mesh *pm, ParameterInput *pin, bool flag) {
 void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   MeshBlock *pmb = pm->pblock;
   int big_end = IsBigEndian(); // =1 on big endian machine
-  WriteContainer(pm, pin, flag);
+  if (output_params.aggregate) {
+    WriteAggregated(pm, pin);
+  } else {
+    WriteContainer(pm, pin, flag);
+  }
   return;
   // Loop over MeshBlocks
   while (pmb != nullptr) {
@@ -319,7 +333,7 @@ void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
         data[i-out_is] = static_cast<float>(pmb->pcoord->x1f(i));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord1; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord1);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord1), pfile);
 
     // write x2-coordinates as binary float in big endian order
@@ -331,7 +345,7 @@ void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
         data[j-out_js] = static_cast<float>(pmb->pcoord->x2f(j));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord2; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord2);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord2), pfile);
 
     // write x3-coordinates as binary float in big endian order
@@ -343,7 +357,7 @@ void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
         data[k-out_ks] = static_cast<float>(pmb->pcoord->x3f(k));
       }
     }
-    if (!big_end) {for (int i=0; i<ncoord3; ++i) Swap4Bytes(&data[i]);}
+    if (!big_end) Swap4Bytes(data, ncoord3);
     std::fwrite(data, sizeof(float), static_cast<std::size_t>(ncoord3), pfile);
 
     //  5. Data.  An arbitrary number of scalars and vectors can be written (every node
@@ -366,10 +380,7 @@ void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           }
 
           // write data in big endian order
-          if (!big_end) {
-            for (int i=0; i<(nvar*ncells1); ++i)
-              Swap4Bytes(&data[i]);
-          }
+          if (!big_end) Swap4Bytes(data, nvar*ncells1);
           std::fwrite(data, sizeof(float), static_cast<std::size_t>(nvar*ncells1), pfile);
         }
       }
@@ -390,4 +401,298 @@ void VTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   return;
 }
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \class AppendedWriter
+//  \brief collects the raw appended data of a .vtu file in a large buffer, so that the
+//  file sees a few big writes instead of one per row
+
+class AppendedWriter {
+ public:
+  explicit AppendedWriter(FILE *pfile) : pfile_(pfile) { buf_.reserve(kCapacity); }
+  ~AppendedWriter() { Flush(); }
+
+  template <typename T>
+  void Put(const T *data, const std::size_t n) {
+    const std::size_t nbytes = n*sizeof(T);
+    if (buf_.size() + nbytes > kCapacity) Flush();
+    const char *bytes = reinterpret_cast<const char *>(data);
+    buf_.insert(buf_.end(), bytes, bytes + nbytes);
+  }
+  template <typename T>
+  void Put(const T &x) { Put(&x, 1); }
+  // each appended array is preceded by its size in bytes
+  void BeginArray(const std::uint64_t nbytes) { Put(nbytes); }
+
+  void Flush() {
+    if (!buf_.empty()) std::fwrite(buf_.data(), 1, buf_.size(), pfile_);
+    buf_.clear();
+  }
+
+ private:
+  static constexpr std::size_t kCapacity = 8 << 20;
+  FILE *pfile_;
+  std::vector<char> buf_;
+};
+
+// VTK cell types for 1, 2 and 3 dimensions
+constexpr std::uint8_t kVTKLine = 3, kVTKPixel = 8, kVTKVoxel = 11;
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void VTKOutput::WriteAggregated(Mesh *pm, ParameterInput *pin)
+//  \brief writes all MeshBlocks of this rank as one UnstructuredGrid of pixels/voxels in
+//  a .vtu file with raw appended data in native byte order, and on rank 0 the .pvtu
+//  index of all ranks
+
+void VTKOutput::WriteAggregated(Mesh *pm, ParameterInput *pin) {
+  const int ndim = pm->ndim;
+  const int nvert = 1 << ndim;
+  const std::uint8_t cell_type = (ndim == 3) ? kVTKVoxel
+                                 : (ndim == 2) ? kVTKPixel : kVTKLine;
+  const char *byte_order = IsBigEndian() ? "BigEndian" : "LittleEndian";
+
+  // the extents of the output region of a block, as for the per-block files
+  auto set_extents = [this](MeshBlock *pmb) {
+    out_is = pmb->is; out_ie = pmb->ie;
+    out_js = pmb->js; out_je = pmb->je;
+    out_ks = pmb->ks; out_ke = pmb->ke;
+    if (output_params.include_ghost_zones) {
+      out_is -= NGHOST; out_ie += NGHOST;
+      if (out_js != out_je) {out_js -= NGHOST; out_je += NGHOST;}
+      if (out_ks != out_ke) {out_ks -= NGHOST; out_ke += NGHOST;}
+    }
+  };
+
+  // names and components of the variables, from the descriptors so that rank 0 lists
+  // them in the index even if it has no blocks
+  std::vector<std::string> names;
+  std::vector<int> ncomp;
+  for (auto &var : GraphicsVariables(pm)) {
+    names.push_back(var.first);
+    ncomp.push_back(var.second);
+  }
+
+  std::uint64_t npoints = 0, ncells = 0;
+  int maxrow = 0;
+  for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+    set_extents(pmb);
+    const std::uint64_t nc1 = out_ie - out_is + 1, nc2 = out_je - out_js + 1,
+                        nc3 = out_ke - out_ks + 1;
+    npoints += (nc1 + 1)*(ndim > 1 ? nc2 + 1 : 1)*(ndim > 2 ? nc3 + 1 : 1);
+    ncells += nc1*nc2*nc3;
+    maxrow = std::max(maxrow, static_cast<int>(nc1));
+  }
+  // longest row of point coordinates or cell data
+  int maxcomp = 3;
+  for (int c : ncomp)
+    maxcomp = std::max(maxcomp, c);
+  maxrow = maxcomp*(maxrow + 1);
+
+  // byte offsets of the arrays in the appended section
+  std::vector<std::uint64_t> sizes = {3*sizeof(float)*npoints,
+                                      nvert*sizeof(std::int64_t)*ncells,
+                                      sizeof(std::int64_t)*ncells,
+                                      sizeof(std::uint8_t)*ncells,
+                                      sizeof(std::int32_t)*ncells,
+                                      sizeof(std::int32_t)*ncells};
+  for (int c : ncomp)
+    sizes.push_back(c*sizeof(float)*ncells);
+  std::vector<std::uint64_t> offsets(sizes.size(), 0);
+  for (std::size_t n=1; n<sizes.size(); ++n)
+    offsets[n] = offsets[n-1] + sizeof(std::uint64_t) + sizes[n-1];
+
+  char number[6];
+  std::snprintf(number, sizeof(number), "%05d", output_params.file_number);
+  const std::string base = output_params.file_basename + "." + output_params.file_id
+                           + "." + number;
+  const std::string fname = base + "." + std::to_string(Globals::my_rank) + ".vtu";
+  FILE *pfile;
+  if ((pfile = std::fopen(fname.c_str(), "wb")) == nullptr) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [VTKOutput::WriteAggregated]"
+        << std::endl << "Output file '" << fname << "' could not be opened" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  std::stringstream xml;
+  auto data_array = [&xml, &offsets](const char *type, const std::string &name,
+                                     const int nc, const int n) {
+    xml << "<DataArray type=\"" << type << "\"";
+    if (!name.empty()) xml << " Name=\"" << name << "\"";
+    if (nc > 1) xml << " NumberOfComponents=\"" << nc << "\"";
+    xml << " format=\"appended\" offset=\"" << offsets[n] << "\"/>" << std::endl;
+  };
+  xml << "<?xml version=\"1.0\"?>" << std::endl
+      << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+      << byte_order << "\" header_type=\"UInt64\">" << std::endl
+      << "<UnstructuredGrid>" << std::endl
+      << "<FieldData>" << std::endl
+      << "<DataArray type=\"Float64\" Name=\"TimeValue\" NumberOfTuples=\"1\" "
+      << "format=\"ascii\">" << std::setprecision(17) << pm->time << "</DataArray>"
+      << std::endl
+      << "<DataArray type=\"Int32\" Name=\"Cycle\" NumberOfTuples=\"1\" "
+      << "format=\"ascii\">" << pm->ncycle << "</DataArray>" << std::endl
+      << "</FieldData>" << std::endl
+      << "<Piece NumberOfPoints=\"" << npoints << "\" NumberOfCells=\"" << ncells
+      << "\">" << std::endl
+      << "<Points>" << std::endl;
+  data_array("Float32", "", 3, 0);
+  xml << "</Points>" << std::endl << "<Cells>" << std::endl;
+  data_array("Int64", "connectivity", 1, 1);
+  data_array("Int64", "offsets", 1, 2);
+  data_array("UInt8", "types", 1, 3);
+  xml << "</Cells>" << std::endl << "<CellData>" << std::endl;
+  data_array("Int32", "gid", 1, 4);
+  data_array("Int32", "level", 1, 5);
+  for (std::size_t n=0; n<names.size(); ++n)
+    data_array("Float32", names[n], ncomp[n], 6 + n);
+  xml << "</CellData>" << std::endl << "</Piece>" << std::endl
+      << "</UnstructuredGrid>" << std::endl
+      << "<AppendedData encoding=\"raw\">" << std::endl << "_";
+  const std::string header = xml.str();
+  std::fwrite(header.data(), 1, header.size(), pfile);
+
+  {
+    AppendedWriter out(pfile);
+    std::vector<float> row(maxrow);
+
+    // points, x1 fastest
+    out.BeginArray(sizes[0]);
+    for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+      set_extents(pmb);
+      Coordinates *pco = pmb->pcoord.get();
+      const int np1 = out_ie - out_is + 2;
+      for (int k=out_ks; k<=(ndim > 2 ? out_ke + 1 : out_ks); ++k) {
+        const float z = (ndim > 2) ? pco->x3f(k) : pco->x3v(k);
+        for (int j=out_js; j<=(ndim > 1 ? out_je + 1 : out_js); ++j) {
+          const float y = (ndim > 1) ? pco->x2f(j) : pco->x2v(j);
+          for (int i=0; i<np1; ++i) {
+            row[3*i] = pco->x1f(out_is + i);
+            row[3*i + 1] = y;
+            row[3*i + 2] = z;
+          }
+          out.Put(row.data(), 3*np1);
+        }
+      }
+    }
+
+    // corners of every cell in the VTK pixel/voxel order: x1 fastest, then x2, then x3
+    out.BeginArray(sizes[1]);
+    std::int64_t first_point = 0;
+    for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+      set_extents(pmb);
+      const int nc1 = out_ie - out_is + 1, nc2 = out_je - out_js + 1,
+                nc3 = out_ke - out_ks + 1;
+      const std::int64_t np1 = nc1 + 1, np2 = (ndim > 1) ? nc2 + 1 : 1;
+      std::int64_t corners[8];
+      for (int k=0; k<nc3; ++k) {
+        for (int j=0; j<nc2; ++j) {
+          for (int i=0; i<nc1; ++i) {
+            for (int c=0; c<nvert; ++c) {
+              corners[c] = first_point + ((k + ((c >> 2) & 1))*np2 + j + ((c >> 1) & 1))
+                                         *np1 + i + (c & 1);
+            }
+            out.Put(corners, nvert);
+          }
+        }
+      }
+      first_point += np1*np2*((ndim > 2) ? nc3 + 1 : 1);
+    }
+
+    out.BeginArray(sizes[2]);
+    for (std::uint64_t n=1; n<=ncells; ++n)
+      out.Put(static_cast<std::int64_t>(n*nvert));
+    out.BeginArray(sizes[3]);
+    for (std::uint64_t n=0; n<ncells; ++n)
+      out.Put(cell_type);
+
+    // block id and level of every cell
+    for (int a=0; a<2; ++a) {
+      out.BeginArray(sizes[4 + a]);
+      for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+        set_extents(pmb);
+        const std::int32_t id = (a == 0) ? pmb->gid : pmb->loc.level - pm->GetRootLevel();
+        const std::int64_t nc = static_cast<std::int64_t>(out_ie - out_is + 1)
+                                *(out_je - out_js + 1)*(out_ke - out_ks + 1);
+        for (std::int64_t n=0; n<nc; ++n)
+          out.Put(id);
+      }
+    }
+
+    // variables, components fastest
+    for (std::size_t v=0; v<names.size(); ++v) {
+      out.BeginArray(sizes[6 + v]);
+      for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next) {
+        set_extents(pmb);
+        auto ci = ContainerIterator<Real>(pmb->real_container, {Metadata::Graphics});
+        auto it = std::find_if(ci.vars.begin(), ci.vars.end(),
+            [&names, v](const std::shared_ptr<Variable<Real>> &pv) {
+              return pv->label() == names[v];
+            });
+        if (it == ci.vars.end()) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in function [VTKOutput::WriteAggregated]"
+              << std::endl << "Variable '" << names[v] << "' is not on block "
+              << pmb->gid << std::endl;
+          ATHENA_ERROR(msg);
+        }
+        Variable<Real> &var = **it;
+        const int nc = ncomp[v];
+        for (int k=out_ks; k<=out_ke; ++k) {
+          for (int j=out_js; j<=out_je; ++j) {
+            for (int i=out_is; i<=out_ie; ++i) {
+              for (int n=0; n<nc; ++n)
+                row[nc*(i - out_is) + n] = static_cast<float>(var(n, k, j, i));
+            }
+            out.Put(row.data(), nc*(out_ie - out_is + 1));
+          }
+        }
+      }
+    }
+  }
+  const char footer[] = "\n</AppendedData>\n</VTKFile>\n";
+  std::fwrite(footer, 1, sizeof(footer) - 1, pfile);
+  std::fclose(pfile);
+
+  // the index of the rank files
+  if (Globals::my_rank == 0) {
+    const std::string iname = base + ".pvtu";
+    std::ofstream index(iname);
+    if (!index) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [VTKOutput::WriteAggregated]"
+          << std::endl << "Output file '" << iname << "' could not be opened"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    const std::string fbase = base.substr(base.find_last_of('/') + 1);
+    index << "<?xml version=\"1.0\"?>" << std::endl
+          << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\""
+          << byte_order << "\" header_type=\"UInt64\">" << std::endl
+          << "<PUnstructuredGrid GhostLevel=\"0\">" << std::endl
+          << "<PPoints>" << std::endl
+          << "<PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>" << std::endl
+          << "</PPoints>" << std::endl
+          << "<PCellData>" << std::endl
+          << "<PDataArray type=\"Int32\" Name=\"gid\"/>" << std::endl
+          << "<PDataArray type=\"Int32\" Name=\"level\"/>" << std::endl;
+    for (std::size_t n=0; n<names.size(); ++n) {
+      index << "<PDataArray type=\"Float32\" Name=\"" << names[n] << "\"";
+      if (ncomp[n] > 1) index << " NumberOfComponents=\"" << ncomp[n] << "\"";
+      index << "/>" << std::endl;
+    }
+    index << "</PCellData>" << std::endl;
+    for (int r=0; r<Globals::nranks; ++r)
+      index << "<Piece Source=\"" << fbase << "." << r << ".vtu\"/>" << std::endl;
+    index << "</PUnstructuredGrid>" << std::endl << "</VTKFile>" << std::endl;
+  }
+
+  // increment counters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+}
 }
@@ -51,12 +51,15 @@
 // C++ headers
 #include <algorithm>  // transform
 #include <cmath>      // std::fmod()
+#include <cstdint>    // std::uint64_t
 #include <cstdlib>    // atoi(), atof(), nullptr, std::size_t
 #include <fstream>    // ifstream
 #include <iostream>   // endl, ostream
 #include <sstream>    // stringstream
 #include <stdexcept>  // runtime_error
 #include <string>     // string
+#include <unordered_map>
+#include <vector>
 
 // Athena++ headers
 #include "athena.hpp"
@@ -70,16 +73,57 @@
 #endif
 
 namespace parthenon {
+namespace {
+// typed values of a parameter; the string is converted only on the first read after the
+// value was set, so that repeated Get calls (e.g. in per-block code) cost a lookup
+
+int IntegerValue(InputLine *pl) {
+  if (!pl->has_int) {
+    pl->int_value = atoi(pl->param_value.c_str());
+    pl->has_int = true;
+  }
+  return pl->int_value;
+}
+
+Real RealValue(InputLine *pl) {
+  if (!pl->has_real) {
+    pl->real_value = static_cast<Real>(atof(pl->param_value.c_str()));
+    pl->has_real = true;
+  }
+  return pl->real_value;
+}
+
+bool BooleanValue(InputLine *pl) {
+  if (!pl->has_bool) {
+    std::string val = pl->param_value;
+    // check is string contains integers 0 or 1 (instead of true or false)
+    if (val.compare(0, 1, "0")==0 || val.compare(0, 1, "1")==0) {
+      pl->bool_value = static_cast<bool>(atoi(val.c_str()));
+    } else {
+      // convert string to all lower case, then to bool
+      std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+      std::istringstream is(val);
+      bool b;
+      is >> std::boolalpha >> b;
+      pl->bool_value = b;
+    }
+    pl->has_bool = true;
+  }
+  return pl->bool_value;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // ParameterInput constructor
 
-ParameterInput::ParameterInput() :pfirst_block{}, last_filename_{} {
+ParameterInput::ParameterInput() : pfirst_block{}, last_filename_{}, plast_block_{} {
 #ifdef OPENMP_PARALLEL
   omp_init_lock(&lock_);
 #endif
 }
 
-ParameterInput::ParameterInput(std::string input_filename) : pfirst_block{}, last_filename_{} {
+ParameterInput::ParameterInput(std::string input_filename)
+    : pfirst_block{}, last_filename_{}, plast_block_{} {
 #ifdef OPENMP_PARALLEL
   omp_init_lock(&lock_);
 #endif
@@ -190,75 +234,91 @@ void ParameterInput::LoadFromStream(std::istream &is) {
 //! \fn  void ParameterInput::LoadFromFile(IOWrapper &input)
 //  \brief Read the parameters from an input file or restarting file.
 //         Return the position at the end of the header, which is used in restarting
+//  Only the master process reads the file.  The header text is sent to the other ranks
+//  in one broadcast and parsed by every rank, which yields the same table on all of them
+//  without any file system traffic from the other ranks.
 
 void ParameterInput::LoadFromFile(IOWrapper &input) {
-  std::stringstream par, msg;
-  constexpr int kBufSize = 4096;
-  char buf[kBufSize];
-  IOWrapperSizeT header = 0, ret, loc;
-
-  // search <par_end> or EOF.
-  do {
-    if (Globals::my_rank == 0) // only the master process reads the header from the file
-      ret = input.Read(buf, sizeof(char), kBufSize);
-#ifdef MPI_PARALLEL
-    // then broadcasts it
-    MPI_Bcast(&ret, sizeof(IOWrapperSizeT), MPI_BYTE, 0, MPI_COMM_WORLD);
-    MPI_Bcast(buf, ret, MPI_BYTE, 0, MPI_COMM_WORLD);
-#endif
-    par.write(buf, ret); // add the buffer into the stream
-    header += ret;
-    std::string sbuf = par.str(); // create string for search
-    loc = sbuf.find("<par_end>", 0); // search from the top of the stream
+  std::stringstream msg;
+  constexpr int kBufSize = 65536;
+  constexpr std::uint64_t kMaxHeader = 16*1024*1024;
+  std::string par;
+  // {length of the header in the file, number of bytes to parse}; zero bytes to parse
+  // with a nonzero header length signals that <par_end> was not found
+  std::uint64_t sizes[2] = {0, 0};
+
+  if (Globals::my_rank == 0) {
+    std::vector<char> buf(kBufSize);
+    std::size_t ret, loc;
+    // search <par_end> or EOF.  Only the new chunk and the tail of the previous one can
+    // contain the first occurrence, so the text read so far is not searched again.
+    do {
+      ret = input.Read(buf.data(), sizeof(char), kBufSize);
+      const std::size_t from = (par.size() > 8) ? par.size() - 8 : 0;
+      par.append(buf.data(), ret);
+      loc = par.find("<par_end>", from);
+    } while (loc == std::string::npos && ret == kBufSize && par.size() <= kMaxHeader);
+
     if (loc != std::string::npos) { // found <par_end>
-      header = loc + 10; // store the header length
-      break;
+      sizes[0] = loc + 10; // store the header length
+      par.resize(loc + 9); // nothing after <par_end> is parsed
+      sizes[1] = par.size();
+    } else if (par.size() > kMaxHeader) {
+      sizes[0] = par.size();
+    } else { // EOF
+      sizes[0] = sizes[1] = par.size();
     }
-    if (header > kBufSize*10) {
-      msg << "### FATAL ERROR in function [ParameterInput::LoadFromFile]"
-          << "<par_end> is not found in the first 40KBytes." << std::endl
-          << "Probably the file is broken or a wrong file is specified" << std::endl;
-      ATHENA_ERROR(msg);
-    }
-  } while (ret == kBufSize); // till EOF (or par_end is found)
+  }
+#ifdef MPI_PARALLEL
+  // then broadcasts it
+  MPI_Bcast(sizes, 2, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+#endif
+  if (sizes[1] == 0 && sizes[0] > 0) {
+    msg << "### FATAL ERROR in function [ParameterInput::LoadFromFile]"
+        << "<par_end> is not found in the first " << kMaxHeader/(1024*1024)
+        << " MBytes." << std::endl
+        << "Probably the file is broken or a wrong file is specified" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+#ifdef MPI_PARALLEL
+  par.resize(sizes[1]);
+  MPI_Bcast(&par[0], static_cast<int>(sizes[1]), MPI_CHAR, 0, MPI_COMM_WORLD);
+#endif
 
-  // Now par contains the parameter inputs + some additional including <par_end>
+  // Now par contains the parameter inputs, up to and including <par_end>
   // Read the stream and load the parameters
-  LoadFromStream(par);
+  std::istringstream is(par);
+  LoadFromStream(is);
   // Seek the file to the end of the header
-  input.Seek(header);
+  input.Seek(sizes[0]);
 
   return;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn InputBlock* ParameterInput::FindOrAddBlock(std::string name)
+//! \fn InputBlock* ParameterInput::FindOrAddBlock(const std::string &name)
 //  \brief find or add specified InputBlock.  Returns pointer to block.
 
-InputBlock* ParameterInput::FindOrAddBlock(std::string name) {
-  InputBlock *pib, *plast;
-  plast = pfirst_block;
-  pib = pfirst_block;
-
-  // Search singly linked list of InputBlocks to see if name exists, return if found.
-  while (pib != nullptr) {
-    if (name.compare(pib->block_name) == 0) return pib;
-    plast = pib;
-    pib = pib->pnext;
-  }
+InputBlock* ParameterInput::FindOrAddBlock(const std::string &name) {
+  // Look up the name in the index of InputBlocks, return if found.
+  InputBlock *pib = GetPtrToBlock(name);
+  if (pib != nullptr) return pib;
 
   // Create new block in list if not found above
   pib = new InputBlock;
   pib->block_name.assign(name);  // store the new block name
   pib->pline = nullptr;             // Terminate the InputLine list
+  pib->plast_line = nullptr;
   pib->pnext = nullptr;             // Terminate the InputBlock list
 
   // if this is the first block in list, save pointer to it in class
   if (pfirst_block == nullptr) {
     pfirst_block = pib;
   } else {
-    plast->pnext = pib;      // link new node into list
+    plast_block_->pnext = pib;      // link new node into list
   }
+  plast_block_ = pib;
+  block_index_[name] = pib;
 
   return pib;
 }
@@ -303,28 +363,21 @@ void ParameterInput::ParseLine(InputBlock *pib, std::string line,
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void ParameterInput::AddParameter(InputBlock *pb, std::string name,
-//   std::string value, std::string comment)
+//! \fn void ParameterInput::AddParameter(InputBlock *pb, const std::string &name,
+//   const std::string &value, const std::string &comment)
 //  \brief add name/value/comment tuple to the InputLine singly linked list in block *pb.
 //  If a parameter with the same name already exists, the value and comment strings
 //  are replaced (overwritten).
 
-void ParameterInput::AddParameter(InputBlock *pb, std::string name,
-                                  std::string value, std::string comment) {
-  InputLine *pl, *plast;
-  // Search singly linked list of InputLines to see if name exists.  This also sets *plast
-  // to point to the tail node (but not storing a pointer to the tail node in InputBlock)
-  pl = pb->pline;
-  plast = pb->pline;
-  while (pl != nullptr) {
-    if (name.compare(pl->param_name) == 0) {   // param name already exists
-      pl->param_value.assign(value);           // replace existing param value
-      pl->param_comment.assign(comment);       // replace exisiting param comment
-      if (value.length() > pb->max_len_parvalue) pb->max_len_parvalue = value.length();
-      return;
-    }
-    plast = pl;
-    pl = pl->pnext;
+void ParameterInput::AddParameter(InputBlock *pb, const std::string &name,
+                                  const std::string &value, const std::string &comment) {
+  // Look up the name in the index of InputLines to see if it exists.
+  InputLine *pl = pb->GetPtrToLine(name);
+  if (pl != nullptr) {                         // param name already exists
+    pl->SetValue(value);                       // replace existing param value
+    pl->param_comment.assign(comment);         // replace exisiting param comment
+    if (value.length() > pb->max_len_parvalue) pb->max_len_parvalue = value.length();
+    return;
   }
 
   // Create new node in singly linked list if name does not already exist
@@ -340,10 +393,12 @@ void ParameterInput::AddParameter(InputBlock *pb, std::string name,
     pb->max_len_parname = name.length();
     pb->max_len_parvalue = value.length();
   } else {
-    plast->pnext = pl;  // link new node into list
+    pb->plast_line->pnext = pl;  // link new node into list
     if (name.length() > pb->max_len_parname) pb->max_len_parname = name.length();
     if (value.length() > pb->max_len_parvalue) pb->max_len_parvalue = value.length();
   }
+  pb->plast_line = pl;
+  pb->line_index[name] = pl;
 
   return;
 }
@@ -388,220 +443,134 @@ void ParameterInput::ModifyFromCmdline(int argc, char *argv[]) {
           << "' on command line not found";
       ATHENA_ERROR(msg);
     }
-    pl->param_value.assign(value);   // replace existing value
+    pl->SetValue(value);   // replace existing value
 
     if (value.length() > pb->max_len_parvalue) pb->max_len_parvalue = value.length();
   }
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn InputBlock* ParameterInput::GetPtrToBlock(std::string name)
+//! \fn InputBlock* ParameterInput::GetPtrToBlock(const std::string &name)
 //  \brief return pointer to specified InputBlock if it exists
 
-InputBlock* ParameterInput::GetPtrToBlock(std::string name) {
-  InputBlock *pb;
-  for (pb = pfirst_block; pb != nullptr; pb = pb->pnext) {
-    if (name.compare(pb->block_name) == 0) return pb;
-  }
-  return nullptr;
+InputBlock* ParameterInput::GetPtrToBlock(const std::string &name) {
+  auto it = block_index_.find(name);
+  return (it == block_index_.end() ? nullptr : it->second);
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn int ParameterInput::DoesParameterExist(std::string block, std::string name)
-//  \brief check whether parameter of given name in given block exists
+//! \fn InputLine* ParameterInput::GetPtrToLine(const char *caller,
+//    const std::string &block, const std::string &name)
+//  \brief return pointer to the InputLine of block/name, error if it does not exist
 
-int ParameterInput::DoesParameterExist(std::string block, std::string name) {
-  InputLine *pl;
-  InputBlock *pb;
-  pb = GetPtrToBlock(block);
-  if (pb == nullptr) return 0;
-  pl = pb->GetPtrToLine(name);
-  return (pl == nullptr ? 0 : 1);
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn int ParameterInput::DoesBlockExist(std::string block)
-//  \brief check whether block exists
-
-int ParameterInput::DoesBlockExist(std::string block) {
-  InputLine *pl;
-  InputBlock *pb;
-  pb = GetPtrToBlock(block);
-  if (pb == nullptr) return 0;
-  return 1;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn int ParameterInput::GetInteger(std::string block, std::string name)
-//  \brief returns integer value of string stored in block/name
-
-int ParameterInput::GetInteger(std::string block, std::string name) {
-  InputBlock* pb;
-  InputLine* pl;
+InputLine* ParameterInput::GetPtrToLine(const char *caller, const std::string &block,
+                                        const std::string &name) {
   std::stringstream msg;
 
-  Lock();
-
   // get pointer to node with same block name in singly linked list of InputBlocks
-  pb = GetPtrToBlock(block);
+  InputBlock *pb = GetPtrToBlock(block);
   if (pb == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetInteger]" << std::endl
+    msg << "### FATAL ERROR in function [ParameterInput::" << caller << "]" << std::endl
         << "Block name '" << block << "' not found when trying to set value "
         << "for parameter '" << name << "'";
     ATHENA_ERROR(msg);
   }
 
   // get pointer to node with same parameter name in singly linked list of InputLines
-  pl = pb->GetPtrToLine(name);
+  InputLine *pl = pb->GetPtrToLine(name);
   if (pl == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetInteger]" << std::endl
+    msg << "### FATAL ERROR in function [ParameterInput::" << caller << "]" << std::endl
         << "Parameter name '" << name << "' not found in block '" << block << "'";
     ATHENA_ERROR(msg);
   }
+  return pl;
+}
 
-  std::string val=pl->param_value;
-  Unlock();
+//----------------------------------------------------------------------------------------
+//! \fn int ParameterInput::DoesParameterExist(const std::string &block,
+//    const std::string &name)
+//  \brief check whether parameter of given name in given block exists
 
-  // Convert string to integer and return value
-  return atoi(val.c_str());
+int ParameterInput::DoesParameterExist(const std::string &block,
+                                       const std::string &name) {
+  InputBlock *pb = GetPtrToBlock(block);
+  if (pb == nullptr) return 0;
+  return (pb->GetPtrToLine(name) == nullptr ? 0 : 1);
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn Real ParameterInput::GetReal(std::string block, std::string name)
-//  \brief returns real value of string stored in block/name
+//! \fn int ParameterInput::DoesBlockExist(const std::string &block)
+//  \brief check whether block exists
 
-Real ParameterInput::GetReal(std::string block, std::string name) {
-  InputBlock* pb;
-  InputLine* pl;
-  std::stringstream msg;
+int ParameterInput::DoesBlockExist(const std::string &block) {
+  return (GetPtrToBlock(block) == nullptr ? 0 : 1);
+}
 
-  Lock();
+//----------------------------------------------------------------------------------------
+//! \fn int ParameterInput::GetInteger(const std::string &block, const std::string &name)
+//  \brief returns integer value of string stored in block/name
 
-  // get pointer to node with same block name in singly linked list of InputBlocks
-  pb = GetPtrToBlock(block);
-  if (pb == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Block name '" << block << "' not found when trying to set value "
-        << "for parameter '" << name << "'";
-    ATHENA_ERROR(msg);
-  }
+int ParameterInput::GetInteger(const std::string &block, const std::string &name) {
+  Lock();
+  int ret = IntegerValue(GetPtrToLine("GetInteger", block, name));
+  Unlock();
+  return ret;
+}
 
-  // get pointer to node with same parameter name in singly linked list of InputLines
-  pl = pb->GetPtrToLine(name);
-  if (pl == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Parameter name '" << name << "' not found in block '" << block << "'";
-    ATHENA_ERROR(msg);
-  }
+//----------------------------------------------------------------------------------------
+//! \fn Real ParameterInput::GetReal(const std::string &block, const std::string &name)
+//  \brief returns real value of string stored in block/name
 
-  std::string val=pl->param_value;
+Real ParameterInput::GetReal(const std::string &block, const std::string &name) {
+  Lock();
+  Real ret = RealValue(GetPtrToLine("GetReal", block, name));
   Unlock();
-
-  // Convert string to real and return value
-  return static_cast<Real>(atof(val.c_str()));
+  return ret;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn bool ParameterInput::GetBoolean(std::string block, std::string name)
+//! \fn bool ParameterInput::GetBoolean(const std::string &block, const std::string &name)
 //  \brief returns boolean value of string stored in block/name
 
-bool ParameterInput::GetBoolean(std::string block, std::string name) {
-  InputBlock* pb;
-  InputLine* pl;
-  std::stringstream msg;
-
+bool ParameterInput::GetBoolean(const std::string &block, const std::string &name) {
   Lock();
-
-  // get pointer to node with same block name in singly linked list of InputBlocks
-  pb = GetPtrToBlock(block);
-  if (pb == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Block name '" << block << "' not found when trying to set value "
-        << "for parameter '" << name << "'";
-    ATHENA_ERROR(msg);
-  }
-
-  // get pointer to node with same parameter name in singly linked list of InputLines
-  pl = pb->GetPtrToLine(name);
-  if (pl == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Parameter name '" << name << "' not found in block '" << block << "'";
-    ATHENA_ERROR(msg);
-  }
-
-  std::string val=pl->param_value;
+  bool ret = BooleanValue(GetPtrToLine("GetBoolean", block, name));
   Unlock();
-
-  // check is string contains integers 0 or 1 (instead of true or false) and return
-  if (val.compare(0, 1, "0")==0 || val.compare(0, 1, "1")==0) {
-    return static_cast<bool>(atoi(val.c_str()));
-  }
-
-  // convert string to all lower case
-  std::transform(val.begin(), val.end(), val.begin(), ::tolower);
-  // Convert string to bool and return value
-  bool b;
-  std::istringstream is(val);
-  is >> std::boolalpha >> b;
-
-  return (b);
+  return ret;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn std::string ParameterInput::GetString(std::string block, std::string name)
+//! \fn std::string ParameterInput::GetString(const std::string &block,
+//    const std::string &name)
 //  \brief returns string stored in block/name
 
-std::string ParameterInput::GetString(std::string block, std::string name) {
-  InputBlock* pb;
-  InputLine* pl;
-  std::stringstream msg;
-
+std::string ParameterInput::GetString(const std::string &block,
+                                      const std::string &name) {
   Lock();
-
-  // get pointer to node with same block name in singly linked list of InputBlocks
-  pb = GetPtrToBlock(block);
-  if (pb == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Block name '" << block << "' not found when trying to set value "
-        << "for parameter '" << name << "'";
-    ATHENA_ERROR(msg);
-  }
-
-  // get pointer to node with same parameter name in singly linked list of InputLines
-  pl = pb->GetPtrToLine(name);
-  if (pl == nullptr) {
-    msg << "### FATAL ERROR in function [ParameterInput::GetReal]" << std::endl
-        << "Parameter name '" << name << "' not found in block '" << block << "'";
-    ATHENA_ERROR(msg);
-  }
-
-  std::string val=pl->param_value;
+  std::string ret = GetPtrToLine("GetString", block, name)->param_value;
   Unlock();
-
-  // return value
-  return val;
+  return ret;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn int ParameterInput::GetOrAddInteger(std::string block, std::string name,
-//    int default_value)
+//! \fn int ParameterInput::GetOrAddInteger(const std::string &block,
+//    const std::string &name, int default_value)
 //  \brief returns integer value stored in block/name if it exists, or creates and sets
 //  value to def_value if it does not exist
 
-int ParameterInput::GetOrAddInteger(std::string block, std::string name, int def_value) {
-  InputBlock* pb;
+int ParameterInput::GetOrAddInteger(const std::string &block, const std::string &name,
+                                    int def_value) {
+  InputBlock *pb;
   InputLine *pl;
   std::stringstream ss_value;
   int ret;
 
   Lock();
-  if (DoesParameterExist(block, name)) {
-    pb = GetPtrToBlock(block);
-    pl = pb->GetPtrToLine(name);
-    std::string val = pl->param_value;
-    ret = atoi(val.c_str());
+  pb = FindOrAddBlock(block);
+  pl = pb->GetPtrToLine(name);
+  if (pl != nullptr) {
+    ret = IntegerValue(pl);
   } else {
-    pb = FindOrAddBlock(block);
     ss_value << def_value;
     AddParameter(pb, name, ss_value.str(), "# Default value added at run time");
     ret = def_value;
@@ -611,25 +580,24 @@ int ParameterInput::GetOrAddInteger(std::string block, std::string name, int def
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn Real ParameterInput::GetOrAddReal(std::string block, std::string name,
-//    Real def_value)
+//! \fn Real ParameterInput::GetOrAddReal(const std::string &block,
+//    const std::string &name, Real def_value)
 //  \brief returns real value stored in block/name if it exists, or creates and sets
 //  value to def_value if it does not exist
 
-Real ParameterInput::GetOrAddReal(std::string block, std::string name, Real def_value) {
-  InputBlock* pb;
+Real ParameterInput::GetOrAddReal(const std::string &block, const std::string &name,
+                                  Real def_value) {
+  InputBlock *pb;
   InputLine *pl;
   std::stringstream ss_value;
   Real ret;
 
   Lock();
-  if (DoesParameterExist(block, name)) {
-    pb = GetPtrToBlock(block);
-    pl = pb->GetPtrToLine(name);
-    std::string val = pl->param_value;
-    ret = static_cast<Real>(atof(val.c_str()));
+  pb = FindOrAddBlock(block);
+  pl = pb->GetPtrToLine(name);
+  if (pl != nullptr) {
+    ret = RealValue(pl);
   } else {
-    pb = FindOrAddBlock(block);
     ss_value << def_value;
     AddParameter(pb, name, ss_value.str(), "# Default value added at run time");
     ret = def_value;
@@ -639,31 +607,24 @@ Real ParameterInput::GetOrAddReal(std::string block, std::string name, Real def_
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn bool ParameterInput::GetOrAddBoolean(std::string block, std::string name,
-//    bool def_value)
+//! \fn bool ParameterInput::GetOrAddBoolean(const std::string &block,
+//    const std::string &name, bool def_value)
 //  \brief returns boolean value stored in block/name if it exists, or creates and sets
 //  value to def_value if it does not exist
 
-bool ParameterInput::GetOrAddBoolean(std::string block,std::string name, bool def_value) {
-  InputBlock* pb;
+bool ParameterInput::GetOrAddBoolean(const std::string &block, const std::string &name,
+                                     bool def_value) {
+  InputBlock *pb;
   InputLine *pl;
   std::stringstream ss_value;
   bool ret;
 
   Lock();
-  if (DoesParameterExist(block, name)) {
-    pb = GetPtrToBlock(block);
-    pl = pb->GetPtrToLine(name);
-    std::string val = pl->param_value;
-    if (val.compare(0, 1, "0")==0 || val.compare(0, 1, "1")==0) {
-      ret = static_cast<bool>(atoi(val.c_str()));
-    } else {
-      std::transform(val.begin(), val.end(), val.begin(), ::tolower);
-      std::istringstream is(val);
-      is >> std::boolalpha >> ret;
-    }
+  pb = FindOrAddBlock(block);
+  pl = pb->GetPtrToLine(name);
+  if (pl != nullptr) {
+    ret = BooleanValue(pl);
   } else {
-    pb = FindOrAddBlock(block);
     ss_value << def_value;
     AddParameter(pb, name, ss_value.str(), "# Default value added at run time");
     ret = def_value;
@@ -673,25 +634,24 @@ bool ParameterInput::GetOrAddBoolean(std::string block,std::string name, bool de
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn std::string ParameterInput::GetOrAddString(std::string block, std::string name,
-//                                                 std::string def_value)
+//! \fn std::string ParameterInput::GetOrAddString(const std::string &block,
+//    const std::string &name, const std::string &def_value)
 //  \brief returns string value stored in block/name if it exists, or creates and sets
 //  value to def_value if it does not exist
 
-std::string ParameterInput::GetOrAddString(std::string block, std::string name,
-                                           std::string def_value) {
-  InputBlock* pb;
+std::string ParameterInput::GetOrAddString(const std::string &block,
+                                           const std::string &name,
+                                           const std::string &def_value) {
+  InputBlock *pb;
   InputLine *pl;
-  std::stringstream ss_value;
   std::string ret;
 
   Lock();
-  if (DoesParameterExist(block, name)) {
-    pb = GetPtrToBlock(block);
-    pl = pb->GetPtrToLine(name);
+  pb = FindOrAddBlock(block);
+  pl = pb->GetPtrToLine(name);
+  if (pl != nullptr) {
     ret = pl->param_value;
   } else {
-    pb = FindOrAddBlock(block);
     AddParameter(pb, name, def_value, "# Default value added at run time");
     ret = def_value;
   }
@@ -700,10 +660,12 @@ std::string ParameterInput::GetOrAddString(std::string block, std::string name,
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn int ParameterInput::SetInteger(std::string block, std::string name, int value)
+//! \fn int ParameterInput::SetInteger(const std::string &block,
+//    const std::string &name, int value)
 //  \brief updates an integer parameter; creates it if it does not exist
 
-int ParameterInput::SetInteger(std::string block, std::string name, int value) {
+int ParameterInput::SetInteger(const std::string &block, const std::string &name,
+                               int value) {
   InputBlock* pb;
   std::stringstream ss_value;
 
@@ -716,10 +678,12 @@ int ParameterInput::SetInteger(std::string block, std::string name, int value) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn Real ParameterInput::SetReal(std::string block, std::string name, Real value)
+//! \fn Real ParameterInput::SetReal(const std::string &block,
+//    const std::string &name, Real value)
 //  \brief updates a real parameter; creates it if it does not exist
 
-Real ParameterInput::SetReal(std::string block, std::string name, Real value) {
+Real ParameterInput::SetReal(const std::string &block, const std::string &name,
+                             Real value) {
   InputBlock* pb;
   std::stringstream ss_value;
 
@@ -732,10 +696,12 @@ Real ParameterInput::SetReal(std::string block, std::string name, Real value) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn bool ParameterInput::SetBoolean(std::string block, std::string name, bool value)
+//! \fn bool ParameterInput::SetBoolean(const std::string &block,
+//    const std::string &name, bool value)
 //  \brief updates a boolean parameter; creates it if it does not exist
 
-bool ParameterInput::SetBoolean(std::string block, std::string name, bool value) {
+bool ParameterInput::SetBoolean(const std::string &block, const std::string &name,
+                                bool value) {
   InputBlock* pb;
   std::stringstream ss_value;
 
@@ -748,12 +714,13 @@ bool ParameterInput::SetBoolean(std::string block, std::string name, bool value)
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn std::string ParameterInput::SetString(std::string block, std::string name,
-//                                            std::string  value)
+//! \fn std::string ParameterInput::SetString(const std::string &block,
+//    const std::string &name, const std::string &value)
 //  \brief updates a string parameter; creates it if it does not exist
 
-std::string ParameterInput::SetString(std::string block, std::string name,
-                                      std::string value) {
+std::string ParameterInput::SetString(const std::string &block,
+                                      const std::string &name,
+                                      const std::string &value) {
   InputBlock* pb;
 
   Lock();
@@ -876,14 +843,12 @@ void ParameterInput::ParameterDump(std::ostream& os) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn InputLine* InputBlock::GetPtrToLine(std::string name)
+//! \fn InputLine* InputBlock::GetPtrToLine(const std::string &name)
 //  \brief return pointer to InputLine containing specified parameter if it exists
 
-InputLine* InputBlock::GetPtrToLine(std::string name) {
-  for (InputLine* pl = pline; pl != nullptr; pl = pl->pnext) {
-    if (name.compare(pl->param_name) == 0) return pl;
-  }
-  return nullptr;
+InputLine* InputBlock::GetPtrToLine(const std::string &name) {
+  auto it = line_index.find(name);
+  return (it == line_index.end() ? nullptr : it->second);
 }
 
 
@@ -28,6 +28,7 @@
 #include <cstddef>  // std::size_t
 #include <ostream>  // ostream
 #include <string>   // string
+#include <unordered_map>
 
 // Athena++ headers
 #include "athena.hpp"
@@ -49,6 +50,17 @@ struct InputLine {
   std::string param_value;   // value of the parameter is stored as a string!
   std::string param_comment;
   InputLine *pnext;   // pointer to the next node in this nested singly linked list
+
+  // conversions of param_value, made on the first typed read and reset by SetValue()
+  bool has_int = false, has_real = false, has_bool = false;
+  int int_value;
+  Real real_value;
+  bool bool_value;
+
+  void SetValue(const std::string &value) {
+    param_value.assign(value);
+    has_int = has_real = has_bool = false;
+  }
 };
 
 //----------------------------------------------------------------------------------------
@@ -67,10 +79,11 @@ class InputBlock {
   InputBlock *pnext;  // pointer to the next node in InputBlock singly linked list
 
   InputLine *pline;   // pointer to head node in nested singly linked list (in this block)
-  // (not storing a reference to the tail node)
+  InputLine *plast_line; // pointer to tail node, so that appending does not walk the list
+  std::unordered_map<std::string, InputLine*> line_index; // hashed lookup by name
 
   // functions
-  InputLine* GetPtrToLine(std::string name);
+  InputLine* GetPtrToLine(const std::string &name);
 };
 
 //----------------------------------------------------------------------------------------
@@ -87,39 +100,44 @@ class ParameterInput {
 
   // data
   InputBlock* pfirst_block;   // pointer to head node in singly linked list of InputBlock
-  // (not storing a reference to the tail node)
 
   // functions
   void LoadFromStream(std::istream &is);
   void LoadFromFile(IOWrapper &input);
   void ModifyFromCmdline(int argc, char *argv[]);
   void ParameterDump(std::ostream& os);
-  int  DoesParameterExist(std::string block, std::string name);
-  int  DoesBlockExist(std::string block);
-  int  GetInteger(std::string block, std::string name);
-  int  GetOrAddInteger(std::string block, std::string name, int value);
-  int  SetInteger(std::string block, std::string name, int value);
-  Real GetReal(std::string block, std::string name);
-  Real GetOrAddReal(std::string block, std::string name, Real value);
-  Real SetReal(std::string block, std::string name, Real value);
-  bool GetBoolean(std::string block, std::string name);
-  bool GetOrAddBoolean(std::string block, std::string name, bool value);
-  bool SetBoolean(std::string block, std::string name, bool value);
-  std::string GetString(std::string block, std::string name);
-  std::string GetOrAddString(std::string block, std::string name, std::string value);
-  std::string SetString(std::string block, std::string name, std::string value);
+  int  DoesParameterExist(const std::string &block, const std::string &name);
+  int  DoesBlockExist(const std::string &block);
+  int  GetInteger(const std::string &block, const std::string &name);
+  int  GetOrAddInteger(const std::string &block, const std::string &name, int value);
+  int  SetInteger(const std::string &block, const std::string &name, int value);
+  Real GetReal(const std::string &block, const std::string &name);
+  Real GetOrAddReal(const std::string &block, const std::string &name, Real value);
+  Real SetReal(const std::string &block, const std::string &name, Real value);
+  bool GetBoolean(const std::string &block, const std::string &name);
+  bool GetOrAddBoolean(const std::string &block, const std::string &name, bool value);
+  bool SetBoolean(const std::string &block, const std::string &name, bool value);
+  std::string GetString(const std::string &block, const std::string &name);
+  std::string GetOrAddString(const std::string &block, const std::string &name,
+                             const std::string &value);
+  std::string SetString(const std::string &block, const std::string &name,
+                        const std::string &value);
   void RollbackNextTime();
   void ForwardNextTime(Real time);
 
  private:
   std::string last_filename_;  // last input file opened, to prevent duplicate reads
+  InputBlock *plast_block_;    // tail node of the InputBlock list
+  std::unordered_map<std::string, InputBlock*> block_index_; // hashed lookup by name
 
-  InputBlock* FindOrAddBlock(std::string name);
-  InputBlock* GetPtrToBlock(std::string name);
+  InputBlock* FindOrAddBlock(const std::string &name);
+  InputBlock* GetPtrToBlock(const std::string &name);
+  InputLine* GetPtrToLine(const char *caller, const std::string &block,
+                          const std::string &name);
   void ParseLine(InputBlock *pib, std::string line, std::string& name,
                  std::string& value, std::string& comment);
-  void AddParameter(InputBlock *pib, std::string name, std::string value,
-                    std::string comment);
+  void AddParameter(InputBlock *pib, const std::string &name, const std::string &value,
+                    const std::string &comment);
 
   // thread safety
 #ifdef OPENMP_PARALLEL
@@ -18,6 +18,11 @@
 #include "interface/Update.hpp"
 #include <Kokkos_Core.hpp>
 #include "parthenon_manager.hpp"
+#include "utils/comm_stats.hpp"
+#include "utils/loop_tuning.hpp"
+#include "utils/memory_usage.hpp"
+#include "utils/timers.hpp"
+#include "utils/trace.hpp"
 
 namespace parthenon {
 
@@ -88,6 +93,11 @@ ParthenonStatus ParthenonManager::ParthenonInit(int argc, char *argv[]) {
     pinput = std::make_unique<ParameterInput>(arg.input_filename);
   }
   pinput->ModifyFromCmdline(argc, argv);
+  Timers::Initialize(pinput.get());
+  Trace::Initialize(pinput.get());
+  CommStats::Initialize(pinput.get());
+  LoopTuning::Initialize(pinput.get());
+  MemoryUsage::Initialize(pinput.get());
 
   // read in/set up application specific properties
   auto properties = ProcessProperties(pinput);
@@ -123,6 +133,8 @@ ParthenonStatus ParthenonManager::ParthenonInit(int argc, char *argv[]) {
 }
 
 void ParthenonManager::PreDriver() {
+  pmesh->OutputStartupTimes();
+  MemoryUsage::Report(pmesh.get(), "startup");
   if (Globals::my_rank == 0) {
     std::cout << std::endl << "Setup complete, entering main loop...\n" << std::endl;
   }
@@ -137,7 +149,10 @@ void ParthenonManager::PostDriver(DriverStatus driver_status) {
   if (Globals::my_rank == 0)
     SignalHandler::CancelWallTimeAlarm();
 
-  pouts->MakeOutputs(pmesh.get(), pinput.get());
+  {
+    Timers::ScopedRegion region("Outputs");
+    pouts->MakeOutputs(pmesh.get(), pinput.get());
+  }
 
   // Print diagnostic messages related to the end of the simulation
   if (Globals::my_rank == 0) {
@@ -180,9 +195,19 @@ void ParthenonManager::PostDriver(DriverStatus driver_status) {
     std::cout << "zone-cycles/omp_wsecond = " << zc_omps << std::endl;
 #endif
   }
+
+  // collective, so outside of the rank 0 block
+  Timers::Report(std::cout);
+  CommStats::Report(std::cout, true);
+  MemoryUsage::Report(pmesh.get(), "end of run");
+  Trace::Write();
+  LoopTuning::WriteCache();
 }
 
 ParthenonStatus ParthenonManager::ParthenonFinalize() {
+  // outputs may still be completing collective operations, e.g. the history reduction
+  if (pouts != nullptr) pouts->FinishOutputs();
+  pouts.reset();
   Kokkos::finalize();
 #ifdef MPI_PARALLEL
   MPI_Finalize();
@@ -24,6 +24,7 @@
 //========================================================================================
 
 #include "reconstruction.hpp"
+#include "kokkos_abstraction.hpp"
 #include "mesh/mesh.hpp"
 
 namespace parthenon {
@@ -249,4 +250,131 @@ void Reconstruction::PiecewiseLinearX3(
   }
   return;
 }
+
+namespace {
+// a where mask is 1 and b where it is 0, exact for finite a and b.  Used instead of
+// branches, which are not if-converted around FP operations that could trap
+inline Real Select(const Real mask, const Real a, const Real b) {
+  return mask*a + (1.0 - mask)*b;
+}
+
+//----------------------------------------------------------------------------------------
+//! \class PLMPencil
+//  \brief PLM of one (n,k,j) pencil of a block in direction DIR.  Same limiters as
+//  PiecewiseLinearX1/X2/X3, with the uniform-mesh variant selected at compile time.
+
+template <int DIR, bool kUniform>
+class PLMPencil {
+ public:
+  PLMPencil(const Coordinates &co, const AthenaArray<Real> &q, AthenaArray<Real> &ql,
+            AthenaArray<Real> &qr, const int il, const int iu) :
+      q_(q.data()), ql_(ql.data()), qr_(qr.data()), il_(il), iu_(iu),
+      nx1_(q.GetDim1()), nx2_(q.GetDim2()), nx3_(q.GetDim3()) {
+    const AthenaArray<Real> &xf =
+        (DIR == X1DIR ? co.x1f : (DIR == X2DIR ? co.x2f : co.x3f));
+    const AthenaArray<Real> &xv =
+        (DIR == X1DIR ? co.x1v : (DIR == X2DIR ? co.x2v : co.x3v));
+    const AthenaArray<Real> &dxf =
+        (DIR == X1DIR ? co.dx1f : (DIR == X2DIR ? co.dx2f : co.dx3f));
+    const AthenaArray<Real> &dxv =
+        (DIR == X1DIR ? co.dx1v : (DIR == X2DIR ? co.dx2v : co.dx3v));
+    xf_ = xf.data();
+    xv_ = xv.data();
+    dxf_ = dxf.data();
+    dxv_ = dxv.data();
+    stride_ = (DIR == X1DIR ? 1 : (DIR == X2DIR ? nx1_ : nx1_*nx2_));
+  }
+
+  void operator()(const int n, const int k, const int j) const {
+    const int base = nx1_*(j + nx2_*(k + nx3_*n));
+    const int s = stride_, il = il_, iu = iu_;
+    // local copies, so that stores through ql/qr cannot alias the loop bounds
+    const Real *q = q_;
+    Real *ql = ql_, *qr = qr_;
+    // in x2 and x3 the geometric factors are the same for the whole pencil
+    Factors row{};
+    if (DIR != X1DIR) row = GetFactors(DIR == X2DIR ? j : k);
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      const int c = base + i;
+      const Factors f = (DIR == X1DIR ? GetFactors(i) : row);
+      const Real qc = q[c];
+      const Real dql = qc - q[c-s];
+      const Real dqr = q[c+s] - qc;
+      // limited slope, zero unless dq2 > 0 (masked so that the loop has no branches)
+      Real dqm;
+      if (kUniform) {
+        const Real dq2 = dql*dqr;
+        const Real m = static_cast<Real>(dq2 > 0.0);
+        dqm = m*(2.0*dq2/Select(m, dql + dqr, 1.0));
+      } else {
+        const Real dqF = dqr*f.dxF;
+        const Real dqB = dql*f.dxB;
+        const Real dq2 = dqF*dqB;
+        const Real m = static_cast<Real>(dq2 > 0.0);
+        if (DIR == X3DIR) {
+          // original VL limiter (Mignone eq 36)
+          dqm = m*(2.0*dq2/Select(m, dqF + dqB, 1.0));
+        } else {
+          // (modified) VL limiter (Mignone eq 37)
+          dqm = m*(dq2*(f.cf*dqB + f.cb*dqF)/
+                   Select(m, SQR(dqB) + SQR(dqF) + dq2*(f.cf + f.cb - 2.0), 1.0));
+        }
+      }
+      // Mignone equation 30
+      ql[c+s] = qc + f.dxp*dqm;
+      qr[c  ] = qc - f.dxm*dqm;
+    }
+  }
+
+ private:
+  // geometric factors of cell x: slope scalings and Mignone eq 33 coefficients of the
+  // nonuniform limiter, and the center-to-face distances of Mignone eq 30
+  struct Factors {
+    Real dxF, dxB, cf, cb, dxp, dxm;
+  };
+  Factors GetFactors(const int x) const {
+    Factors f;
+    f.dxF = dxf_[x]/dxv_[x];
+    f.dxB = dxf_[x]/dxv_[x-1];
+    f.cf = dxv_[x  ]/(xf_[x+1] - xv_[x]);
+    f.cb = dxv_[x-1]/(xv_[x  ] - xf_[x]);
+    f.dxp = (xf_[x+1] - xv_[x])/dxf_[x];
+    f.dxm = (xv_[x  ] - xf_[x])/dxf_[x];
+    return f;
+  }
+
+  const Real *q_;
+  Real *ql_, *qr_;
+  const Real *xf_, *xv_, *dxf_, *dxv_;
+  int il_, iu_, nx1_, nx2_, nx3_, stride_;
+};
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::PiecewiseLinearBlock()
+//  \brief PLM of all variables over a block in a single parallel loop over pencils
+
+void Reconstruction::PiecewiseLinearBlock(
+    const int dir, const int kl, const int ku, const int jl, const int ju,
+    const int il, const int iu, const AthenaArray<Real> &q,
+    AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
+  const Coordinates &co = *pmy_block_->pcoord;
+  const int nu = q.GetDim4() - 1;
+  auto launch = [&](const auto &kernel) {
+    par_for_pencils("Reconstruction::PiecewiseLinearBlock",
+                    Kokkos::DefaultHostExecutionSpace(), 0, nu, kl, ku, jl, ju, kernel);
+  };
+  if (dir == X1DIR) {
+    if (uniform[X1DIR]) launch(PLMPencil<X1DIR, true>(co, q, ql, qr, il, iu));
+    else                launch(PLMPencil<X1DIR, false>(co, q, ql, qr, il, iu));
+  } else if (dir == X2DIR) {
+    if (uniform[X2DIR]) launch(PLMPencil<X2DIR, true>(co, q, ql, qr, il, iu));
+    else                launch(PLMPencil<X2DIR, false>(co, q, ql, qr, il, iu));
+  } else {
+    if (uniform[X3DIR]) launch(PLMPencil<X3DIR, true>(co, q, ql, qr, il, iu));
+    else                launch(PLMPencil<X3DIR, false>(co, q, ql, qr, il, iu));
+  }
+  return;
+}
 }
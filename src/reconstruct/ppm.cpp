@@ -38,6 +38,7 @@
 //========================================================================================
 
 #include "reconstruction.hpp"
+#include "kokkos_abstraction.hpp"
 
 namespace parthenon {
 //----------------------------------------------------------------------------------------
@@ -782,4 +783,202 @@ void Reconstruction::PiecewiseParabolicX3(
   }
   return;
 }
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \class PPMPencil
+//  \brief PPM of one (n,k,j) pencil of a block in direction DIR, keeping the stencil in
+//  registers instead of scratch rows.  Same limiters as PiecewiseParabolicX1/X2/X3; on
+//  uniform meshes the interpolation weights are compile-time constants (Mignone eq B.4)
+
+template <int DIR, bool kUniform>
+class PPMPencil {
+ public:
+  PPMPencil(const Reconstruction &recon, const AthenaArray<Real> &q,
+            AthenaArray<Real> &ql, AthenaArray<Real> &qr, const int il, const int iu) :
+      q_(q.data()), ql_(ql.data()), qr_(qr.data()), il_(il), iu_(iu),
+      nx1_(q.GetDim1()), nx2_(q.GetDim2()), nx3_(q.GetDim3()) {
+    if (DIR == X1DIR) {
+      SetCoefficients(recon.c1i, recon.c2i, recon.c3i, recon.c4i, recon.c5i, recon.c6i,
+                      recon.hplus_ratio_i, recon.hminus_ratio_i);
+    } else if (DIR == X2DIR) {
+      SetCoefficients(recon.c1j, recon.c2j, recon.c3j, recon.c4j, recon.c5j, recon.c6j,
+                      recon.hplus_ratio_j, recon.hminus_ratio_j);
+    } else {
+      SetCoefficients(recon.c1k, recon.c2k, recon.c3k, recon.c4k, recon.c5k, recon.c6k,
+                      recon.hplus_ratio_k, recon.hminus_ratio_k);
+    }
+    stride_ = (DIR == X1DIR ? 1 : (DIR == X2DIR ? nx1_ : nx1_*nx2_));
+  }
+
+  void operator()(const int n, const int k, const int j) const {
+    // CS08 constant used in second derivative limiter, >1 , independent of h
+    const Real C2 = 1.25;
+    const int base = nx1_*(j + nx2_*(k + nx3_*n));
+    const int s = stride_, il = il_, iu = iu_;
+    // local copies, so that stores through ql/qr cannot alias the loop bounds
+    const Real *q = q_;
+    Real *ql = ql_, *qr = qr_;
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      const int c = base + i;
+      const int x = (DIR == X1DIR ? i : (DIR == X2DIR ? j : k));
+      const Real q_im2 = q[c-2*s], q_im1 = q[c-s], q_i = q[c];
+      const Real q_ip1 = q[c+s], q_ip2 = q[c+2*s];
+
+      //--- Step 1. Reconstruct interface averages <a>_{i-1/2} and <a>_{i+1/2}
+      Real qa = (q_i - q_im1);
+      Real qb = (q_ip1 - q_i);
+      const Real dd_im1 = c1(x-1)*qa + c2(x-1)*(q_im1 - q_im2);
+      const Real dd     = c1(x  )*qb + c2(x  )*qa;
+      const Real dd_ip1 = c1(x+1)*(q_ip2 - q_ip1) + c2(x+1)*qb;
+      Real dph = (c3(x)*q_im1 + c4(x)*q_i) + (c5(x)*dd_im1 + c6(x)*dd);
+      Real dph_ip1 = (c3(x+1)*q_i + c4(x+1)*q_ip1) + (c5(x+1)*dd + c6(x+1)*dd_ip1);
+
+      Real d2qc_im1 = 0.0, d2qc = 0.0, d2qc_ip1 = 0.0, d2qf = 0.0;
+      if (kUniform) {
+        //--- Step 2a. Limit interpolated interface states (CD 4.3.1)
+        d2qc_im1 = q_im2 + q_i   - 2.0*q_im1;
+        d2qc     = q_im1 + q_ip1 - 2.0*q_i; // (CD eq 85a) (no 1/2)
+        d2qc_ip1 = q_i   + q_ip2 - 2.0*q_ip1;
+        dph = LimitInterface(q_im1, q_i, dph, d2qc_im1, d2qc, C2);
+        dph_ip1 = LimitInterface(q_i, q_ip1, dph_ip1, d2qc, d2qc_ip1, C2);
+        d2qf = 6.0*(dph + dph_ip1 - 2.0*q_i); // a6 coefficient * -2
+      } else {
+        //--- Step 2b. Apply strict monotonicity constraints (Mignone eq 45)
+        dph     = std::min(dph    , std::max(q_i, q_im1));
+        dph_ip1 = std::min(dph_ip1, std::max(q_i, q_ip1));
+        dph     = std::max(dph    , std::min(q_i, q_im1));
+        dph_ip1 = std::max(dph_ip1, std::min(q_i, q_ip1));
+      }
+      Real qminus = dph;
+      Real qplus = dph_ip1;
+
+      //--- Step 3. Compute cell-centered difference stencils (MC section 2.4.1)
+      const Real dqf_minus = q_i - qminus; // (CS eq 25) = -dQ^- in Mignone's notation
+      const Real dqf_plus  = qplus - q_i;
+
+      if (kUniform) {
+        //--- Step 4a. Apply CS limiters to parabolic interpolant
+        const Real qa_tmp = dqf_minus*dqf_plus;
+        const Real qb_tmp = (q_ip1 - q_i)*(q_i - q_im1);
+        qa = d2qc_im1;
+        qb = d2qc;
+        const Real qc = d2qc_ip1;
+        const Real qd = d2qf;
+        Real qe = 0.0;
+        if (SIGN(qa) == SIGN(qb) && SIGN(qa) == SIGN(qc) && SIGN(qa) == SIGN(qd)) {
+          // Extrema is smooth
+          qe = SIGN(qd)* std::min(std::min(C2*std::abs(qa), C2*std::abs(qb)),
+                                  std::min(C2*std::abs(qc), std::abs(qd))); // (CS eq 22)
+        }
+        // Check if 2nd derivative is close to roundoff error
+        qa = std::max(std::abs(q_im1), std::abs(q_im2));
+        qb = std::max(std::max(std::abs(q_i), std::abs(q_ip1)), std::abs(q_ip2));
+        Real rho = 0.0;
+        if (std::abs(qd) > (1.0e-12)*std::max(qa, qb)) {
+          // Limiter is not sensitive to roundoff. Use limited ratio (MC eq 27)
+          rho = qe/qd;
+        }
+        // Check for local extrema
+        if ((qa_tmp <= 0.0 || qb_tmp <= 0.0)) {
+          // Check if relative change in limited 2nd deriv is > roundoff
+          if (rho <= (1.0 - (1.0e-12))) {
+            // Limit smooth extrema
+            qminus = q_i - rho*dqf_minus; // (CS eq 23)
+            qplus = q_i + rho*dqf_plus;
+          }
+        } else {
+          // Overshoot i-1/2,R / i,(-) state
+          if (std::abs(dqf_minus) >= 2.0*std::abs(dqf_plus)) qminus = q_i - 2.0*dqf_plus;
+          // Overshoot i+1/2,L / i,(+) state
+          if (std::abs(dqf_plus) >= 2.0*std::abs(dqf_minus)) qplus = q_i + 2.0*dqf_minus;
+        }
+      } else {
+        //--- Step 4b. Apply Mignone limiters to parabolic interpolant
+        if (dqf_minus*dqf_plus <= 0.0) { // Local extrema detected
+          qminus = q_i;
+          qplus = q_i;
+        } else { // No extrema detected
+          if (std::abs(dqf_minus) >= hplus_[x]*std::abs(dqf_plus)) {
+            qminus = q_i - hplus_[x]*dqf_plus;
+          }
+          if (std::abs(dqf_plus) >= hminus_[x]*std::abs(dqf_minus)) {
+            qplus = q_i + hminus_[x]*dqf_minus;
+          }
+        }
+      }
+
+      //--- Step 5. Convert limited cell-centered values to interface L/R Riemann states
+      ql[c+s] = qplus;
+      qr[c  ] = qminus;
+    }
+  }
+
+ private:
+  void SetCoefficients(const AthenaArray<Real> &c1, const AthenaArray<Real> &c2,
+                       const AthenaArray<Real> &c3, const AthenaArray<Real> &c4,
+                       const AthenaArray<Real> &c5, const AthenaArray<Real> &c6,
+                       const AthenaArray<Real> &hplus, const AthenaArray<Real> &hminus) {
+    c1_ = c1.data(); c2_ = c2.data(); c3_ = c3.data();
+    c4_ = c4.data(); c5_ = c5.data(); c6_ = c6.data();
+    hplus_ = hplus.data(); hminus_ = hminus.data();
+  }
+
+  // weights of CW eq 1.6-1.7; constant on uniform meshes
+  Real c1(const int x) const {return kUniform ? 0.5 : c1_[x];}
+  Real c2(const int x) const {return kUniform ? 0.5 : c2_[x];}
+  Real c3(const int x) const {return kUniform ? 0.5 : c3_[x];}
+  Real c4(const int x) const {return kUniform ? 0.5 : c4_[x];}
+  Real c5(const int x) const {return kUniform ? 1.0/6.0 : c5_[x];}
+  Real c6(const int x) const {return kUniform ? -1.0/6.0 : c6_[x];}
+
+  // limit the interface value dph between cells with averages ql, qr (CD eq 84-85)
+  static Real LimitInterface(const Real ql, const Real qr, const Real dph,
+                             const Real d2qc_l, const Real d2qc_r, const Real C2) {
+    const Real qa_tmp = dph - ql; // (CD eq 84a)
+    const Real qb_tmp = qr - dph; // (CD eq 84b)
+    // KGF: add the off-centered quantities first to preserve FP symmetry
+    const Real qa = 3.0*(ql + qr - 2.0*dph); // (CD eq 85b)
+    Real qd = 0.0;
+    if (SIGN(qa) == SIGN(d2qc_l) && SIGN(qa) == SIGN(d2qc_r)) {
+      qd = SIGN(qa)* std::min(C2*std::abs(d2qc_l),
+                              std::min(C2*std::abs(d2qc_r), std::abs(qa)));
+    }
+    if (qa_tmp*qb_tmp < 0.0) return 0.5*(ql + qr) - qd/6.0; // local extremum
+    return dph;
+  }
+
+  const Real *q_;
+  Real *ql_, *qr_;
+  const Real *c1_, *c2_, *c3_, *c4_, *c5_, *c6_, *hplus_, *hminus_;
+  int il_, iu_, nx1_, nx2_, nx3_, stride_;
+};
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::PiecewiseParabolicBlock()
+//  \brief PPM of all variables over a block in a single parallel loop over pencils
+
+void Reconstruction::PiecewiseParabolicBlock(
+    const int dir, const int kl, const int ku, const int jl, const int ju,
+    const int il, const int iu, const AthenaArray<Real> &q,
+    AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
+  const int nu = q.GetDim4() - 1;
+  auto launch = [&](const auto &kernel) {
+    par_for_pencils("Reconstruction::PiecewiseParabolicBlock",
+                    Kokkos::DefaultHostExecutionSpace(), 0, nu, kl, ku, jl, ju, kernel);
+  };
+  if (dir == X1DIR) {
+    if (uniform[X1DIR]) launch(PPMPencil<X1DIR, true>(*this, q, ql, qr, il, iu));
+    else                launch(PPMPencil<X1DIR, false>(*this, q, ql, qr, il, iu));
+  } else if (dir == X2DIR) {
+    if (uniform[X2DIR]) launch(PPMPencil<X2DIR, true>(*this, q, ql, qr, il, iu));
+    else                launch(PPMPencil<X2DIR, false>(*this, q, ql, qr, il, iu));
+  } else {
+    if (uniform[X3DIR]) launch(PPMPencil<X3DIR, true>(*this, q, ql, qr, il, iu));
+    else                launch(PPMPencil<X3DIR, false>(*this, q, ql, qr, il, iu));
+  }
+  return;
+}
 }
@@ -142,6 +142,35 @@ class Reconstruction {
                             const AthenaArray<Real> &q,
                             AthenaArray<Real> &ql, AthenaArray<Real> &qr);
 
+  // fifth-order WENO-Z reconstruction; assumes uniform cell spacing
+  void WenoZX1(const int k, const int j, const int il, const int iu,
+               const AthenaArray<Real> &q,
+               AthenaArray<Real> &ql, AthenaArray<Real> &qr);
+
+  void WenoZX2(const int k, const int j, const int il, const int iu,
+               const AthenaArray<Real> &q,
+               AthenaArray<Real> &ql, AthenaArray<Real> &qr);
+
+  void WenoZX3(const int k, const int j, const int il, const int iu,
+               const AthenaArray<Real> &q,
+               AthenaArray<Real> &ql, AthenaArray<Real> &qr);
+
+  // WENO5-Z value at the face between q0 and qp1 from the five-cell stencil around q0
+  static Real WenoZ5(const Real qm2, const Real qm1, const Real q0,
+                     const Real qp1, const Real qp2);
+
+  // block-wide reconstruction of every variable of q in direction dir for the cells in
+  // [kl,ku][jl,ju][il,iu].  ql/qr have the shape of q; face x-1/2 is stored at index x.
+  void PiecewiseLinearBlock(const int dir, const int kl, const int ku,
+                            const int jl, const int ju, const int il, const int iu,
+                            const AthenaArray<Real> &q,
+                            AthenaArray<Real> &ql, AthenaArray<Real> &qr);
+
+  void PiecewiseParabolicBlock(const int dir, const int kl, const int ku,
+                               const int jl, const int ju, const int il, const int iu,
+                               const AthenaArray<Real> &q,
+                               AthenaArray<Real> &ql, AthenaArray<Real> &qr);
+
  private:
   MeshBlock* pmy_block_;  // ptr to MeshBlock containing this Reconstruction
 
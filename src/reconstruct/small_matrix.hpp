@@ -0,0 +1,230 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef RECONSTRUCT_SMALL_MATRIX_HPP_
+#define RECONSTRUCT_SMALL_MATRIX_HPP_
+//! \file small_matrix.hpp
+//  \brief batched dense linear algebra on many small NxN systems stored in SoA layout
+//
+//  A batch of matrices is an AthenaArray<Real> of shape (N,N,ncells) and a batch of
+//  vectors one of shape (N,ncells), i.e. the same layout as the (n,i) pencil arrays used
+//  by the reconstruction functions.  The matrix size N is a template parameter and every
+//  elementary step (a pivot comparison, a row update, one substitution term) is its own
+//  simple loop over the cells, so the loops vectorize whether or not the compiler
+//  unrolls the small row/column loops around them.  Per-cell temporaries live in
+//  stack tiles of kSmallMatrixTile cells, and pivoting is done with per-cell selects
+//  rather than row-pointer swaps.
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+// parthenon infrastructure includes
+#include "athena.hpp"
+#include "athena_arrays.hpp"
+
+namespace parthenon {
+// default criterion for detecting a (nearly) singular pivot in BatchedLUPDecompose
+constexpr Real kSmallMatrixLUTol = 3e-16;
+// number of cells processed at a time, sized so per-cell temporaries stay in L1
+constexpr int kSmallMatrixTile = 64;
+
+//----------------------------------------------------------------------------------------
+//! \fn int BatchedLUPDecompose<N>()
+//  \brief in-place LU decomposition with partial (row) pivoting of the NxN matrices a
+//  for cells [il,iu], using Doolittle's algorithm: PA=LU with unit lower triangular L.
+//  On output a holds L+U (the unit diagonal of L is not stored) and pivot(r,i) the
+//  original row stored in row r.  Returns the number of pivots smaller than tol; the
+//  decomposition of the affected cells is not usable when this is nonzero.
+//
+// REFERENCES:
+//   - Numerical Recipes, 3rd ed. (NR) section 2.3 "LU Decomposition & its Applications"
+
+template <int N>
+int BatchedLUPDecompose(const int il, const int iu, AthenaArray<Real> &a,
+                        AthenaArray<int> &pivot, const Real tol = kSmallMatrixLUTol) {
+  // raw pointers, so that stores cannot alias the array dimensions
+  Real *pa = a.data();
+  int *pp = pivot.data();
+  const int s = a.GetDim1();
+  const int sp = pivot.GetDim1();
+  int nsingular = 0;
+
+  for (int r=0; r<N; ++r) {
+#pragma omp simd
+    for (int i=il; i<=iu; ++i)
+      pp[r*sp + i] = r;
+  }
+
+  Real a_max[kSmallMatrixTile];
+  int r_max[kSmallMatrixTile];
+  for (int tl=il; tl<=iu; tl+=kSmallMatrixTile) {
+    const int tu = std::min(tl + kSmallMatrixTile - 1, iu);
+    for (int p=0; p<N; ++p) {
+      Real *ap = pa + p*N*s;
+      // search for largest pivot element in column p
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i) {
+        a_max[i-tl] = std::abs(ap[p*s + i]);
+        r_max[i-tl] = p;
+      }
+      for (int r=p+1; r<N; ++r) {
+        const Real *ar = pa + r*N*s;
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i) {
+          // operands are loaded unconditionally so the selects need no branches
+          const Real a_abs = std::abs(ar[p*s + i]), a_old = a_max[i-tl];
+          const int r_old = r_max[i-tl];
+          const bool larger = (a_abs > a_old);
+          r_max[i-tl] = larger ? r : r_old;
+          a_max[i-tl] = larger ? a_abs : a_old;
+        }
+      }
+#pragma omp simd reduction(+:nsingular)
+      for (int i=tl; i<=tu; ++i)
+        nsingular += (a_max[i-tl] < tol);
+
+      // swap rows p and r_max, selecting against every candidate row
+      for (int r=p+1; r<N; ++r) {
+        Real *ar = pa + r*N*s;
+        for (int c=0; c<N; ++c) {
+#pragma omp simd
+          for (int i=tl; i<=tu; ++i) {
+            const bool swap = (r_max[i-tl] == r);
+            const Real a_p = ap[c*s + i], a_r = ar[c*s + i];
+            ap[c*s + i] = swap ? a_r : a_p;
+            ar[c*s + i] = swap ? a_p : a_r;
+          }
+        }
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i) {
+          const bool swap = (r_max[i-tl] == r);
+          const int i_p = pp[p*sp + i], i_r = pp[r*sp + i];
+          pp[p*sp + i] = swap ? i_r : i_p;
+          pp[r*sp + i] = swap ? i_p : i_r;
+        }
+      }
+
+      // fill column p of L and update the remaining submatrix
+      for (int r=p+1; r<N; ++r) {
+        Real *ar = pa + r*N*s;
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i)
+          ar[p*s + i] /= ap[p*s + i];
+        for (int c=p+1; c<N; ++c) {
+#pragma omp simd
+          for (int i=tl; i<=tu; ++i)
+            ar[c*s + i] -= ar[p*s + i]*ap[c*s + i];
+        }
+      }
+    }
+  }
+  return nsingular;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BatchedLUPSolve<N>()
+//  \brief solves Ax=b for cells [il,iu] given the output lu, pivot of a successful
+//  BatchedLUPDecompose<N>() of A.  x may be the same array as b.
+
+template <int N>
+void BatchedLUPSolve(const int il, const int iu, const AthenaArray<Real> &lu,
+                     const AthenaArray<int> &pivot, const AthenaArray<Real> &b,
+                     AthenaArray<Real> &x) {
+  const Real *pa = lu.data();
+  const int *pp = pivot.data();
+  const Real *pb = b.data();
+  Real *px = x.data();
+  const int s = lu.GetDim1(), sp = pivot.GetDim1(), sb = b.GetDim1(), sx = x.GetDim1();
+
+  Real y[N][kSmallMatrixTile];
+  for (int tl=il; tl<=iu; tl+=kSmallMatrixTile) {
+    const int tu = std::min(tl + kSmallMatrixTile - 1, iu);
+    // forward substitution, Ly=Pb; the permuted RHS is gathered with selects
+    for (int r=0; r<N; ++r) {
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i)
+        y[r][i-tl] = pb[i];
+      for (int q=1; q<N; ++q) {
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i) {
+          const Real b_q = pb[q*sb + i], y_old = y[r][i-tl];
+          y[r][i-tl] = (pp[r*sp + i] == q) ? b_q : y_old;
+        }
+      }
+      for (int c=0; c<r; ++c) {
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i)
+          y[r][i-tl] -= pa[(r*N + c)*s + i]*y[c][i-tl];
+      }
+    }
+    // back substitution, Ux=y (U is not unit upper triangular)
+    for (int r=N-1; r>=0; --r) {
+      for (int c=r+1; c<N; ++c) {
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i)
+          y[r][i-tl] -= y[c][i-tl]*pa[(r*N + c)*s + i];
+      }
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i)
+        y[r][i-tl] /= pa[(r*N + r)*s + i];
+    }
+    for (int r=0; r<N; ++r) {
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i)
+        px[r*sx + i] = y[r][i-tl];
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BatchedMatVec<N>()
+//  \brief y = M x for the NxN matrices m and vectors x over cells [il,iu], e.g. the
+//  projection of primitive onto characteristic variables with a batch of eigenmatrices.
+//  y may be the same array as x.
+
+template <int N>
+void BatchedMatVec(const int il, const int iu, const AthenaArray<Real> &m,
+                   const AthenaArray<Real> &x, AthenaArray<Real> &y) {
+  const Real *pm = m.data();
+  const Real *px = x.data();
+  Real *py = y.data();
+  const int s = m.GetDim1(), sx = x.GetDim1(), sy = y.GetDim1();
+
+  Real mx[N][kSmallMatrixTile];
+  for (int tl=il; tl<=iu; tl+=kSmallMatrixTile) {
+    const int tu = std::min(tl + kSmallMatrixTile - 1, iu);
+    for (int r=0; r<N; ++r) {
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i)
+        mx[r][i-tl] = pm[(r*N)*s + i]*px[i];
+      for (int c=1; c<N; ++c) {
+#pragma omp simd
+        for (int i=tl; i<=tu; ++i)
+          mx[r][i-tl] += pm[(r*N + c)*s + i]*px[c*sx + i];
+      }
+    }
+    for (int r=0; r<N; ++r) {
+#pragma omp simd
+      for (int i=tl; i<=tu; ++i)
+        py[r*sy + i] = mx[r][i-tl];
+    }
+  }
+  return;
+}
+}
+#endif // RECONSTRUCT_SMALL_MATRIX_HPP_
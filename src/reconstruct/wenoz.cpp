@@ -0,0 +1,127 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file wenoz.cpp
+//  \brief fifth-order WENO-Z reconstruction for uniform Cartesian-like coordinates
+//  Operates on the entire nx4 range of a single AthenaArray<Real> input (no MHD).
+
+// REFERENCES:
+// (JS) G.-S. Jiang & C.-W. Shu, "Efficient Implementation of Weighted ENO Schemes",
+// JCP, 126, 202 (1996)
+//
+// (BCCD) R. Borges, M. Carmona, B. Costa, W.S. Don, "An improved weighted essentially
+// non-oscillatory scheme for hyperbolic conservation laws", JCP, 227, 3191 (2008)
+//========================================================================================
+
+// C++ headers
+#include <cmath>
+
+#include "reconstruction.hpp"
+
+namespace parthenon {
+namespace {
+// kept inline in this file so that the pencil loops below vectorize over i
+inline Real WenoZFace(const Real qm2, const Real qm1, const Real q0, const Real qp1,
+                      const Real qp2) {
+  // guards the nonlinear weights against division by zero (BCCD section 4)
+  constexpr Real eps = 1.0e-40;
+
+  // smoothness indicators of the three candidate stencils (JS eq 3.2-3.4)
+  const Real beta0 = 13.0/12.0*SQR(qm2 - 2.0*qm1 + q0) + 0.25*SQR(qm2 - 4.0*qm1 + 3.0*q0);
+  const Real beta1 = 13.0/12.0*SQR(qm1 - 2.0*q0 + qp1) + 0.25*SQR(qm1 - qp1);
+  const Real beta2 = 13.0/12.0*SQR(q0 - 2.0*qp1 + qp2) + 0.25*SQR(3.0*q0 - 4.0*qp1 + qp2);
+
+  // WENO-Z weights with the global fifth-order indicator tau5 (BCCD eq 25-28)
+  const Real tau5 = std::abs(beta0 - beta2);
+  const Real alpha0 = 0.1*(1.0 + tau5/(beta0 + eps));
+  const Real alpha1 = 0.6*(1.0 + tau5/(beta1 + eps));
+  const Real alpha2 = 0.3*(1.0 + tau5/(beta2 + eps));
+
+  // third-order interface values of the candidate stencils (JS eq 2.11)
+  const Real f0 = (2.0*qm2 - 7.0*qm1 + 11.0*q0)/6.0;
+  const Real f1 = (-qm1 + 5.0*q0 + 2.0*qp1)/6.0;
+  const Real f2 = (2.0*q0 + 5.0*qp1 - qp2)/6.0;
+
+  return (alpha0*f0 + alpha1*f1 + alpha2*f2)/(alpha0 + alpha1 + alpha2);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::WenoZ5()
+//  \brief WENO5-Z value at the interface between q0 and qp1, biased toward q0.  The
+//  interface on the other side of q0 is obtained by passing the stencil reversed.
+
+Real Reconstruction::WenoZ5(const Real qm2, const Real qm1, const Real q0,
+                            const Real qp1, const Real qp2) {
+  return WenoZFace(qm2, qm1, q0, qp1, qp2);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::WenoZX1()
+//  \brief Returns L/R interface values in X1-dir constructed using WENO5-Z over [il,iu]
+
+void Reconstruction::WenoZX1(const int k, const int j, const int il, const int iu,
+                             const AthenaArray<Real> &q,
+                             AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
+  const int nu = q.GetDim4() - 1;
+  for (int n=0; n<=nu; ++n) {
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      ql(n,i+1) = WenoZFace(q(n,k,j,i-2), q(n,k,j,i-1), q(n,k,j,i), q(n,k,j,i+1),
+                            q(n,k,j,i+2));
+      qr(n,i  ) = WenoZFace(q(n,k,j,i+2), q(n,k,j,i+1), q(n,k,j,i), q(n,k,j,i-1),
+                            q(n,k,j,i-2));
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::WenoZX2()
+//  \brief Returns L/R interface values in X2-dir constructed using WENO5-Z over [il,iu]
+
+void Reconstruction::WenoZX2(const int k, const int j, const int il, const int iu,
+                             const AthenaArray<Real> &q,
+                             AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
+  const int nu = q.GetDim4() - 1;
+  for (int n=0; n<=nu; ++n) {
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      ql(n,i) = WenoZFace(q(n,k,j-2,i), q(n,k,j-1,i), q(n,k,j,i), q(n,k,j+1,i),
+                          q(n,k,j+2,i));
+      qr(n,i) = WenoZFace(q(n,k,j+2,i), q(n,k,j+1,i), q(n,k,j,i), q(n,k,j-1,i),
+                          q(n,k,j-2,i));
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::WenoZX3()
+//  \brief Returns L/R interface values in X3-dir constructed using WENO5-Z over [il,iu]
+
+void Reconstruction::WenoZX3(const int k, const int j, const int il, const int iu,
+                             const AthenaArray<Real> &q,
+                             AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
+  const int nu = q.GetDim4() - 1;
+  for (int n=0; n<=nu; ++n) {
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      ql(n,i) = WenoZFace(q(n,k-2,j,i), q(n,k-1,j,i), q(n,k,j,i), q(n,k+1,j,i),
+                          q(n,k+2,j,i));
+      qr(n,i) = WenoZFace(q(n,k+2,j,i), q(n,k+1,j,i), q(n,k,j,i), q(n,k-1,j,i),
+                          q(n,k-2,j,i));
+    }
+  }
+  return;
+}
+}
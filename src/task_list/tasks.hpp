@@ -15,6 +15,7 @@
 #define TASK_LIST_TASKS_HPP_
 
 #include <bitset>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -24,6 +25,9 @@
 #include <utility>
 #include <vector>
 
+#include "utils/timers.hpp"
+#include "utils/trace.hpp"
+
 namespace parthenon {
 
 class MeshBlock;
@@ -69,11 +73,24 @@ class BaseTask {
   virtual TaskStatus operator () () = 0;
   TaskID GetID() { return _myid; }
   TaskID GetDependency() { return _dep; }
+  // unnamed tasks are labelled task_<n> on first use, so that runs without timers or
+  // traces never build the label
+  const std::string &GetName() {
+    if (_name.empty()) _name = "task_" + std::to_string(_index);
+    return _name;
+  }
+  void SetName(const std::string &name) { _name = name; }
+  int GetIndex() const { return _index; }
+  void SetIndex(int index) { _index = index; }
+  // stage of the integrator the task belongs to, or -1 if it is not a stage task
+  virtual int GetStage() const { return -1; }
   void SetComplete() { _complete = true; }
   bool IsComplete() { return _complete; }
  protected:
   TaskID _myid, _dep;
   bool lb_time, _complete=false;
+  std::string _name;  // used to label the task in timer reports and traces
+  int _index = 0;     // order in which the task was added to its list
 };
 
 class SimpleTask : public BaseTask {
@@ -101,6 +118,7 @@ class BlockStageTask : public BaseTask {
                  TaskID dep, MeshBlock *pmb, int stage)
     : _func(func), _pblock(pmb), _stage(stage), BaseTask(id,dep) { }
   TaskStatus operator () () { return _func(_pblock, _stage); }
+  int GetStage() const { return _stage; }
  private:
   BlockStageTaskFunc _func;
   MeshBlock *_pblock;
@@ -115,6 +133,7 @@ class BlockStageNamesTask : public BaseTask {
     : _func(func), _pblock(pmb), _stage(stage),
       _sname(sname), BaseTask(id,dep) { }
   TaskStatus operator () () { return _func(_pblock, _stage, _sname); }
+  int GetStage() const { return _stage; }
  private:
   BlockStageNamesTaskFunc _func;
   MeshBlock *_pblock;
@@ -132,6 +151,7 @@ class BlockStageNamesIntegratorTask : public BaseTask {
     : _func(func), _pblock(pmb), _stage(stage), _sname(sname),
       _int(integ), BaseTask(id,dep) { }
   TaskStatus operator () () { return _func(_pblock, _stage, _sname, _int); }
+  int GetStage() const { return _stage; }
  private:
   BlockStageNamesIntegratorTaskFunc _func;
   MeshBlock *_pblock;
@@ -159,6 +179,8 @@ class TaskList {
     return true;
   }
   void MarkTaskComplete(TaskID id) { _tasks_completed.SetFinished(id); }
+  // gid of the MeshBlock the list works on, recorded in task traces
+  void SetBlockID(int gid) { _block_gid = gid; }
   int ClearComplete() {
     auto task = _task_list.begin();
     int completed = 0;
@@ -176,7 +198,13 @@ class TaskList {
     for (auto & task : _task_list) {
       auto dep = task->GetDependency();
       if(_tasks_completed.CheckDependencies(dep)) {
+        Timers::ScopedRegion region(Timers::enabled ? task->GetName().c_str() : "");
+        const std::int64_t begin = Trace::enabled ? Trace::Now() : 0;
         TaskStatus status = (*task)();
+        if (Trace::enabled) {
+          Trace::Record(task->GetName(), begin, _block_gid, task->GetIndex(),
+                        task->GetStage(), status == TaskStatus::success);
+        }
         if (status == TaskStatus::success) {
           task->SetComplete();
           MarkTaskComplete(task->GetID());
@@ -193,9 +221,17 @@ class TaskList {
     _task_list.push_back(
       std::make_unique<T>(id , std::forward<Args>(args)...)
     );
+    _task_list.back()->SetIndex(_tasks_added+1);
     _tasks_added++;
     return id;
   }
+  // as AddTask, but labels the task "name" in timer reports
+  template<typename T, class...Args>
+  TaskID AddNamedTask(const std::string &name, Args... args) {
+    TaskID id = AddTask<T>(std::forward<Args>(args)...);
+    _task_list.back()->SetName(name);
+    return id;
+  }
   void Print() {
     int i = 0;
     std::cout << "TaskList::Print():" << std::endl;
@@ -209,6 +245,7 @@ class TaskList {
  protected:
   std::list<std::unique_ptr<BaseTask>> _task_list;
   int _tasks_added=0;
+  int _block_gid=-1;
   std::vector<TaskList*> _dependencies;
   TaskID _tasks_completed;
 };
@@ -0,0 +1,152 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file comm_stats.cpp
+//  \brief implementation of the communication counters and their report
+
+// C++ headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "comm_stats.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace parthenon {
+namespace CommStats {
+bool enabled = false;
+
+namespace {
+constexpr int kNumChannels = 3, kNumRelations = 3, kNumLocalities = 2;
+enum Field {kMessages, kBytes, kWaits, kWaitNs, kNumFields};
+constexpr int kNumCounters = kNumChannels*kNumRelations*kNumLocalities*kNumFields;
+
+const char *kChannelNames[kNumChannels] = {"boundary", "flux_correction",
+                                           "redistribution"};
+const char *kRelationNames[kNumRelations] = {"same_level", "coarse_to_fine",
+                                             "fine_to_coarse"};
+const char *kLocalityNames[kNumLocalities] = {"same_rank", "off_rank"};
+
+std::atomic<std::int64_t> counters[kNumCounters];
+// counters at the previous interval report
+std::int64_t last[kNumCounters];
+int report_interval = 0;
+
+int Index(const Channel c, const Relation r, const bool same_rank, const Field f) {
+  return ((static_cast<int>(c)*kNumRelations + static_cast<int>(r))*kNumLocalities
+          + (same_rank ? 0 : 1))*kNumFields + f;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void CommStats::Initialize(ParameterInput *pin)
+//  \brief read the <profiling> block and zero the counters
+
+void Initialize(ParameterInput *pin) {
+  enabled = pin->GetOrAddBoolean("profiling", "comm_stats", false);
+  report_interval = pin->GetOrAddInteger("profiling", "report_interval", 0);
+  for (int i=0; i<kNumCounters; ++i) {
+    counters[i] = 0;
+    last[i] = 0;
+  }
+}
+
+std::int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Send(const Channel c, const Relation r, const bool same_rank,
+          const std::size_t bytes) {
+  counters[Index(c, r, same_rank, kMessages)].fetch_add(1, std::memory_order_relaxed);
+  counters[Index(c, r, same_rank, kBytes)].fetch_add(static_cast<std::int64_t>(bytes),
+                                                     std::memory_order_relaxed);
+}
+
+void Wait(const Channel c, const Relation r, const bool same_rank,
+          const std::int64_t ns) {
+  counters[Index(c, r, same_rank, kWaits)].fetch_add(1, std::memory_order_relaxed);
+  counters[Index(c, r, same_rank, kWaitNs)].fetch_add(ns, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CommStats::Report(std::ostream &os, const bool total)
+//  \brief collective; one line per channel, level relation and locality with traffic
+
+void Report(std::ostream &os, const bool total) {
+  if (!enabled) return;
+  std::vector<double> local(kNumCounters), sum(kNumCounters), rank_max(kNumCounters);
+  for (int i=0; i<kNumCounters; ++i) {
+    const std::int64_t now = counters[i].load();
+    local[i] = static_cast<double>(total ? now : now - last[i]);
+    if (!total) last[i] = now;
+  }
+#ifdef MPI_PARALLEL
+  MPI_Reduce(local.data(), sum.data(), kNumCounters, MPI_DOUBLE, MPI_SUM, 0,
+             MPI_COMM_WORLD);
+  MPI_Reduce(local.data(), rank_max.data(), kNumCounters, MPI_DOUBLE, MPI_MAX, 0,
+             MPI_COMM_WORLD);
+#else
+  sum = local;
+  rank_max = local;
+#endif
+  if (Globals::my_rank != 0) return;
+
+  std::ios_base::fmtflags flags = os.flags();
+  os << std::endl << "Communication report ("
+     << (total ? "whole run" : "since the previous report") << ") over "
+     << Globals::nranks << " rank(s)" << std::endl
+     << std::left << std::setw(48) << "channel/relation/locality" << std::right
+     << std::setw(10) << "messages" << std::setw(12) << "MiB" << std::setw(10)
+     << "KiB/msg" << std::setw(10) << "waits" << std::setw(12) << "wait s"
+     << std::setw(12) << "max rank s" << std::endl;
+  for (int c=0; c<kNumChannels; ++c) {
+    for (int r=0; r<kNumRelations; ++r) {
+      for (int l=0; l<kNumLocalities; ++l) {
+        const int i = Index(static_cast<Channel>(c), static_cast<Relation>(r), l == 0,
+                            kMessages);
+        const double msgs = sum[i + kMessages], bytes = sum[i + kBytes];
+        if (msgs == 0.0 && sum[i + kWaits] == 0.0) continue;
+        const std::string name = std::string(kChannelNames[c]) + "/"
+                                 + kRelationNames[r] + "/" + kLocalityNames[l];
+        os << std::left << std::setw(48) << name << std::right << std::fixed
+           << std::setprecision(0) << std::setw(10) << msgs << std::setprecision(3)
+           << std::setw(12) << bytes/1048576.0 << std::setw(10)
+           << (msgs > 0.0 ? bytes/msgs/1024.0 : 0.0) << std::setprecision(0)
+           << std::setw(10) << sum[i + kWaits] << std::setprecision(4)
+           << std::setw(12) << 1.0e-9*sum[i + kWaitNs] << std::setw(12)
+           << 1.0e-9*rank_max[i + kWaitNs] << std::endl;
+      }
+    }
+  }
+  os.flags(flags);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CommStats::ReportIfDue(const int ncycle)
+//  \brief collective; writes the counters of the last <profiling>/report_interval cycles
+
+void ReportIfDue(const int ncycle) {
+  if (enabled && report_interval > 0 && ncycle % report_interval == 0)
+    Report(std::cout, false);
+}
+} // namespace CommStats
+} // namespace parthenon
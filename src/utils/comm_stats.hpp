@@ -0,0 +1,64 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef UTILS_COMM_STATS_HPP_
+#define UTILS_COMM_STATS_HPP_
+//! \file comm_stats.hpp
+//  \brief counters of the messages, bytes and receive waits of block communication
+//
+//  Ghost-zone exchange, flux correction and the redistribution of blocks by load
+//  balancing and AMR are counted separately, each split by whether the neighbor lives on
+//  the same rank and by the refinement level of the receiver relative to the sender.
+//  Same-rank redistribution counts the data copied in memory.
+//  Counters are atomics, so recording is safe from the threads running block task lists.
+
+// C++ headers
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace parthenon {
+class ParameterInput;
+
+namespace CommStats {
+enum class Channel {boundary, flux_correction, redistribution};
+// of the receiver relative to the sender
+enum class Relation {same_level, coarse_to_fine, fine_to_coarse};
+
+// true when <profiling>/comm_stats is enabled; checked before any other work
+extern bool enabled;
+
+void Initialize(ParameterInput *pin);
+
+inline Relation RelationOf(const int send_level, const int recv_level) {
+  if (send_level == recv_level) return Relation::same_level;
+  return (send_level < recv_level) ? Relation::coarse_to_fine : Relation::fine_to_coarse;
+}
+
+// nanoseconds on a steady clock, for measuring waits
+std::int64_t Now();
+
+// one message of "bytes" sent
+void Send(const Channel c, const Relation r, const bool same_rank,
+          const std::size_t bytes);
+// a receive that was waited for "ns" nanoseconds before its data arrived
+void Wait(const Channel c, const Relation r, const bool same_rank, const std::int64_t ns);
+
+// collective: prints the counters summed over ranks and the largest per-rank wait, for
+// the cycles since the previous interval report or, with "total", for the whole run
+void Report(std::ostream &os, const bool total);
+// collective: Report() every <profiling>/report_interval cycles (0 = never)
+void ReportIfDue(const int ncycle);
+} // namespace CommStats
+} // namespace parthenon
+
+#endif // UTILS_COMM_STATS_HPP_
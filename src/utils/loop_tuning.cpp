@@ -0,0 +1,205 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file loop_tuning.cpp
+//  \brief implementation of the par_for loop pattern tuning and its cache file
+
+// C++ headers
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Kokkos headers
+#include <Kokkos_Core.hpp>
+
+// Athena++ headers
+#include "athena.hpp"
+#include "globals.hpp"
+#include "loop_tuning.hpp"
+#include "parameter_input.hpp"
+
+namespace parthenon {
+namespace LoopTuning {
+bool enabled = false;
+int generation = 0;
+
+namespace {
+using Extents = std::array<int, 4>;
+using KernelList = std::vector<std::pair<Extents, std::unique_ptr<Kernel>>>;
+
+const char *kNames[] = {"flatrange", "simdfor", "mdrange", "tpttr", "tptvr",
+                        "tpttrtvr", "undecided"};
+
+std::mutex table_mutex;
+std::unordered_map<std::string, KernelList> table;
+int trials = 2;
+std::string cache_file;
+
+// the patterns that can run kernels on the default execution space
+const std::vector<Pattern> &Candidates() {
+#ifdef KOKKOS_ENABLE_CUDA
+  static const std::vector<Pattern> candidates = {
+      Pattern::flatrange, Pattern::mdrange, Pattern::tpttr, Pattern::tpttrtvr};
+#else
+  static const std::vector<Pattern> candidates = {
+      Pattern::flatrange, Pattern::simdfor, Pattern::mdrange, Pattern::tpttr,
+      Pattern::tptvr, Pattern::tpttrtvr};
+#endif
+  return candidates;
+}
+
+// caller holds table_mutex
+Kernel &Insert(const std::string &name, const Extents &extents, const Pattern chosen) {
+  KernelList &list = table[name];
+  for (auto &k : list) {
+    if (k.first == extents) return *k.second;
+  }
+  list.emplace_back(extents, std::make_unique<Kernel>(Candidates(), trials, chosen));
+  return *list.back().second;
+}
+
+void ReadCache() {
+  std::ifstream is(cache_file);
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string pattern, name;
+    Extents extents;
+    fields >> pattern >> extents[0] >> extents[1] >> extents[2] >> extents[3];
+    std::getline(fields >> std::ws, name);
+    const auto &cand = Candidates();
+    const auto p = std::find_if(cand.begin(), cand.end(), [&pattern](Pattern c) {
+      return pattern == PatternName(c);
+    });
+    // entries written by a build with a different backend may name unusable patterns
+    if (fields.fail() || name.empty() || p == cand.end()) continue;
+    Insert(name, extents, *p);
+  }
+}
+} // namespace
+
+const char *PatternName(const Pattern pattern) {
+  return kNames[static_cast<int>(pattern)];
+}
+
+Kernel::Kernel(const std::vector<Pattern> &candidates, const int trials,
+               const Pattern chosen)
+    : candidates_(candidates), trials_(trials), chosen_(chosen), next_trial_(0),
+      best_(candidates.size(), std::numeric_limits<double>::max()), reported_(0) {}
+
+//----------------------------------------------------------------------------------------
+//! \fn Pattern Kernel::Next(bool *timed)
+//  \brief hands out the trials in order, trials_ per candidate; calls made while the
+//  last trials are still running get Pattern::undecided, i.e. the compile-time default
+
+Pattern Kernel::Next(bool *timed) {
+  const Pattern chosen = Chosen();
+  *timed = false;
+  if (chosen != Pattern::undecided) return chosen;
+  const int trial = next_trial_.fetch_add(1, std::memory_order_relaxed);
+  if (trial >= trials_*static_cast<int>(candidates_.size())) return Pattern::undecided;
+  *timed = true;
+  return candidates_[trial/trials_];
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Kernel::Report(const Pattern pattern, const double seconds)
+//  \brief keeps the fastest trial of each candidate and locks in the overall fastest
+//  once every trial has been reported
+
+void Kernel::Report(const Pattern pattern, const double seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto c = std::find(candidates_.begin(), candidates_.end(), pattern)
+                 - candidates_.begin();
+  best_[c] = std::min(best_[c], seconds);
+  if (++reported_ == trials_*static_cast<int>(candidates_.size())) {
+    const auto fastest = std::min_element(best_.begin(), best_.end()) - best_.begin();
+    chosen_.store(candidates_[fastest], std::memory_order_release);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Kernel &LoopTuning::Find(const std::string &name, const Extents &extents)
+//  \brief looks up a kernel; kernels are never removed, so references stay valid
+
+Kernel &Find(const std::string &name, const Extents &extents) {
+  std::lock_guard<std::mutex> lock(table_mutex);
+  return Insert(name, extents, Pattern::undecided);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LoopTuning::Initialize(ParameterInput *pin)
+//  \brief read the <autotune> block and the patterns cached by earlier runs
+
+void Initialize(ParameterInput *pin) {
+  std::lock_guard<std::mutex> lock(table_mutex);
+  table.clear();
+  generation++;
+  enabled = pin->GetOrAddBoolean("autotune", "loop_patterns", false);
+  if (!enabled) return;
+  trials = pin->GetOrAddInteger("autotune", "trials", 2);
+  if (trials < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in LoopTuning::Initialize" << std::endl
+        << "trials must be >= 1, but trials=" << trials << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  cache_file = pin->GetOrAddString("autotune", "cache_file", "loop_patterns.cache");
+  ReadCache();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LoopTuning::WriteCache()
+//  \brief rank 0 writes one line "pattern nn nk nj ni name" per decided kernel
+
+void WriteCache() {
+  if (!enabled || Globals::my_rank != 0) return;
+  std::vector<std::tuple<std::string, Extents, Pattern>> decided;
+  {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    for (const auto &entry : table) {
+      for (const auto &k : entry.second) {
+        const Pattern p = k.second->Chosen();
+        if (p != Pattern::undecided) decided.emplace_back(entry.first, k.first, p);
+      }
+    }
+  }
+  std::sort(decided.begin(), decided.end());
+
+  std::ofstream os(cache_file);
+  if (!os) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in LoopTuning::WriteCache" << std::endl
+        << "Could not open file '" << cache_file << "' for the loop patterns."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  os << "# par_for loop patterns chosen with <autotune>/loop_patterns = true" << std::endl
+     << "# pattern nn nk nj ni name" << std::endl;
+  for (const auto &d : decided) {
+    const Extents &e = std::get<1>(d);
+    os << PatternName(std::get<2>(d)) << " " << e[0] << " " << e[1] << " " << e[2]
+       << " " << e[3] << " " << std::get<0>(d) << std::endl;
+  }
+}
+} // namespace LoopTuning
+} // namespace parthenon
@@ -0,0 +1,100 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef UTILS_LOOP_TUNING_HPP_
+#define UTILS_LOOP_TUNING_HPP_
+//! \file loop_tuning.hpp
+//  \brief runtime selection of the par_for loop pattern per named kernel
+//
+//  With <autotune>/loop_patterns enabled, the first calls of every named 3D and 4D
+//  default par_for cycle through the candidate loop patterns, each timed
+//  <autotune>/trials times.  The fastest is then used for all later calls.  A kernel is
+//  identified by its name and loop extents, since the best pattern depends on both.  The
+//  choices are saved to <autotune>/cache_file and reused by later runs without
+//  retuning.  The dispatch itself lives in kokkos_abstraction.hpp.
+
+// C++ headers
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace parthenon {
+class ParameterInput;
+
+namespace LoopTuning {
+enum class Pattern {flatrange, simdfor, mdrange, tpttr, tptvr, tpttrtvr, undecided};
+
+// true when <autotune>/loop_patterns is enabled; checked before any other work
+extern bool enabled;
+// bumped by every Initialize(), which drops all kernels and so invalidates CallSites
+extern int generation;
+
+// reads the <autotune> block and, if it exists, the cache file
+void Initialize(ParameterInput *pin);
+// rank 0 writes the patterns chosen so far, and those read from the cache, to the cache
+void WriteCache();
+
+const char *PatternName(const Pattern pattern);
+
+//----------------------------------------------------------------------------------------
+//! \class Kernel
+//  \brief the tuning state of one kernel; safe to use from several threads at once
+
+class Kernel {
+ public:
+  Kernel(const std::vector<Pattern> &candidates, const int trials, const Pattern chosen);
+
+  // the pattern for the next call; *timed is set if its time must be Report()ed
+  Pattern Next(bool *timed);
+  void Report(const Pattern pattern, const double seconds);
+  Pattern Chosen() const { return chosen_.load(std::memory_order_acquire); }
+
+ private:
+  const std::vector<Pattern> candidates_;
+  const int trials_;
+  std::atomic<Pattern> chosen_;
+  std::atomic<int> next_trial_;
+  std::mutex mutex_;
+  std::vector<double> best_;
+  int reported_;
+};
+
+// the kernel called "name" with loop extents {nn, nk, nj, ni}, created on first use
+Kernel &Find(const std::string &name, const std::array<int, 4> &extents);
+
+//----------------------------------------------------------------------------------------
+//! \struct CallSite
+//  \brief the kernel last launched from one par_for call site by one thread, so that
+//  repeated launches skip the locked lookup in Find()
+
+struct CallSite {
+  int generation = -1;
+  std::string name;
+  std::array<int, 4> extents;
+  Kernel *kernel = nullptr;
+
+  Kernel &Get(const std::string &kname, const std::array<int, 4> &kextents) {
+    if (generation != LoopTuning::generation || kextents != extents || kname != name) {
+      kernel = &Find(kname, kextents);
+      generation = LoopTuning::generation;
+      name = kname;
+      extents = kextents;
+    }
+    return *kernel;
+  }
+};
+} // namespace LoopTuning
+} // namespace parthenon
+
+#endif // UTILS_LOOP_TUNING_HPP_
@@ -0,0 +1,280 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file memory_usage.cpp
+//  \brief implementation of the per-package memory accounting and its report
+
+// C++ headers
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "bvals/cc/bvals_cc.hpp"
+#include "globals.hpp"
+#include "memory_usage.hpp"
+#include "mesh/mesh.hpp"
+#include "parameter_input.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace parthenon {
+namespace MemoryUsage {
+bool enabled = false;
+
+namespace {
+const char *kCategoryNames[kNumCategories] = {"cell", "flux", "coarse", "comm bufs"};
+const char kOther[] = "(other)";
+constexpr double kMiB = 1024.0*1024.0;
+
+// largest sum over ranks seen by any report so far, and the report that saw it
+double peak_total = 0.0;
+std::string peak_when;
+
+// a "VmRSS:" style line of /proc/self/status, in bytes
+std::size_t ProcStatus(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, key.size(), key) == 0) {
+      std::istringstream is(line.substr(key.size()));
+      std::size_t kb = 0;
+      is >> kb;
+      return 1024*kb;
+    }
+  }
+  return 0;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryUsage::Initialize(ParameterInput *pin)
+//  \brief read the <profiling> block
+
+void Initialize(ParameterInput *pin) {
+  enabled = pin->GetOrAddBoolean("profiling", "memory", false);
+  peak_total = 0.0;
+  peak_when.clear();
+}
+
+std::size_t ResidentBytes() { return ProcStatus("VmRSS:"); }
+std::size_t PeakResidentBytes() { return ProcStatus("VmHWM:"); }
+
+//----------------------------------------------------------------------------------------
+//! \fn MemoryUsage::Tally::Tally(const Packages_t &packages)
+//  \brief one row per field of every package; a field registered by several packages
+//  is attributed to the first of them
+
+Tally::Tally(const Packages_t &packages) {
+  for (const auto &pkg : packages) {
+    for (const auto &field : pkg.second->AllFields()) {
+      if (row_of_variable_.count(field.first)) continue;
+      row_of_variable_[field.first] = static_cast<int>(rows_.size());
+      rows_.push_back(pkg.first + "/" + field.first);
+    }
+  }
+  rows_.push_back(kOther);
+  bytes_.assign(rows_.size(), {});
+}
+
+int Tally::RowOf(const std::string &label) const {
+  auto it = row_of_variable_.find(label);
+  return (it == row_of_variable_.end()) ? NumRows() - 1 : it->second;
+}
+
+void Tally::Count(const int row, const Category c, AthenaArray<Real> &a) {
+  if (!a.IsAllocated() || !seen_.insert(a.data()).second) return;
+  bytes_[row][static_cast<int>(c)] += a.GetSizeInBytes();
+}
+
+void Tally::Count(const int row, Variable<Real> &v) {
+  Count(row, Category::cell, v);
+  // communication members are only set up for variables with ghost exchange
+  if (!v.metadata().IsSet(Metadata::FillGhost)) return;
+  for (int d=0; d<3; ++d)
+    Count(row, Category::flux, v.flux[d]);
+  if (v.coarse_s != nullptr) Count(row, Category::coarse, *v.coarse_s);
+  if (v.coarse_r != nullptr) Count(row, Category::coarse, *v.coarse_r);
+  if (v.vbvar != nullptr && seen_.insert(v.vbvar).second)
+    bytes_[row][static_cast<int>(Category::comm)] += v.vbvar->GetBufferSizeInBytes();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryUsage::Tally::Add(Container<Real> &rc)
+//  \brief count the variables of every stage of rc
+
+void Tally::Add(Container<Real> &rc) {
+  for (const auto &st : rc.AllStages()) {
+    Stage<Real> &stage = *st.second;
+    for (auto &v : stage._varArray)
+      Count(RowOf(v->label()), *v);
+    for (auto &f : stage._faceArray) {
+      const int row = RowOf(f->label());
+      Count(row, Category::cell, f->x1f);
+      Count(row, Category::cell, f->x2f);
+      Count(row, Category::cell, f->x3f);
+    }
+    for (auto &sparse : stage._sparseVars.getAllCellVars()) {
+      const int row = RowOf(sparse.first);
+      for (auto &v : sparse.second)
+        Count(row, *v.second);
+    }
+  }
+}
+
+void Tally::Add(MeshBlock *pmb) {
+  const std::size_t before = Total();
+  Add(pmb->real_container);
+  max_block_ = std::max(max_block_, Total() - before);
+  nblocks_++;
+  // nothing is shared between blocks
+  seen_.clear();
+}
+
+std::size_t Tally::Bytes(const Category c) const {
+  std::size_t sum = 0;
+  for (const auto &b : bytes_)
+    sum += b[static_cast<int>(c)];
+  return sum;
+}
+
+std::size_t Tally::Total() const {
+  std::size_t sum = 0;
+  for (int c=0; c<kNumCategories; ++c)
+    sum += Bytes(static_cast<Category>(c));
+  return sum;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MemoryUsage::Report(Mesh *pm, const std::string &when, std::ostream &os)
+//  \brief collective; prints the bytes per package and variable summed over ranks, the
+//  spread of the per-rank and per-block totals, and the resident set size
+
+void Report(Mesh *pm, const std::string &when, std::ostream &os) {
+  if (!enabled) return;
+  Tally tally(pm->packages);
+  for (MeshBlock *pmb = pm->pblock; pmb != nullptr; pmb = pmb->next)
+    tally.Add(pmb);
+
+  // per row and category, reduced with a sum
+  const int nrows = tally.NumRows();
+  std::vector<double> rows(nrows*kNumCategories), rows_sum(rows.size());
+  for (int n=0; n<nrows; ++n) {
+    for (int c=0; c<kNumCategories; ++c)
+      rows[n*kNumCategories + c] = tally.Bytes(n, static_cast<Category>(c));
+  }
+  // per rank, reduced with min, max and sum
+  enum {kTotal, kMaxBlock, kBlocks, kRSS, kPeakRSS, kNumRank};
+  std::vector<double> rank(kNumRank), rank_min(kNumRank), rank_max(kNumRank),
+      rank_sum(kNumRank);
+  rank[kTotal] = tally.Total();
+  rank[kMaxBlock] = tally.MaxBlock();
+  rank[kBlocks] = tally.NumBlocks();
+  rank[kRSS] = ResidentBytes();
+  rank[kPeakRSS] = PeakResidentBytes();
+#ifdef MPI_PARALLEL
+  MPI_Reduce(rows.data(), rows_sum.data(), rows.size(), MPI_DOUBLE, MPI_SUM, 0,
+             MPI_COMM_WORLD);
+  MPI_Reduce(rank.data(), rank_min.data(), kNumRank, MPI_DOUBLE, MPI_MIN, 0,
+             MPI_COMM_WORLD);
+  MPI_Reduce(rank.data(), rank_max.data(), kNumRank, MPI_DOUBLE, MPI_MAX, 0,
+             MPI_COMM_WORLD);
+  MPI_Reduce(rank.data(), rank_sum.data(), kNumRank, MPI_DOUBLE, MPI_SUM, 0,
+             MPI_COMM_WORLD);
+#else
+  rows_sum = rows;
+  rank_min = rank;
+  rank_max = rank;
+  rank_sum = rank;
+#endif
+  if (Globals::my_rank != 0) return;
+
+  const bool new_peak = rank_sum[kTotal] > peak_total;
+  if (new_peak) {
+    peak_total = rank_sum[kTotal];
+    peak_when = when;
+  }
+
+  const double nranks = static_cast<double>(Globals::nranks);
+  std::ios_base::fmtflags flags = os.flags();
+  auto nonzero = [](const double *bytes) {
+    return std::any_of(bytes, bytes + kNumCategories, [](double b) { return b > 0.0; });
+  };
+  auto print_row = [&](const std::string &name, const double *bytes) {
+    double total = 0.0;
+    os << std::left << std::setw(40) << name << std::right;
+    for (int c=0; c<kNumCategories; ++c) {
+      os << std::setw(12) << bytes[c]/kMiB;
+      total += bytes[c];
+    }
+    os << std::setw(12) << total/kMiB << std::endl;
+  };
+  os << std::endl << "Memory report (" << when << "): MiB over "
+     << static_cast<int>(rank_sum[kBlocks]) << " block(s) on " << Globals::nranks
+     << " rank(s)" << std::endl
+     << std::left << std::setw(40) << "package/variable" << std::right;
+  for (int c=0; c<kNumCategories; ++c)
+    os << std::setw(12) << kCategoryNames[c];
+  os << std::setw(12) << "total" << std::endl << std::fixed << std::setprecision(3);
+
+  // a package line summing its variables, followed by the variables with any memory
+  std::vector<double> totals(kNumCategories, 0.0);
+  int n = 0;
+  while (n < nrows) {
+    const std::string &row = tally.Row(n);
+    const std::string package = row.substr(0, row.find('/'));
+    const std::string prefix = package + "/";
+    int end = n;
+    std::vector<double> pkg(kNumCategories, 0.0);
+    for (; end < nrows && tally.Row(end).compare(0, prefix.size(), prefix) == 0; ++end) {
+      for (int c=0; c<kNumCategories; ++c)
+        pkg[c] += rows_sum[end*kNumCategories + c];
+    }
+    if (end == n) {  // the "(other)" row
+      end = n + 1;
+      for (int c=0; c<kNumCategories; ++c)
+        pkg[c] = rows_sum[n*kNumCategories + c];
+    }
+    for (int c=0; c<kNumCategories; ++c)
+      totals[c] += pkg[c];
+    if (package != kOther || nonzero(pkg.data())) print_row(package, pkg.data());
+    for (; n < end && package != kOther; ++n) {
+      const double *bytes = &rows_sum[n*kNumCategories];
+      if (nonzero(bytes))
+        print_row("  " + tally.Row(n).substr(prefix.size()), bytes);
+    }
+    n = end;
+  }
+  print_row("total", totals.data());
+
+  os << "per rank    min/mean/max " << rank_min[kTotal]/kMiB << " / "
+     << rank_sum[kTotal]/nranks/kMiB << " / " << rank_max[kTotal]/kMiB << std::endl;
+  if (rank_sum[kBlocks] > 0) {
+    os << "per block   mean/max     " << rank_sum[kTotal]/rank_sum[kBlocks]/kMiB
+       << " / " << rank_max[kMaxBlock]/kMiB << std::endl;
+  }
+  if (rank_max[kRSS] > 0) {
+    os << "process RSS min/mean/max " << rank_min[kRSS]/kMiB << " / "
+       << rank_sum[kRSS]/nranks/kMiB << " / " << rank_max[kRSS]/kMiB
+       << ", peak " << rank_max[kPeakRSS]/kMiB << std::endl;
+  }
+  os << "high-water mark " << peak_total/kMiB
+     << (new_peak ? " (this report)" : " (" + peak_when + ")") << std::endl;
+  os.flags(flags);
+}
+} // namespace MemoryUsage
+} // namespace parthenon
@@ -0,0 +1,100 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef UTILS_MEMORY_USAGE_HPP_
+#define UTILS_MEMORY_USAGE_HPP_
+//! \file memory_usage.hpp
+//  \brief accounting of the memory held by the variables of every package
+//
+//  Bytes are attributed to the package that registered each variable and split into
+//  cell (or face) data, fluxes, coarse buffers used for refinement, and boundary
+//  communication buffers.  Arrays shared between container stages or variables are
+//  counted once.  Reports are written at startup, after every step that refined or
+//  derefined blocks, and at the end of the run, and track the high-water mark.
+
+// C++ headers
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Athena++ headers
+#include "athena.hpp"
+#include "interface/Container.hpp"
+#include "interface/StateDescriptor.hpp"
+
+namespace parthenon {
+class Mesh;
+class MeshBlock;
+class ParameterInput;
+
+namespace MemoryUsage {
+enum class Category {cell, flux, coarse, comm};
+constexpr int kNumCategories = 4;
+
+// true when <profiling>/memory is enabled
+extern bool enabled;
+
+void Initialize(ParameterInput *pin);
+
+//----------------------------------------------------------------------------------------
+//! \class Tally
+//  \brief bytes per variable and category of the blocks of one rank
+
+class Tally {
+ public:
+  explicit Tally(const Packages_t &packages);
+
+  // all stages of the real container of pmb, counted as one block
+  void Add(MeshBlock *pmb);
+  void Add(Container<Real> &rc);
+
+  // rows are "package/variable" in package order, then "(other)" for variables that no
+  // package registered; the row layout only depends on the packages
+  int NumRows() const { return static_cast<int>(rows_.size()); }
+  const std::string &Row(const int n) const { return rows_[n]; }
+  std::size_t Bytes(const int row, const Category c) const {
+    return bytes_[row][static_cast<int>(c)];
+  }
+  std::size_t Bytes(const Category c) const;
+  std::size_t Total() const;
+  std::size_t MaxBlock() const { return max_block_; }
+  int NumBlocks() const { return nblocks_; }
+
+ private:
+  std::vector<std::string> rows_;
+  std::map<std::string, int> row_of_variable_;
+  std::vector<std::array<std::size_t, kNumCategories>> bytes_;
+  // data pointers already counted, so that shallow copies are not counted twice
+  std::unordered_set<const void *> seen_;
+  std::size_t max_block_ = 0;
+  int nblocks_ = 0;
+
+  int RowOf(const std::string &label) const;
+  void Count(const int row, const Category c, AthenaArray<Real> &a);
+  void Count(const int row, Variable<Real> &v);
+};
+
+// collective: tallies the blocks of every rank, prints the sums over ranks on rank 0
+// and records the high-water mark; "when" labels the report
+void Report(Mesh *pm, const std::string &when, std::ostream &os = std::cout);
+
+// resident set size and its peak of this process in bytes, 0 where unavailable
+std::size_t ResidentBytes();
+std::size_t PeakResidentBytes();
+} // namespace MemoryUsage
+} // namespace parthenon
+
+#endif // UTILS_MEMORY_USAGE_HPP_
@@ -0,0 +1,305 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file timers.cpp
+//  \brief implementation of the hierarchical timers and the per-rank report
+
+// C++ headers
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Kokkos headers
+#include <Kokkos_Core.hpp>
+
+// Athena++ headers
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "timers.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace parthenon {
+namespace Timers {
+bool enabled = false;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Node {
+  std::string name;
+  int parent;
+  std::vector<int> children;
+  double seconds;
+  std::int64_t calls;
+};
+
+struct Frame {
+  int node;
+  Clock::time_point start;
+  bool timed;
+};
+
+//! \struct ThreadTree
+//  \brief the regions recorded by one thread; nodes[0] is the (unnamed) root
+
+struct ThreadTree {
+  ThreadTree() : nodes{Node{"", -1, {}, 0.0, 0}} { stack.reserve(32); }
+
+  int Top() const { return stack.empty() ? 0 : stack.back().node; }
+
+  // returns the child of "parent" called "name", creating it on first use only
+  int Child(const int parent, const std::string &name) {
+    for (const int c : nodes[parent].children) {
+      if (nodes[c].name == name) return c;
+    }
+    nodes.push_back(Node{name, parent, {}, 0.0, 0});
+    const int c = static_cast<int>(nodes.size()) - 1;
+    nodes[parent].children.push_back(c);
+    return c;
+  }
+
+  std::vector<Node> nodes;
+  std::vector<Frame> stack;
+};
+
+// trees are owned here rather than by the threads, so they survive the end of parallel
+// regions and can be merged by whichever thread writes the report
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadTree>> registry;
+int report_interval = 0;
+
+ThreadTree &Local() {
+  thread_local ThreadTree *tree = nullptr;
+  if (tree == nullptr) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.push_back(std::make_unique<ThreadTree>());
+    tree = registry.back().get();
+  }
+  return *tree;
+}
+
+struct Stat {
+  double seconds = 0.0;
+  std::int64_t calls = 0;
+};
+
+// region paths are sent between ranks with names separated by kSep
+constexpr char kSep = '\x1f';
+
+void Flatten(const ThreadTree &tree, const int node, const std::string &path,
+             std::map<std::string, Stat> *stats) {
+  for (const int c : tree.nodes[node].children) {
+    const Node &n = tree.nodes[c];
+    const std::string key = path.empty() ? n.name : path + kSep + n.name;
+    Stat &s = (*stats)[key];
+    s.seconds += n.seconds;
+    s.calls += n.calls;
+    Flatten(tree, c, key, stats);
+  }
+}
+
+#ifdef MPI_PARALLEL
+// serializes the keys of a path list as consecutive NUL-terminated strings
+std::string Pack(const std::vector<std::string> &keys) {
+  std::string buf;
+  for (const auto &k : keys) {
+    buf += k;
+    buf += '\0';
+  }
+  return buf;
+}
+
+void Unpack(const char *buf, const int len, std::vector<std::string> *keys) {
+  int pos = 0;
+  while (pos < len) {
+    keys->emplace_back(buf + pos);
+    pos += static_cast<int>(keys->back().size()) + 1;
+  }
+}
+#endif
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Timers::Initialize(ParameterInput *pin)
+//  \brief read the <profiling> block of the input file
+
+void Initialize(ParameterInput *pin) {
+  enabled = pin->GetOrAddBoolean("profiling", "timers", false);
+  report_interval = pin->GetOrAddInteger("profiling", "report_interval", 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Timers::Push(const std::string &name)
+//  \brief open region "name" as a child of the innermost region open on this thread
+
+void Push(const std::string &name) {
+  ThreadTree &tree = Local();
+  const int node = tree.Child(tree.Top(), name);
+  Kokkos::Profiling::pushRegion(name);
+  tree.stack.push_back(Frame{node, Clock::now(), true});
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Timers::Pop()
+//  \brief close the innermost region open on this thread
+
+void Pop() {
+  const Clock::time_point stop = Clock::now();
+  ThreadTree &tree = Local();
+  const Frame &f = tree.stack.back();
+  Node &n = tree.nodes[f.node];
+  n.seconds += std::chrono::duration<double>(stop - f.start).count();
+  ++n.calls;
+  tree.stack.pop_back();
+  Kokkos::Profiling::popRegion();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::vector<std::string> Timers::CurrentPath()
+//  \brief names of the regions open on the calling thread, outermost first
+
+std::vector<std::string> CurrentPath() {
+  std::vector<std::string> path;
+  if (!enabled) return path;
+  const ThreadTree &tree = Local();
+  for (const Frame &f : tree.stack)
+    path.push_back(tree.nodes[f.node].name);
+  return path;
+}
+
+ScopedPath::ScopedPath(const std::vector<std::string> &path) : depth_(0) {
+  if (!enabled) return;
+  ThreadTree &tree = Local();
+  // a thread that already runs inside the path (e.g. the master thread) keeps its stack
+  if (!tree.stack.empty()) return;
+  for (const auto &name : path) {
+    tree.stack.push_back(Frame{tree.Child(tree.Top(), name), Clock::time_point(), false});
+  }
+  depth_ = static_cast<int>(path.size());
+}
+
+ScopedPath::~ScopedPath() {
+  if (depth_ == 0) return;
+  ThreadTree &tree = Local();
+  tree.stack.resize(tree.stack.size() - depth_);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Timers::Report(std::ostream &os)
+//  \brief merge the regions of all threads on each rank and print, on rank 0, the
+//  per-rank min/mean/max of the accumulated thread-seconds of every region.  Must be
+//  called by all ranks, outside of any threaded region.
+
+void Report(std::ostream &os) {
+  if (!enabled) return;
+  std::map<std::string, Stat> local;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const auto &tree : registry)
+      Flatten(*tree, 0, "", &local);
+  }
+
+  // the union of the region paths of all ranks, in sorted (tree) order
+  std::vector<std::string> keys;
+  for (const auto &kv : local)
+    keys.push_back(kv.first);
+#ifdef MPI_PARALLEL
+  {
+    std::string buf = Pack(keys);
+    int len = static_cast<int>(buf.size());
+    std::vector<int> lens(Globals::nranks), displs(Globals::nranks, 0);
+    MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    std::string all;
+    if (Globals::my_rank == 0) {
+      for (int r=1; r<Globals::nranks; ++r)
+        displs[r] = displs[r-1] + lens[r-1];
+      all.resize(displs.back() + lens.back());
+    }
+    MPI_Gatherv(&buf[0], len, MPI_CHAR, &all[0], lens.data(), displs.data(), MPI_CHAR,
+                0, MPI_COMM_WORLD);
+    if (Globals::my_rank == 0) {
+      std::vector<std::string> merged;
+      Unpack(all.data(), static_cast<int>(all.size()), &merged);
+      std::sort(merged.begin(), merged.end());
+      merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+      buf = Pack(merged);
+      len = static_cast<int>(buf.size());
+    }
+    MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    buf.resize(len);
+    MPI_Bcast(&buf[0], len, MPI_CHAR, 0, MPI_COMM_WORLD);
+    keys.clear();
+    Unpack(buf.data(), len, &keys);
+  }
+#endif
+
+  const int n = static_cast<int>(keys.size());
+  std::vector<double> t(n), t_min(n), t_max(n), t_sum(n), calls(n), calls_sum(n);
+  for (int i=0; i<n; ++i) {
+    auto it = local.find(keys[i]);
+    t[i] = (it == local.end()) ? 0.0 : it->second.seconds;
+    calls[i] = (it == local.end()) ? 0.0 : static_cast<double>(it->second.calls);
+  }
+#ifdef MPI_PARALLEL
+  MPI_Reduce(t.data(), t_min.data(), n, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+  MPI_Reduce(t.data(), t_max.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+  MPI_Reduce(t.data(), t_sum.data(), n, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  MPI_Reduce(calls.data(), calls_sum.data(), n, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+#else
+  t_min = t;
+  t_max = t;
+  t_sum = t;
+  calls_sum = calls;
+#endif
+  if (Globals::my_rank != 0) return;
+
+  const double nranks = static_cast<double>(Globals::nranks);
+  std::ios_base::fmtflags flags = os.flags();
+  os << std::endl << "Timer report: thread-seconds per region over " << Globals::nranks
+     << " rank(s)" << std::endl
+     << std::left << std::setw(48) << "region" << std::right
+     << std::setw(12) << "calls/rank" << std::setw(12) << "min"
+     << std::setw(12) << "mean" << std::setw(12) << "max"
+     << std::setw(10) << "max/mean" << std::endl;
+  for (int i=0; i<n; ++i) {
+    const int depth = static_cast<int>(std::count(keys[i].begin(), keys[i].end(), kSep));
+    const std::string name = keys[i].substr(keys[i].rfind(kSep) + 1);
+    const double mean = t_sum[i]/nranks;
+    os << std::left << std::setw(48) << (std::string(2*depth, ' ') + name) << std::right
+       << std::fixed << std::setprecision(1) << std::setw(12) << calls_sum[i]/nranks
+       << std::setprecision(4) << std::setw(12) << t_min[i] << std::setw(12) << mean
+       << std::setw(12) << t_max[i] << std::setprecision(2) << std::setw(10)
+       << (mean > 0.0 ? t_max[i]/mean : 1.0) << std::endl;
+  }
+  os.flags(flags);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Timers::ReportIfDue(const int ncycle)
+//  \brief collective; writes a Report() every <profiling>/report_interval cycles
+
+void ReportIfDue(const int ncycle) {
+  if (enabled && report_interval > 0 && ncycle % report_interval == 0)
+    Report(std::cout);
+}
+} // namespace Timers
+} // namespace parthenon
@@ -0,0 +1,88 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef UTILS_TIMERS_HPP_
+#define UTILS_TIMERS_HPP_
+//! \file timers.hpp
+//  \brief lightweight hierarchical wall-clock timers with Kokkos Tools regions
+//
+//  Regions nest: a region opened while another is active on the same thread is recorded
+//  as its child.  Every thread accumulates into its own tree, so timing a task costs two
+//  clock reads and a short search among the children of the current region, with no
+//  locking.  The trees are merged by region path when a report is written.
+
+// C++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace parthenon {
+class ParameterInput;
+
+namespace Timers {
+// true when <profiling>/timers is enabled; checked before any other work on the hot path
+extern bool enabled;
+
+void Initialize(ParameterInput *pin);
+void Push(const std::string &name);
+void Pop();
+
+// names of the regions active on the calling thread, outermost first
+std::vector<std::string> CurrentPath();
+
+// collective over all ranks: merge all threads and print min/mean/max over ranks
+void Report(std::ostream &os = std::cout);
+// collective: Report() every <profiling>/report_interval cycles (0 = never)
+void ReportIfDue(const int ncycle);
+
+//----------------------------------------------------------------------------------------
+//! \class ScopedRegion
+//  \brief times the enclosing scope as region "name"; a literal name is only turned into
+//  a std::string when timers are enabled
+
+class ScopedRegion {
+ public:
+  explicit ScopedRegion(const std::string &name) : active_(enabled) {
+    if (active_) Push(name);
+  }
+  explicit ScopedRegion(const char *name) : active_(enabled) {
+    if (active_) Push(name);
+  }
+  ~ScopedRegion() {
+    if (active_) Pop();
+  }
+  ScopedRegion(const ScopedRegion &) = delete;
+  ScopedRegion &operator=(const ScopedRegion &) = delete;
+
+ private:
+  const bool active_;
+};
+
+//----------------------------------------------------------------------------------------
+//! \class ScopedPath
+//  \brief re-opens (untimed) the regions of "path" on the calling thread, so that work
+//  farmed out to other threads, e.g. block task lists, nests under the caller's region
+
+class ScopedPath {
+ public:
+  explicit ScopedPath(const std::vector<std::string> &path);
+  ~ScopedPath();
+  ScopedPath(const ScopedPath &) = delete;
+  ScopedPath &operator=(const ScopedPath &) = delete;
+
+ private:
+  int depth_;
+};
+} // namespace Timers
+} // namespace parthenon
+
+#endif // UTILS_TIMERS_HPP_
@@ -0,0 +1,233 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+//! \file trace.cpp
+//  \brief implementation of the per-thread task timeline
+
+// C++ headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "trace.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+// OpenMP header
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace parthenon {
+namespace Trace {
+bool enabled = false;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// task names longer than this are truncated in the trace
+constexpr std::size_t kNameLength = 40;
+
+struct Event {
+  std::int64_t begin, end;
+  std::int32_t gid, task, stage;
+  bool complete;
+  char name[kNameLength];
+};
+
+//! \struct Buffer
+//  \brief ring of events owned by a single thread; head counts every event ever recorded
+
+struct Buffer {
+  std::vector<Event> events;
+  std::uint64_t head;
+};
+
+std::vector<Buffer> buffers;
+std::atomic<int> next_buffer(0);
+std::atomic<std::int64_t> dropped(0);
+// bumped by every Initialize(), so that threads claim a fresh buffer afterwards
+int generation = 0;
+Clock::time_point epoch;
+std::string file_basename;
+
+// the buffer of the calling thread, or nullptr once all buffers have been claimed
+Buffer *Local() {
+  thread_local Buffer *buf = nullptr;
+  thread_local int claimed = -1;
+  if (claimed != generation) {
+    claimed = generation;
+    const int slot = next_buffer.fetch_add(1);
+    buf = (slot < static_cast<int>(buffers.size())) ? &buffers[slot] : nullptr;
+  }
+  return buf;
+}
+
+void WriteEscaped(std::ostream &os, const char *s) {
+  for (; *s != '\0'; ++s) {
+    if (*s == '"' || *s == '\\') {
+      os << '\\' << *s;
+    } else if (static_cast<unsigned char>(*s) < 0x20) {
+      os << ' ';
+    } else {
+      os << *s;
+    }
+  }
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Trace::Initialize(ParameterInput *pin)
+//  \brief read the <profiling> block and allocate one ring buffer per thread
+
+void Initialize(ParameterInput *pin) {
+  enabled = pin->GetOrAddBoolean("profiling", "trace", false);
+  buffers.clear();
+  next_buffer = 0;
+  dropped = 0;
+  generation++;
+  if (!enabled) return;
+
+  const int nevents = pin->GetOrAddInteger("profiling", "trace_events", 65536);
+  if (nevents < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in Trace::Initialize" << std::endl
+        << "trace_events must be >= 1, but trace_events=" << nevents << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  const std::string problem_id = pin->DoesParameterExist("job", "problem_id")
+                                 ? pin->GetString("job", "problem_id") : "parthenon";
+  file_basename = pin->GetOrAddString("profiling", "trace_file", problem_id + ".trace");
+
+  int nthreads = pin->GetOrAddInteger("mesh", "num_threads", 1);
+#ifdef OPENMP_PARALLEL
+  nthreads = std::max(nthreads, omp_get_max_threads());
+#endif
+  buffers.resize(nthreads);
+  for (auto &b : buffers) {
+    b.events.resize(nevents);
+    b.head = 0;
+  }
+
+#ifdef MPI_PARALLEL
+  // line up the clocks of all ranks to within the barrier latency
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  epoch = Clock::now();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::int64_t Trace::Now()
+//  \brief nanoseconds since Initialize()
+
+std::int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch)
+      .count();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Trace::Record(...)
+//  \brief append a task event to the calling thread's buffer, overwriting the oldest
+//  event if the buffer is full
+
+void Record(const std::string &name, const std::int64_t begin, const int gid,
+            const int task, const int stage, const bool complete) {
+  Buffer *buf = Local();
+  if (buf == nullptr) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Event &e = buf->events[buf->head % buf->events.size()];
+  e.begin = begin;
+  e.end = Now();
+  e.gid = gid;
+  e.task = task;
+  e.stage = stage;
+  e.complete = complete;
+  const std::size_t len = std::min(name.size(), kNameLength - 1);
+  std::memcpy(e.name, name.data(), len);
+  e.name[len] = '\0';
+  buf->head++;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Trace::Write()
+//  \brief write the events of this rank in the Chrome trace event format, one complete
+//  ("X") event per task execution with pid = rank and tid = buffer index
+
+void Write() {
+  if (!enabled) return;
+  const std::string fname = file_basename + "." + std::to_string(Globals::my_rank)
+                            + ".json";
+  std::ofstream os(fname);
+  if (!os) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in Trace::Write" << std::endl
+        << "Could not open file '" << fname << "' for the task trace." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  const int rank = Globals::my_rank;
+  std::uint64_t overwritten = 0;
+  os << "{\"traceEvents\":[" << std::endl;
+  os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+     << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank << "\"}}";
+  os << std::fixed << std::setprecision(3);
+  for (std::size_t t = 0; t < buffers.size(); ++t) {
+    const Buffer &b = buffers[t];
+    if (b.head == 0) continue;
+    os << "," << std::endl << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank
+       << ",\"tid\":" << t << ",\"args\":{\"name\":\"thread " << t << "\"}}";
+    const std::uint64_t size = b.events.size();
+    const std::uint64_t count = std::min(b.head, size);
+    overwritten += b.head - count;
+    for (std::uint64_t n = b.head - count; n < b.head; ++n) {
+      const Event &e = b.events[n % size];
+      os << "," << std::endl << "{\"name\":\"";
+      WriteEscaped(os, e.name);
+      os << "\",\"cat\":\"task\",\"ph\":\"X\",\"ts\":" << 1.0e-3*e.begin
+         << ",\"dur\":" << 1.0e-3*(e.end - e.begin) << ",\"pid\":" << rank
+         << ",\"tid\":" << t << ",\"args\":{\"gid\":" << e.gid << ",\"task\":" << e.task
+         << ",\"stage\":" << e.stage << ",\"complete\":"
+         << (e.complete ? "true" : "false") << "}}";
+    }
+  }
+  os << std::endl << "]," << std::endl
+     << "\"displayTimeUnit\":\"ns\"," << std::endl
+     << "\"otherData\":{\"rank\":" << rank << ",\"nranks\":" << Globals::nranks
+     << ",\"overwritten\":" << overwritten << ",\"dropped\":" << dropped.load() << "}}"
+     << std::endl;
+
+  if (overwritten > 0 || dropped.load() > 0) {
+    std::cout << "### WARNING in Trace::Write" << std::endl
+              << "Rank " << rank << " lost " << overwritten << " task events to full "
+              << "buffers (see <profiling>/trace_events) and " << dropped.load()
+              << " from threads beyond <mesh>/num_threads." << std::endl;
+  }
+}
+} // namespace Trace
+} // namespace parthenon
@@ -0,0 +1,50 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef UTILS_TRACE_HPP_
+#define UTILS_TRACE_HPP_
+//! \file trace.hpp
+//  \brief per-thread task timeline written as Chrome trace JSON
+//
+//  Every thread that executes tasks claims one of the ring buffers allocated by
+//  Initialize() and is the only writer of it, so recording an event is a clock read and
+//  a copy into preallocated storage: no locks and no allocation.  When a buffer is full
+//  the oldest events are overwritten.  Write() dumps the buffers of this rank after the
+//  threads have joined.
+
+// C++ headers
+#include <cstdint>
+#include <string>
+
+namespace parthenon {
+class ParameterInput;
+
+namespace Trace {
+// true when <profiling>/trace is enabled; checked before any other work on the hot path
+extern bool enabled;
+
+// collective when tracing is enabled: ranks synchronize before starting their clocks
+void Initialize(ParameterInput *pin);
+
+// nanoseconds since Initialize()
+std::int64_t Now();
+
+// records task "name" as having run from "begin" until now on the calling thread
+void Record(const std::string &name, const std::int64_t begin, const int gid,
+            const int task, const int stage, const bool complete);
+
+// writes <trace_file>.<rank>.json; call outside of parallel regions
+void Write();
+} // namespace Trace
+} // namespace parthenon
+
+#endif // UTILS_TRACE_HPP_
@@ -2,9 +2,19 @@
 #include <catch2/catch.hpp>
 #include <Kokkos_Core.hpp>
 
+#include <defs.hpp>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
 int main( int argc, char* argv[] ) {
   // global setup...
   int result;
+#ifdef MPI_PARALLEL
+  // the code under test may call MPI, e.g. the collectives of reports and outputs
+  MPI_Init(&argc, &argv);
+#endif
   Kokkos::initialize(argc,argv);
   {
 
@@ -13,5 +23,8 @@ int main( int argc, char* argv[] ) {
   // global clean-up...
   }
   Kokkos::finalize();
+#ifdef MPI_PARALLEL
+  MPI_Finalize();
+#endif
   return result;
-}
\ No newline at end of file
+}
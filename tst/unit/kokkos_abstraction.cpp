@@ -19,6 +19,7 @@
 
 #include "kokkos_abstraction.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -266,6 +267,42 @@ TEST_CASE("par_for loops", "[wrapper]") {
   }
 }
 
+TEST_CASE("par_reduce", "[wrapper]") {
+  // host data, as used when reducing AthenaArrays
+  auto host_exec_space = Kokkos::DefaultHostExecutionSpace();
+  const int N = 16;
+  std::vector<Real> data(N*N*N);
+  for (int n = 0; n < N*N*N; n++)
+    data[n] = static_cast<Real>(n % 97);
+
+  SECTION("1D sum") {
+    Real sum = 0.0;
+    parthenon::par_reduce(
+        "unit test 1D sum", host_exec_space, 0, N - 1,
+        [&](const int i, Real &lsum) { lsum += data[i]; }, sum);
+    Real ref = 0.0;
+    for (int i = 0; i < N; i++)
+      ref += data[i];
+    REQUIRE(sum == ref);
+  }
+
+  SECTION("3D max") {
+    Real max = 0.0;
+    parthenon::par_reduce(
+        "unit test 3D max", host_exec_space, 1, N - 2, 1, N - 2, 1, N - 2,
+        [&](const int k, const int j, const int i, Real &lmax) {
+          lmax = std::max(lmax, data[i + N*(j + N*k)]);
+        },
+        Kokkos::Max<Real>(max));
+    Real ref = 0.0;
+    for (int k = 1; k <= N - 2; k++)
+      for (int j = 1; j <= N - 2; j++)
+        for (int i = 1; i <= N - 2; i++)
+          ref = std::max(ref, data[i + N*(j + N*k)]);
+    REQUIRE(max == ref);
+  }
+}
+
 struct LargeNShortTBufferPack {
   int nghost;
   int ncells; // number of cells in the linear dimension - very simplistic
@@ -0,0 +1,125 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <bvals/bvals.hpp>
+#include <globals.hpp>
+#include <interface/Metadata.hpp>
+#include <interface/StateDescriptor.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::Metadata;
+using parthenon::ParameterInput;
+using parthenon::Real;
+
+namespace {
+const char *kVariables[] = {"a", "b", "c"};
+
+// fills the interior of every block with smooth data, exchanges the ghost zones and
+// prolongates the coarse-fine boundaries; returns all cells of all variables
+std::vector<Real> ProlongatedData(const bool batched) {
+  std::stringstream input;
+  input << "<mesh>" << std::endl
+        << "refinement = static" << std::endl
+        << "num_threads = 2" << std::endl
+        << "batched_prolongation = " << (batched ? "true" : "false") << std::endl
+        << "nx1 = 32" << std::endl << "x1min = -1.0" << std::endl
+        << "x1max = 1.0" << std::endl
+        << "ix1_bc = outflow" << std::endl << "ox1_bc = outflow" << std::endl
+        << "nx2 = 32" << std::endl << "x2min = -1.0" << std::endl
+        << "x2max = 1.0" << std::endl
+        << "ix2_bc = outflow" << std::endl << "ox2_bc = outflow" << std::endl
+        << "nx3 = 1" << std::endl << "x3min = -0.5" << std::endl
+        << "x3max = 0.5" << std::endl
+        << "<meshblock>" << std::endl
+        << "nx1 = 8" << std::endl << "nx2 = 8" << std::endl << "nx3 = 1" << std::endl
+        << "<refinement1>" << std::endl
+        << "x1min = -0.4" << std::endl << "x1max = 0.3" << std::endl
+        << "x2min = -0.2" << std::endl << "x2max = 0.5" << std::endl
+        << "level = 2" << std::endl
+        << "<time>" << std::endl << "tlim = 1.0" << std::endl;
+  ParameterInput pin;
+  pin.LoadFromStream(input);
+
+  auto pkg = std::make_shared<parthenon::StateDescriptor>("Test");
+  Metadata m({Metadata::Cell, Metadata::Independent, Metadata::FillGhost});
+  for (auto name : kVariables) pkg->AddField(name, m);
+  parthenon::Packages_t packages;
+  packages["Test"] = pkg;
+  parthenon::Properties_t properties;
+  Mesh mesh(&pin, properties, packages);
+
+  std::vector<MeshBlock*> blocks;
+  for (MeshBlock *pmb = mesh.pblock; pmb != nullptr; pmb = pmb->next) {
+    blocks.push_back(pmb);
+    auto &pco = pmb->pcoord;
+    for (int v = 0; v < 3; ++v) {
+      auto &q = pmb->real_container.Get(kVariables[v]);
+      for (int j = pmb->js; j <= pmb->je; ++j) {
+        for (int i = pmb->is; i <= pmb->ie; ++i) {
+          q(0, j, i) = std::sin((v + 1)*pco->x1v(i)) + std::cos(3.0*pco->x2v(j))
+                       + v*pco->x1v(i)*pco->x2v(j);
+        }
+      }
+    }
+  }
+  for (auto pmb : blocks) {
+    pmb->pbval->SetupPersistentMPI();
+    pmb->real_container.SetupPersistentMPI();
+    pmb->real_container.StartReceiving(parthenon::BoundaryCommSubset::mesh_init);
+  }
+  for (auto pmb : blocks) pmb->real_container.SendBoundaryBuffers();
+  std::vector<Real> data;
+  for (auto pmb : blocks) {
+    pmb->real_container.ReceiveAndSetBoundariesWithWait();
+    pmb->real_container.SetBoundaries();
+    pmb->real_container.ClearBoundary(parthenon::BoundaryCommSubset::mesh_init);
+    pmb->pbval->ProlongateBoundaries(0.0, 0.0);
+    for (auto name : kVariables) {
+      auto &q = pmb->real_container.Get(name);
+      data.insert(data.end(), q.data(), q.data() + q.GetSize());
+    }
+  }
+  return data;
+}
+} // namespace
+
+TEST_CASE("Batched prolongation matches the per-neighbor loop", "[BoundaryValues]") {
+  GIVEN("A statically refined 2D mesh with three refined variables") {
+    parthenon::Globals::my_rank = 0;
+    parthenon::Globals::nranks = 1;
+    const std::vector<Real> loop = ProlongatedData(false);
+    const std::vector<Real> batched = ProlongatedData(true);
+
+    THEN("Both paths produce bitwise identical blocks, ghost zones included") {
+      REQUIRE(loop.size() == batched.size());
+      int differ = 0;
+      for (std::size_t n = 0; n < loop.size(); ++n) {
+        if (loop[n] != batched[n]) differ++;
+      }
+      REQUIRE(differ == 0);
+    }
+  }
+}
@@ -0,0 +1,82 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <globals.hpp>
+#include <utils/comm_stats.hpp>
+
+namespace CommStats = parthenon::CommStats;
+
+TEST_CASE("Level relations are seen from the receiver", "[CommStats]") {
+  REQUIRE(CommStats::RelationOf(2, 2) == CommStats::Relation::same_level);
+  REQUIRE(CommStats::RelationOf(1, 2) == CommStats::Relation::coarse_to_fine);
+  REQUIRE(CommStats::RelationOf(3, 2) == CommStats::Relation::fine_to_coarse);
+}
+
+TEST_CASE("Communication counters accumulate across threads", "[CommStats]") {
+  GIVEN("Messages sent from four threads") {
+    CommStats::enabled = true;
+    parthenon::Globals::nranks = 1;
+    std::vector<std::thread> threads;
+    for (int t=0; t<4; ++t) {
+      threads.emplace_back([]() {
+        for (int n=0; n<250; ++n)
+          CommStats::Send(CommStats::Channel::boundary,
+                          CommStats::Relation::fine_to_coarse, false, 1024);
+      });
+    }
+    for (auto &t : threads)
+      t.join();
+    CommStats::Wait(CommStats::Channel::flux_correction,
+                    CommStats::Relation::fine_to_coarse, true, 2000000000);
+    std::stringstream interval, again, total;
+    CommStats::Report(interval, false);
+    CommStats::Report(again, false);
+    CommStats::Report(total, true);
+    CommStats::enabled = false;
+
+    THEN("Every message is counted once, on its own line") {
+      const std::string text = interval.str();
+      const auto pos = text.find("\nboundary/fine_to_coarse/off_rank ");
+      REQUIRE(pos != std::string::npos);
+      std::stringstream line(text.substr(pos));
+      std::string name;
+      double messages, mib, kib;
+      line >> name >> messages >> mib >> kib;
+      REQUIRE(messages == 1000);
+      REQUIRE(kib == Approx(1.0));
+    }
+    AND_THEN("Waits are reported in seconds") {
+      const std::string text = interval.str();
+      const auto pos = text.find("\nflux_correction/fine_to_coarse/same_rank ");
+      REQUIRE(pos != std::string::npos);
+      std::stringstream line(text.substr(pos));
+      std::string name;
+      double messages, mib, kib, waits, seconds;
+      line >> name >> messages >> mib >> kib >> waits >> seconds;
+      REQUIRE(waits == 1);
+      REQUIRE(seconds == Approx(2.0));
+    }
+    AND_THEN("Interval reports only cover the traffic since the previous one") {
+      REQUIRE(again.str().find("\nboundary/") == std::string::npos);
+      REQUIRE(total.str().find("\nboundary/fine_to_coarse/off_rank ") != std::string::npos);
+    }
+  }
+}
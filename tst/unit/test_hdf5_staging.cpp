@@ -0,0 +1,143 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <defs.hpp>
+#include <globals.hpp>
+#include <interface/Metadata.hpp>
+#include <interface/StateDescriptor.hpp>
+#include <mesh/mesh.hpp>
+#include <outputs/outputs.hpp>
+#include <parameter_input.hpp>
+
+using parthenon::Mesh;
+using parthenon::Metadata;
+using parthenon::ParameterInput;
+
+#ifdef HDF5OUTPUT
+namespace {
+bool Exists(const std::string &name) {
+  struct stat st;
+  return stat(name.c_str(), &st) == 0;
+}
+
+// whether the file starts with the HDF5 signature, i.e. was moved or copied completely
+bool IsHDF5(const std::string &name) {
+  std::ifstream in(name, std::ios::binary);
+  char sig[8] = {};
+  in.read(sig, sizeof(sig));
+  return in && std::string(sig, sizeof(sig)) == "\211HDF\r\n\032\n";
+}
+} // namespace
+#endif
+
+TEST_CASE("Staged HDF5 outputs are drained to their final location", "[ATHDF5Output]") {
+#ifdef HDF5OUTPUT
+  parthenon::Globals::my_rank = 0;
+  parthenon::Globals::nranks = 1;
+  std::stringstream input;
+  input << "<mesh>" << std::endl
+        << "nx1 = 16" << std::endl << "x1min = -1.0" << std::endl
+        << "x1max = 1.0" << std::endl
+        << "ix1_bc = outflow" << std::endl << "ox1_bc = outflow" << std::endl
+        << "nx2 = 16" << std::endl << "x2min = -1.0" << std::endl
+        << "x2max = 1.0" << std::endl
+        << "ix2_bc = outflow" << std::endl << "ox2_bc = outflow" << std::endl
+        << "nx3 = 1" << std::endl << "x3min = -0.5" << std::endl
+        << "x3max = 0.5" << std::endl
+        << "<meshblock>" << std::endl
+        << "nx1 = 8" << std::endl << "nx2 = 8" << std::endl << "nx3 = 1" << std::endl
+        << "<time>" << std::endl << "tlim = 1.0" << std::endl;
+  ParameterInput pin;
+  pin.LoadFromStream(input);
+  auto pkg = std::make_shared<parthenon::StateDescriptor>("Test");
+  Metadata m({Metadata::Cell, Metadata::Graphics});
+  pkg->AddField("u", m);
+  parthenon::Packages_t packages;
+  packages["Test"] = pkg;
+  parthenon::Properties_t properties;
+  Mesh mesh(&pin, properties, packages);
+
+  // a stage directory next to the outputs is drained by rename, one in /dev/shm is
+  // usually on another file system and drained by copying
+  const std::string local_dir = "test_stage.local";
+  const std::string shm_dir = "/dev/shm/test_stage." + std::to_string(getpid());
+  for (const std::string &stage_dir : {local_dir, shm_dir}) {
+    GIVEN("Two outputs staged in " << stage_dir) {
+      if (!Exists(stage_dir)) mkdir(stage_dir.c_str(), 0755);
+      struct stat stage_st, cwd_st;
+      stat(stage_dir.c_str(), &stage_st);
+      stat(".", &cwd_st);
+      if (stage_dir == shm_dir && stage_st.st_dev == cwd_st.st_dev) {
+        WARN("/dev/shm is on the same file system, the copy path is not exercised");
+      }
+
+      parthenon::OutputParameters op;
+      op.block_name = "output1";
+      op.file_basename = "test_stage";
+      op.file_id = "out0";
+      op.dt = 1.0;
+      op.stage_dir = stage_dir;
+      const std::string first = "test_stage.out0.00000.athdf";
+      const std::string second = "test_stage.out0.00001.athdf";
+      const auto staged = [&stage_dir](const std::string &name) {
+        return stage_dir + "/" + name;
+      };
+
+      auto out = std::make_unique<parthenon::ATHDF5Output>(op);
+      out->WriteOutputFile(&mesh, &pin, false);
+      const bool first_xdmf_aside = Exists(first + ".xdmf.part") &&
+                                    !Exists(first + ".xdmf");
+      out->WriteOutputFile(&mesh, &pin, false);
+      const bool first_published = IsHDF5(first) && !Exists(staged(first)) &&
+                                   !Exists(first + ".part") && Exists(first + ".xdmf") &&
+                                   !Exists(first + ".xdmf.part");
+      const bool second_xdmf_aside = Exists(second + ".xdmf.part") &&
+                                     !Exists(second + ".xdmf");
+      out->FinishOutput();
+      const bool second_published = IsHDF5(second) && !Exists(staged(second)) &&
+                                    !Exists(second + ".part") &&
+                                    Exists(second + ".xdmf") &&
+                                    !Exists(second + ".xdmf.part");
+      out.reset();
+
+      for (const std::string &name : {first, second}) {
+        std::remove(name.c_str());
+        std::remove((name + ".xdmf").c_str());
+      }
+      rmdir(stage_dir.c_str());
+
+      THEN("Each XDMF is renamed into place only once its file has been drained") {
+        REQUIRE(first_xdmf_aside);
+        REQUIRE(first_published);
+        REQUIRE(second_xdmf_aside);
+        REQUIRE(second_published);
+      }
+    }
+  }
+#else
+  WARN("built without HDF5");
+#endif
+}
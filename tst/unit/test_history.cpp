@@ -0,0 +1,120 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <globals.hpp>
+#include <interface/Metadata.hpp>
+#include <interface/StateDescriptor.hpp>
+#include <mesh/mesh.hpp>
+#include <outputs/outputs.hpp>
+#include <parameter_input.hpp>
+
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::Metadata;
+using parthenon::ParameterInput;
+using parthenon::Real;
+using parthenon::UserHistoryOperation;
+
+TEST_CASE("History quantities are reduced over all blocks", "[HistoryOutput]") {
+  GIVEN("Four unit-volume blocks holding 1 + gid in every cell") {
+    parthenon::Globals::my_rank = 0;
+    parthenon::Globals::nranks = 1;
+    std::stringstream input;
+    input << "<mesh>" << std::endl
+          << "nx1 = 16" << std::endl << "x1min = -1.0" << std::endl
+          << "x1max = 1.0" << std::endl
+          << "ix1_bc = outflow" << std::endl << "ox1_bc = outflow" << std::endl
+          << "nx2 = 16" << std::endl << "x2min = -1.0" << std::endl
+          << "x2max = 1.0" << std::endl
+          << "ix2_bc = outflow" << std::endl << "ox2_bc = outflow" << std::endl
+          << "nx3 = 1" << std::endl << "x3min = -0.5" << std::endl
+          << "x3max = 0.5" << std::endl
+          << "<meshblock>" << std::endl
+          << "nx1 = 8" << std::endl << "nx2 = 8" << std::endl << "nx3 = 1" << std::endl
+          << "<time>" << std::endl << "tlim = 1.0" << std::endl;
+    ParameterInput pin;
+    pin.LoadFromStream(input);
+
+    auto pkg = std::make_shared<parthenon::StateDescriptor>("Test");
+    Metadata m({Metadata::Cell});
+    pkg->AddField("u", m);
+    pkg->AddHistory("total", "u");
+    pkg->AddHistory("peak", "u", UserHistoryOperation::max);
+    pkg->AddHistory("lowest", "u", UserHistoryOperation::min);
+    pkg->AddHistory("cells", "u", UserHistoryOperation::sum, false);
+    const bool duplicate_rejected = [&pkg]() {
+      try {
+        pkg->AddHistory("total", "u");
+      } catch (std::invalid_argument &) {
+        return true;
+      }
+      return false;
+    }();
+    parthenon::Packages_t packages;
+    packages["Test"] = pkg;
+    parthenon::Properties_t properties;
+    Mesh mesh(&pin, properties, packages);
+    for (MeshBlock *pmb = mesh.pblock; pmb != nullptr; pmb = pmb->next) {
+      auto &u = pmb->real_container.Get("u");
+      for (int n = 0; n < u.GetSize(); ++n) u(n) = 1.0 + pmb->gid;
+    }
+
+    parthenon::OutputParameters op;
+    op.block_name = "output1";
+    op.file_basename = "test_history";
+    op.data_format = " %.17e";
+    std::remove("test_history.hst");
+    parthenon::HistoryOutput hst(op);
+    hst.WriteOutputFile(&mesh, &pin, false);
+    hst.FinishOutput();
+
+    std::ifstream in("test_history.hst");
+    std::string line, header;
+    std::vector<Real> values;
+    while (std::getline(in, line)) {
+      if (line[0] == '#') {
+        header += line;
+        continue;
+      }
+      std::istringstream fields(line);
+      Real x;
+      while (fields >> x) values.push_back(x);
+    }
+    in.close();
+    std::remove("test_history.hst");
+
+    THEN("Sums are volume weighted unless requested otherwise, extrema are exact") {
+      REQUIRE(duplicate_rejected);
+      REQUIRE(header.find("[3]=total") != std::string::npos);
+      REQUIRE(header.find("[6]=cells") != std::string::npos);
+      // time, dt, then the columns in the order they were added
+      REQUIRE(values.size() == 6);
+      REQUIRE(values[2] == Approx(1.0 + 2.0 + 3.0 + 4.0));
+      REQUIRE(values[3] == 4.0);
+      REQUIRE(values[4] == 1.0);
+      REQUIRE(values[5] == 64.0*(1.0 + 2.0 + 3.0 + 4.0));
+    }
+  }
+}
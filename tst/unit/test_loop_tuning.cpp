@@ -0,0 +1,83 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <athena.hpp>
+#include <globals.hpp>
+#include <kokkos_abstraction.hpp>
+#include <parameter_input.hpp>
+#include <utils/loop_tuning.hpp>
+
+using parthenon::DevSpace;
+using parthenon::ParArray3D;
+namespace LoopTuning = parthenon::LoopTuning;
+
+TEST_CASE("par_for loop patterns are tuned, locked in and cached", "[LoopTuning]") {
+  GIVEN("Autotuning with one trial per pattern and a 3D kernel") {
+    parthenon::ParameterInput pin;
+    pin.SetBoolean("autotune", "loop_patterns", true);
+    pin.SetInteger("autotune", "trials", 1);
+    pin.SetString("autotune", "cache_file", "test_loop_tuning.cache");
+    parthenon::Globals::my_rank = 0;
+    LoopTuning::Initialize(&pin);
+
+    const int N = 16;
+    ParArray3D<double> arr("arr", N, N, N);
+    int wrong = 0;
+    // more calls than candidates, so the last ones run the chosen pattern
+    for (int call = 1; call <= 8; ++call) {
+      parthenon::par_for("TunedKernel", DevSpace(), 0, N - 1, 0, N - 1, 0, N - 1,
+          KOKKOS_LAMBDA(const int k, const int j, const int i) {
+            arr(k, j, i) = call*(i + N*(j + N*k));
+          });
+      auto host = Kokkos::create_mirror_view(arr);
+      Kokkos::deep_copy(host, arr);
+      for (int k = 0; k < N; ++k) {
+        for (int j = 0; j < N; ++j) {
+          for (int i = 0; i < N; ++i) {
+            if (host(k, j, i) != call*(i + N*(j + N*k))) wrong++;
+          }
+        }
+      }
+    }
+    const auto chosen = LoopTuning::Find("TunedKernel", {1, N, N, N}).Chosen();
+    LoopTuning::WriteCache();
+
+    // a new run reads the choice back without tuning
+    LoopTuning::Initialize(&pin);
+    const auto cached = LoopTuning::Find("TunedKernel", {1, N, N, N}).Chosen();
+    const auto other = LoopTuning::Find("TunedKernel", {1, N, N, 2*N}).Chosen();
+    std::ifstream cache("test_loop_tuning.cache");
+    const bool cache_written = cache.good();
+    cache.close();
+    std::remove("test_loop_tuning.cache");
+    pin.SetBoolean("autotune", "loop_patterns", false);
+    LoopTuning::Initialize(&pin);
+
+    THEN("Every pattern computes the same result and the choice is reused") {
+      REQUIRE(wrong == 0);
+      REQUIRE(chosen != LoopTuning::Pattern::undecided);
+      REQUIRE(cache_written);
+      REQUIRE(cached == chosen);
+      REQUIRE(other == LoopTuning::Pattern::undecided);
+      REQUIRE_FALSE(LoopTuning::enabled);
+    }
+  }
+}
@@ -0,0 +1,136 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <bvals/cc/bvals_cc.hpp>
+#include <globals.hpp>
+#include <interface/Metadata.hpp>
+#include <interface/StateDescriptor.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <utils/memory_usage.hpp>
+
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::Metadata;
+using parthenon::ParameterInput;
+using parthenon::Real;
+using parthenon::MemoryUsage::Category;
+using parthenon::MemoryUsage::Tally;
+
+TEST_CASE("Memory is tallied per package, variable and category", "[MemoryUsage]") {
+  GIVEN("Two blocks, the first with an extra variable and a copied stage") {
+    parthenon::Globals::my_rank = 0;
+    parthenon::Globals::nranks = 1;
+    std::stringstream input;
+    input << "<mesh>" << std::endl
+          << "nx1 = 16" << std::endl << "x1min = -1.0" << std::endl
+          << "x1max = 1.0" << std::endl
+          << "ix1_bc = outflow" << std::endl << "ox1_bc = outflow" << std::endl
+          << "nx2 = 8" << std::endl << "x2min = -0.5" << std::endl
+          << "x2max = 0.5" << std::endl
+          << "ix2_bc = outflow" << std::endl << "ox2_bc = outflow" << std::endl
+          << "nx3 = 1" << std::endl << "x3min = -0.5" << std::endl
+          << "x3max = 0.5" << std::endl
+          << "<meshblock>" << std::endl
+          << "nx1 = 8" << std::endl << "nx2 = 8" << std::endl << "nx3 = 1" << std::endl
+          << "<time>" << std::endl << "tlim = 1.0" << std::endl;
+    ParameterInput pin;
+    pin.LoadFromStream(input);
+
+    // "a" exchanges ghosts, so it owns fluxes and communication buffers
+    auto pkg_a = std::make_shared<parthenon::StateDescriptor>("A");
+    Metadata m_a({Metadata::Cell, Metadata::Independent, Metadata::FillGhost});
+    pkg_a->AddField("a", m_a);
+    Metadata m_c({Metadata::Cell, Metadata::OneCopy});
+    pkg_a->AddField("c", m_c);
+    auto pkg_b = std::make_shared<parthenon::StateDescriptor>("B");
+    Metadata m_b({Metadata::Cell});
+    pkg_b->AddField("b", m_b);
+    parthenon::Packages_t packages;
+    packages["A"] = pkg_a;
+    packages["B"] = pkg_b;
+    parthenon::Properties_t properties;
+    Mesh mesh(&pin, properties, packages);
+
+    MeshBlock *first = mesh.pblock;
+    REQUIRE(first != nullptr);
+    REQUIRE(first->next != nullptr);
+    REQUIRE(first->next->next == nullptr);
+    auto &rc = first->real_container;
+    Metadata m_extra({Metadata::Cell});
+    rc.Add("extra", m_extra);
+    // the copy gets its own cell data, but shares the fluxes and communication buffers
+    // of "a" and aliases the one-copy "c"
+    rc.StageAdd("copy", "base");
+
+    Tally tally(mesh.packages);
+    for (MeshBlock *pmb = mesh.pblock; pmb != nullptr; pmb = pmb->next)
+      tally.Add(pmb);
+
+    const std::size_t cell = first->ncells2*first->ncells1*sizeof(Real);
+    const std::size_t flux = (first->ncells2*(first->ncells1 + 1) +
+                              (first->ncells2 + 1)*first->ncells1)*sizeof(Real);
+    const std::size_t comm = rc.Get("a").vbvar->GetBufferSizeInBytes();
+    const auto row = [&tally](const std::string &name) {
+      for (int n = 0; n < tally.NumRows(); ++n) {
+        if (tally.Row(n) == name) return n;
+      }
+      return -1;
+    };
+
+    THEN("The rows follow the packages and end with the unregistered variables") {
+      REQUIRE(tally.NumRows() == 4);
+      REQUIRE(row("A/a") >= 0);
+      REQUIRE(row("A/c") >= 0);
+      REQUIRE(row("B/b") >= 0);
+      REQUIRE(tally.Row(tally.NumRows() - 1) == "(other)");
+    }
+
+    THEN("Arrays shared between stages are counted once per block") {
+      REQUIRE(comm > 0);
+      REQUIRE(tally.Bytes(row("A/a"), Category::cell) == 3*cell);
+      REQUIRE(tally.Bytes(row("A/a"), Category::flux) == 2*flux);
+      REQUIRE(tally.Bytes(row("A/a"), Category::comm) == 2*comm);
+      REQUIRE(tally.Bytes(row("A/c"), Category::cell) == 2*cell);
+      REQUIRE(tally.Bytes(row("B/b"), Category::cell) == 3*cell);
+      REQUIRE(tally.Bytes(row("(other)"), Category::cell) == 2*cell);
+    }
+
+    THEN("Only variables with ghost exchange own fluxes and buffers") {
+      for (const std::string &name : {"A/c", "B/b", "(other)"}) {
+        REQUIRE(tally.Bytes(row(name), Category::flux) == 0);
+        REQUIRE(tally.Bytes(row(name), Category::comm) == 0);
+      }
+      // a uniform mesh has no coarse buffers
+      REQUIRE(tally.Bytes(Category::coarse) == 0);
+    }
+
+    THEN("The totals are the sums of the rows and of the blocks") {
+      REQUIRE(tally.Bytes(Category::cell) == 10*cell);
+      REQUIRE(tally.Bytes(Category::flux) == 2*flux);
+      REQUIRE(tally.Bytes(Category::comm) == 2*comm);
+      REQUIRE(tally.Total() == 10*cell + 2*flux + 2*comm);
+      REQUIRE(tally.NumBlocks() == 2);
+      REQUIRE(tally.MaxBlock() == 7*cell + flux + comm);
+    }
+  }
+}
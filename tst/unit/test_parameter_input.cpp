@@ -0,0 +1,88 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <globals.hpp>
+#include <outputs/io_wrapper.hpp>
+#include <parameter_input.hpp>
+
+using parthenon::IOWrapper;
+using parthenon::ParameterInput;
+
+TEST_CASE("Input parameters are found by name and converted once", "[ParameterInput]") {
+  GIVEN("A header of many blocks followed by binary data, as in a restart file") {
+    const std::string fname = "test_parameter_input.rst";
+    {
+      std::ofstream out(fname, std::ios::binary);
+      for (int b = 0; b < 200; ++b) {
+        out << "<block" << b << ">" << std::endl
+            << "ival = " << b << "   # integer" << std::endl
+            << "rval = " << 0.5*b << std::endl
+            << "flag = " << ((b % 2 == 0) ? "true" : "False") << std::endl;
+      }
+      out << "<block0>" << std::endl << "ival = 42" << std::endl;
+      out << "<par_end>" << std::endl << "BINARY";
+    }
+    parthenon::Globals::my_rank = 0;
+    parthenon::Globals::nranks = 1;
+    ParameterInput pin;
+    IOWrapper infile;
+    infile.Open(fname.c_str(), IOWrapper::FileMode::read);
+    pin.LoadFromFile(infile);
+    char tail[7] = {};
+    infile.Read(tail, sizeof(char), 6);
+    infile.Close();
+    std::remove(fname.c_str());
+
+    THEN("Values are typed, the file is left at the end of the header") {
+      REQUIRE(std::string(tail) == "BINARY");
+      REQUIRE(pin.GetInteger("block0", "ival") == 42);
+      REQUIRE(pin.GetInteger("block199", "ival") == 199);
+      REQUIRE(pin.GetReal("block7", "rval") == 3.5);
+      REQUIRE(pin.GetBoolean("block8", "flag"));
+      REQUIRE(!pin.GetBoolean("block9", "flag"));
+      REQUIRE(pin.DoesBlockExist("block150"));
+      REQUIRE(!pin.DoesParameterExist("block150", "missing"));
+      REQUIRE(!pin.DoesBlockExist("block200"));
+    }
+
+    THEN("Cached conversions follow updates of the value") {
+      REQUIRE(pin.GetReal("block3", "rval") == 1.5);
+      pin.SetReal("block3", "rval", 2.25);
+      REQUIRE(pin.GetReal("block3", "rval") == 2.25);
+      REQUIRE(pin.GetOrAddInteger("block3", "ival", 0) == 3);
+      REQUIRE(pin.GetOrAddInteger("block3", "added", 5) == 5);
+      REQUIRE(pin.GetInteger("block3", "added") == 5);
+    }
+
+    THEN("The dump keeps blocks and parameters in input order") {
+      std::stringstream dump;
+      pin.ParameterDump(dump);
+      const std::string text = dump.str();
+      const auto b0 = text.find("<block0>");
+      const auto b1 = text.find("<block1>");
+      REQUIRE(b0 != std::string::npos);
+      REQUIRE(b0 < b1);
+      REQUIRE(text.find("ival") < text.find("rval"));
+      REQUIRE(text.find("<block0>", b0 + 1) == std::string::npos);
+    }
+  }
+}
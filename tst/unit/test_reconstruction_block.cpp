@@ -0,0 +1,167 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <athena.hpp>
+#include <athena_arrays.hpp>
+#include <defs.hpp>
+#include <globals.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <reconstruct/reconstruction.hpp>
+
+using parthenon::AthenaArray;
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::ParameterInput;
+using parthenon::Real;
+using parthenon::Reconstruction;
+
+namespace {
+constexpr int kNvar = 4;
+
+// a single 3D MeshBlock with spacing ratios rat, 1/rat and rat in x1, x2 and x3
+std::unique_ptr<Mesh> MakeMesh(ParameterInput *pin, const std::string &xorder,
+                               const Real rat) {
+  std::stringstream input;
+  input << "<mesh>" << std::endl << "xorder = " << xorder << std::endl;
+  const int nx[3] = {16, 12, 8};
+  for (int d = 1; d <= 3; ++d) {
+    input << "nx" << d << " = " << nx[d-1] << std::endl
+          << "x" << d << "min = -1.0" << std::endl << "x" << d << "max = 1.0" << std::endl
+          << "x" << d << "rat = " << (d == 2 ? 1.0/rat : rat) << std::endl
+          << "ix" << d << "_bc = outflow" << std::endl
+          << "ox" << d << "_bc = outflow" << std::endl;
+  }
+  input << "<meshblock>" << std::endl
+        << "nx1 = 16" << std::endl << "nx2 = 12" << std::endl << "nx3 = 8" << std::endl
+        << "<time>" << std::endl << "tlim = 1.0" << std::endl;
+  pin->LoadFromStream(input);
+  parthenon::Properties_t properties;
+  parthenon::Packages_t packages;
+  return std::make_unique<Mesh>(pin, properties, packages);
+}
+
+// reconstructs random data in direction dir with the block kernel and with the pencil
+// functions; returns the number of face states that differ by more than tol
+int CountMismatches(MeshBlock *pmb, const bool parabolic, const int dir,
+                    const Real tol) {
+  Reconstruction &recon = *pmb->precon;
+  const int nc1 = pmb->ncells1, nc2 = pmb->ncells2, nc3 = pmb->ncells3;
+  AthenaArray<Real> q(kNvar, nc3, nc2, nc1), ql(kNvar, nc3, nc2, nc1),
+      qr(kNvar, nc3, nc2, nc1), pl(kNvar, nc1), pr(kNvar, nc1);
+  std::mt19937 gen(12345 + dir);
+  std::uniform_real_distribution<Real> dist(-1.0, 1.0);
+  for (int n = 0; n < q.GetSize(); ++n) q(n) = dist(gen);
+
+  // the cells whose faces are reconstructed, one beyond the block in direction dir
+  int il = pmb->is, iu = pmb->ie, jl = pmb->js, ju = pmb->je, kl = pmb->ks, ku = pmb->ke;
+  if (dir == parthenon::X1DIR) il--, iu++;
+  if (dir == parthenon::X2DIR) jl--, ju++;
+  if (dir == parthenon::X3DIR) kl--, ku++;
+  if (parabolic) {
+    recon.PiecewiseParabolicBlock(dir, kl, ku, jl, ju, il, iu, q, ql, qr);
+  } else {
+    recon.PiecewiseLinearBlock(dir, kl, ku, jl, ju, il, iu, q, ql, qr);
+  }
+
+  // the data are of order one, so the tolerance is taken relative to one
+  auto differ = [tol](const Real a, const Real b) {
+    return std::abs(a - b) > tol*std::max(1.0, std::abs(a));
+  };
+  int mismatches = 0;
+  for (int k = kl; k <= ku; ++k) {
+    for (int j = jl; j <= ju; ++j) {
+      if (dir == parthenon::X1DIR) {
+        if (parabolic) recon.PiecewiseParabolicX1(k, j, il, iu, q, pl, pr);
+        else           recon.PiecewiseLinearX1(k, j, il, iu, q, pl, pr);
+      } else if (dir == parthenon::X2DIR) {
+        if (parabolic) recon.PiecewiseParabolicX2(k, j, il, iu, q, pl, pr);
+        else           recon.PiecewiseLinearX2(k, j, il, iu, q, pl, pr);
+      } else {
+        if (parabolic) recon.PiecewiseParabolicX3(k, j, il, iu, q, pl, pr);
+        else           recon.PiecewiseLinearX3(k, j, il, iu, q, pl, pr);
+      }
+      // the pencil functions store the state at face x+1/2 of cell x at x+1 in x1 only
+      const int dk = (dir == parthenon::X3DIR), dj = (dir == parthenon::X2DIR);
+      const int di = (dir == parthenon::X1DIR);
+      for (int n = 0; n < kNvar; ++n) {
+        for (int i = il; i <= iu; ++i) {
+          if (differ(pl(n,i+di), ql(n,k+dk,j+dj,i+di))) mismatches++;
+          if (differ(pr(n,i), qr(n,k,j,i))) mismatches++;
+        }
+      }
+    }
+  }
+  return mismatches;
+}
+} // namespace
+
+TEST_CASE("Block-wide PLM matches the pencil functions", "[Reconstruction]") {
+  parthenon::Globals::my_rank = 0;
+  parthenon::Globals::nranks = 1;
+  GIVEN("Random data on a uniform block") {
+    ParameterInput pin;
+    auto mesh = MakeMesh(&pin, "2", 1.0);
+    THEN("All face states are bitwise identical") {
+      for (int dir = parthenon::X1DIR; dir <= parthenon::X3DIR; ++dir) {
+        INFO("direction " << dir);
+        REQUIRE(CountMismatches(mesh->pblock, false, dir, 0.0) == 0);
+      }
+    }
+  }
+  GIVEN("Random data on a block with nonuniform spacing") {
+    ParameterInput pin;
+    auto mesh = MakeMesh(&pin, "2", 1.05);
+    THEN("Face states agree to rounding; only x1 may differ in the last bit") {
+      REQUIRE(CountMismatches(mesh->pblock, false, parthenon::X1DIR, 1.0e-14) == 0);
+      REQUIRE(CountMismatches(mesh->pblock, false, parthenon::X2DIR, 0.0) == 0);
+      REQUIRE(CountMismatches(mesh->pblock, false, parthenon::X3DIR, 0.0) == 0);
+    }
+  }
+}
+
+TEST_CASE("Block-wide PPM matches the pencil functions", "[Reconstruction]") {
+  parthenon::Globals::my_rank = 0;
+  parthenon::Globals::nranks = 1;
+#if NGHOST >= 3
+  for (const Real rat : {1.0, 1.05}) {
+    GIVEN("Random data on a block with spacing ratio " << rat) {
+      ParameterInput pin;
+      auto mesh = MakeMesh(&pin, "3", rat);
+      THEN("All face states are bitwise identical") {
+        for (int dir = parthenon::X1DIR; dir <= parthenon::X3DIR; ++dir) {
+          INFO("direction " << dir);
+          REQUIRE(CountMismatches(mesh->pblock, true, dir, 0.0) == 0);
+        }
+      }
+    }
+  }
+#else
+  // PPM needs three ghost zones, which the reconstruction refuses to run with otherwise
+  GIVEN("Fewer than three ghost zones") {
+    ParameterInput pin;
+    THEN("PPM is refused") { REQUIRE_THROWS(MakeMesh(&pin, "3", 1.0)); }
+  }
+#endif
+}
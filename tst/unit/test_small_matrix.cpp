@@ -0,0 +1,85 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cmath>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <athena_arrays.hpp>
+#include <reconstruct/small_matrix.hpp>
+
+using parthenon::AthenaArray;
+using parthenon::Real;
+
+TEST_CASE("Batched LU solve of small systems", "[SmallMatrix]") {
+  GIVEN("A batch of 5x5 systems that need row pivoting") {
+    constexpr int N = 5;
+    constexpr int ncells = 37;
+    AthenaArray<Real> a(N, N, ncells), lu(N, N, ncells);
+    AthenaArray<Real> x(N, ncells), b(N, ncells), y(N, ncells);
+    AthenaArray<int> pivot(N, ncells);
+    for (int i=0; i<ncells; ++i) {
+      for (int r=0; r<N; ++r) {
+        x(r,i) = 1.0 + r - 0.1*i;
+        for (int c=0; c<N; ++c) {
+          // small diagonal and a cell-dependent largest element force pivoting
+          a(r,c,i) = std::sin(1.0 + r + 3.0*c + 0.7*i) + (r == (c + i) % N ? 4.0 : 0.0);
+          lu(r,c,i) = a(r,c,i);
+        }
+      }
+    }
+    parthenon::BatchedMatVec<N>(0, ncells-1, a, x, b);
+
+    WHEN("The matrices are decomposed and the systems solved") {
+      int nsingular = parthenon::BatchedLUPDecompose<N>(0, ncells-1, lu, pivot);
+      parthenon::BatchedLUPSolve<N>(0, ncells-1, lu, pivot, b, y);
+      THEN("No pivot is singular and the solution is recovered") {
+        REQUIRE(nsingular == 0);
+        for (int i=0; i<ncells; ++i) {
+          for (int r=0; r<N; ++r) {
+            REQUIRE(y(r,i) == Approx(x(r,i)).epsilon(1e-12).margin(1e-12));
+          }
+        }
+      }
+    }
+
+    WHEN("The solution overwrites the right hand side") {
+      parthenon::BatchedLUPDecompose<N>(0, ncells-1, lu, pivot);
+      parthenon::BatchedLUPSolve<N>(0, ncells-1, lu, pivot, b, b);
+      THEN("The result is unchanged") {
+        for (int i=0; i<ncells; ++i) {
+          for (int r=0; r<N; ++r) {
+            REQUIRE(b(r,i) == Approx(x(r,i)).epsilon(1e-12).margin(1e-12));
+          }
+        }
+      }
+    }
+  }
+
+  GIVEN("A singular matrix in one cell of the batch") {
+    constexpr int N = 3;
+    AthenaArray<Real> a(N, N, 4);
+    AthenaArray<int> pivot(N, 4);
+    for (int i=0; i<4; ++i) {
+      for (int r=0; r<N; ++r) {
+        for (int c=0; c<N; ++c) a(r,c,i) = (r == c) ? 1.0 : 0.0;
+      }
+    }
+    for (int c=0; c<N; ++c) a(2,c,1) = a(0,c,1);
+    THEN("The decomposition reports a near-zero pivot") {
+      REQUIRE(parthenon::BatchedLUPDecompose<N>(0, 3, a, pivot) == 1);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <globals.hpp>
+#include <utils/timers.hpp>
+
+namespace Timers = parthenon::Timers;
+
+TEST_CASE("Timer regions nest and merge across threads", "[Timers]") {
+  GIVEN("Enabled timers and nested regions on two threads") {
+    Timers::enabled = true;
+    parthenon::Globals::nranks = 1;
+    std::vector<std::string> path;
+    {
+      Timers::ScopedRegion outer("outer");
+      for (int n=0; n<3; ++n) {
+        Timers::ScopedRegion inner("inner");
+      }
+      path = Timers::CurrentPath();
+      // a second thread re-opens the caller's path and times its work under it
+      std::thread worker([&path]() {
+        Timers::ScopedPath scoped(path);
+        Timers::ScopedRegion inner("inner");
+      });
+      worker.join();
+    }
+    std::stringstream report;
+    Timers::Report(report);
+    Timers::enabled = false;
+
+    THEN("Child regions are indented below their parent with merged call counts") {
+      REQUIRE(path == std::vector<std::string>{"outer"});
+      const std::string text = report.str();
+      const auto outer = text.find("\nouter ");
+      const auto inner = text.find("\n  inner ");
+      REQUIRE(outer != std::string::npos);
+      REQUIRE(inner != std::string::npos);
+      REQUIRE(outer < inner);
+      std::stringstream line(text.substr(inner));
+      std::string name;
+      double calls;
+      line >> name >> calls;
+      REQUIRE(calls == 4);
+    }
+  }
+}
@@ -0,0 +1,74 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <globals.hpp>
+#include <parameter_input.hpp>
+#include <task_list/tasks.hpp>
+#include <utils/trace.hpp>
+
+using parthenon::SimpleTask;
+using parthenon::TaskID;
+using parthenon::TaskList;
+using parthenon::TaskStatus;
+namespace Trace = parthenon::Trace;
+
+TEST_CASE("Task traces record every execution in Chrome trace format", "[Trace]") {
+  GIVEN("Tracing into a two event buffer and a list with a polling task") {
+    parthenon::ParameterInput pin;
+    pin.SetBoolean("profiling", "trace", true);
+    pin.SetInteger("profiling", "trace_events", 2);
+    pin.SetString("profiling", "trace_file", "test_trace");
+    parthenon::Globals::my_rank = 0;
+    parthenon::Globals::nranks = 1;
+    Trace::Initialize(&pin);
+
+    int polls = 0;
+    TaskList tl;
+    tl.SetBlockID(7);
+    tl.AddNamedTask<SimpleTask>("Poll", [&polls]() {
+      return (++polls < 3) ? TaskStatus::next : TaskStatus::success;
+    }, TaskID(0));
+    while (tl.DoAvailable() != parthenon::TaskListStatus::complete) {}
+    Trace::Write();
+    parthenon::ParameterInput defaults;
+    Trace::Initialize(&defaults);
+
+    std::ifstream in("test_trace.0.json");
+    std::stringstream buf;
+    buf << in.rdbuf();
+    const std::string text = buf.str();
+    in.close();
+    std::remove("test_trace.0.json");
+
+    THEN("The newest events are kept, labeled with block, task and completion") {
+      REQUIRE(polls == 3);
+      REQUIRE(text.find("\"traceEvents\"") != std::string::npos);
+      REQUIRE(text.find("\"name\":\"Poll\"") != std::string::npos);
+      REQUIRE(text.find("\"gid\":7,\"task\":1,\"stage\":-1,\"complete\":false")
+              != std::string::npos);
+      REQUIRE(text.find("\"gid\":7,\"task\":1,\"stage\":-1,\"complete\":true")
+              != std::string::npos);
+      REQUIRE(text.find("\"overwritten\":1") != std::string::npos);
+      REQUIRE_FALSE(Trace::enabled);
+    }
+  }
+}
@@ -0,0 +1,78 @@
+//========================================================================================
+// (C) (or copyright) 2020. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cmath>
+#include <vector>
+
+// Third Party Includes
+#include <catch2/catch.hpp>
+
+// Parthenon includes
+#include <reconstruct/reconstruction.hpp>
+
+using parthenon::Real;
+using parthenon::Reconstruction;
+
+namespace {
+constexpr Real kTwoPi = 6.283185307179586476925286766559;
+
+// max error of the left-biased face values of the exact cell averages of sin(2 pi x)
+// on a periodic grid of n cells
+Real WenoZFaceError(const int n) {
+  const Real dx = 1.0/n;
+  std::vector<Real> qbar(n);
+  for (int i = 0; i < n; ++i) {
+    qbar[i] = (std::cos(kTwoPi*i*dx) - std::cos(kTwoPi*(i + 1)*dx))/(kTwoPi*dx);
+  }
+  auto q = [&](const int i) { return qbar[(i + n) % n]; };
+  Real err = 0.0;
+  for (int i = 0; i < n; ++i) {
+    const Real face = Reconstruction::WenoZ5(q(i-2), q(i-1), q(i), q(i+1), q(i+2));
+    err = std::max(err, std::abs(face - std::sin(kTwoPi*(i + 1)*dx)));
+  }
+  return err;
+}
+} // namespace
+
+TEST_CASE("WENO5-Z converges at fifth order", "[Reconstruction][WENOZ]") {
+  GIVEN("Cell averages of a smooth periodic profile") {
+    std::vector<Real> err;
+    for (int n = 16; n <= 256; n *= 2) err.push_back(WenoZFaceError(n));
+    THEN("Doubling the resolution reduces the face error by about 2^5") {
+      for (std::size_t m = 1; m < err.size(); ++m) {
+        const Real order = std::log2(err[m-1]/err[m]);
+        INFO("refinement " << m << " observed order " << order);
+        REQUIRE(order > 4.5);
+      }
+    }
+  }
+}
+
+TEST_CASE("WENO5-Z is exact for constants and bounded at a step",
+          "[Reconstruction][WENOZ]") {
+  GIVEN("A constant stencil") {
+    THEN("The face value equals the constant") {
+      REQUIRE(Reconstruction::WenoZ5(3.0, 3.0, 3.0, 3.0, 3.0) == Approx(3.0));
+    }
+  }
+  GIVEN("Stencils straddling a unit step") {
+    const Real s[8] = {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0};
+    THEN("Face values stay within the step up to a small overshoot") {
+      for (int i = 2; i < 6; ++i) {
+        const Real face = Reconstruction::WenoZ5(s[i-2], s[i-1], s[i], s[i+1], s[i+2]);
+        REQUIRE(face > -0.05);
+        REQUIRE(face < 1.05);
+      }
+    }
+  }
+}